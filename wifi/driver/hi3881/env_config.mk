@@ -55,6 +55,7 @@ CFG_STA_PM = y
 CFG_MESH = n
 CFG_TCP_OPT = n
 CFG_TX_CLASSIFY_LAN_TO_WLAN = n
+CFG_M2U = n
 CFG_UAPSD = y
 CFG_ARP_OFFLOAD = y
 CFG_DHCP_OFFLOAD = y
@@ -149,6 +150,9 @@ HI1131_WIFI_CFLAGS +=-D_PRE_WLAN_FEATURE_FLOWCTRL
 ifeq ($(CFG_TX_CLASSIFY_LAN_TO_WLAN), y)
 HI1131_WIFI_CFLAGS +=-D_PRE_WLAN_FEATURE_TX_CLASSIFY_LAN_TO_WLAN
 endif
+ifeq ($(CFG_M2U), y)
+HI1131_WIFI_CFLAGS +=-D_PRE_WLAN_FEATURE_M2U
+endif
 HI1131_WIFI_CFLAGS +=-D_PRE_WLAN_FEATURE_CLASSIFY
 HI1131_WIFI_CFLAGS +=-D_PRE_WLAN_FEATURE_ALWAYS_TX
 HI1131_WIFI_CFLAGS +=-D_PRE_WLAN_FEATURE_WPA
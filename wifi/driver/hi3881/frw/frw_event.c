@@ -47,8 +47,20 @@ typedef struct _frw_event_mgmt_stru_ {
     frw_event_queue_stru       *event_queue;    /* 事件队列 */
     frw_event_sched_queue_stru sched_queue[FRW_SCHED_POLICY_BUTT];       /* 可调度队列 */
     hi_atomic                  total_element_cnt;
+    oal_spin_lock_stru         exec_lock;       /* 保护exec_owner */
+    volatile hi_u8             exec_owner;      /* 当前事件执行权归属，取值见frw_event_exec_owner_enum */
+    hi_u8                      auc_resv[3];     /* 3 byte保留字段 */
 } frw_event_mgmt_stru;
 
+/* 事件执行权: frw任务与直接分发路径互斥执行事件处理函数，避免二者交织导致hmac重入和事件乱序 */
+typedef enum {
+    FRW_EVENT_EXEC_IDLE   = 0,
+    FRW_EVENT_EXEC_FRW    = 1,   /* frw任务正在处理队列中的事件 */
+    FRW_EVENT_EXEC_DIRECT = 2,   /* 调用者线程正在直接处理事件，见frw_event_direct_dispatch */
+    FRW_EVENT_EXEC_DRAIN  = 3,   /* 调用者线程正在清空事件队列，见frw_event_drain_all_event */
+} frw_event_exec_owner_enum;
+typedef hi_u8 frw_event_exec_owner_enum_uint8;
+
 /* *****************************************************************************
     事件管理实体
 ****************************************************************************** */
@@ -285,6 +297,8 @@ hi_u32 frw_event_init(hi_void)
         oam_warning_log1(0, OAM_SF_FRW, "frw_event_init, frw_event_init_sched != HI_SUCCESS!%d", ret);
         return ret;
     }
+    oal_spin_lock_init(&g_ast_event_manager.exec_lock);
+    g_ast_event_manager.exec_owner = FRW_EVENT_EXEC_IDLE;
     frw_task_event_handler_register(frw_event_process_all_event);
 
     return HI_SUCCESS;
@@ -536,14 +550,83 @@ hi_u8 frw_is_vap_event_queue_empty(hi_u8 vap_id, hi_u8 event_type)
 **************************************************************************** */
 hi_u8 frw_task_thread_condition_check(hi_void)
 {
-    return (hi_atomic_read(&g_ast_event_manager.total_element_cnt) != 0);
+    /* 其他线程持有执行权期间frw任务保持睡眠，由其释放执行权时重新唤醒 */
+    return ((hi_atomic_read(&g_ast_event_manager.total_element_cnt) != 0) &&
+        (g_ast_event_manager.exec_owner == FRW_EVENT_EXEC_IDLE));
+}
+
+/* ****************************************************************************
+ 功能描述  : 获取事件执行权。直接分发路径只在执行权空闲且所有事件队列为空时才能获取，
+             保证此前投递的事件都已处理完毕，不会与frw任务交织或乱序
+ 返 回 值  : HI_TRUE获取成功，HI_FALSE执行权被占用
+**************************************************************************** */
+static hi_u8 frw_event_exec_claim(frw_event_exec_owner_enum_uint8 owner)
+{
+    unsigned long irq_flag;
+    hi_u8 claimed = HI_FALSE;
+
+    oal_spin_lock_irq_save(&g_ast_event_manager.exec_lock, &irq_flag);
+    if ((g_ast_event_manager.exec_owner == FRW_EVENT_EXEC_IDLE) && ((owner != FRW_EVENT_EXEC_DIRECT) ||
+        (hi_atomic_read(&g_ast_event_manager.total_element_cnt) == 0))) {
+        g_ast_event_manager.exec_owner = owner;
+        claimed = HI_TRUE;
+    }
+    oal_spin_unlock_irq_restore(&g_ast_event_manager.exec_lock, &irq_flag);
+
+    return claimed;
 }
 
 /* ****************************************************************************
- 功能描述  : 处理事件队列中的所有事件
+ 功能描述  : 释放事件执行权
+ 返 回 值  : 释放时是否有待处理的事件
+**************************************************************************** */
+static hi_u8 frw_event_exec_release(hi_void)
+{
+    unsigned long irq_flag;
+    hi_u8 pending;
+
+    oal_spin_lock_irq_save(&g_ast_event_manager.exec_lock, &irq_flag);
+    g_ast_event_manager.exec_owner = FRW_EVENT_EXEC_IDLE;
+    pending = (hi_atomic_read(&g_ast_event_manager.total_element_cnt) != 0) ? HI_TRUE : HI_FALSE;
+    oal_spin_unlock_irq_restore(&g_ast_event_manager.exec_lock, &irq_flag);
+
+    return pending;
+}
+
+/* ****************************************************************************
+ 功能描述  : 在调用者上下文直接处理事件，省去入队和frw任务切换。
+             frw任务正在处理或有事件排队时不等待，直接返回失败，由调用者改为投递
+ 输入参数  : event_mem: 事件内存，成功与否均由调用者释放
+ 返 回 值  : HI_SUCCESS事件已处理，HI_FAIL未处理需调用者投递
+**************************************************************************** */
+hi_u32 frw_event_direct_dispatch(frw_event_mem_stru *event_mem)
+{
+    frw_event_hdr_stru *event_hrd = HI_NULL;
+    hi_u32 ret;
+
+    if (frw_event_exec_claim(FRW_EVENT_EXEC_DIRECT) != HI_TRUE) {
+        return HI_FAIL;
+    }
+
+    event_hrd = (frw_event_hdr_stru *)event_mem->puc_data;
+    ret = frw_event_lookup_process_entry(event_mem, event_hrd);
+    if (ret != HI_SUCCESS) {
+        oam_warning_log1(0, OAM_SF_FRW, "{frw_event_direct_dispatch::process entry return [%d]}", ret);
+    }
+
+    /* 处理期间其他上下文投递的事件由frw任务接着处理 */
+    if (frw_event_exec_release() == HI_TRUE) {
+        frw_task_sched();
+    }
+
+    return HI_SUCCESS;
+}
+
+/* ****************************************************************************
+ 功能描述  : 依次处理事件队列中的所有事件，调用者需已持有事件执行权
  patch修改 : FRW处理事件时先cnt递减
 **************************************************************************** */
-hi_void frw_event_process_all_event(hi_void)
+static hi_void frw_event_process_queue(hi_void)
 {
     frw_event_mem_stru            *event_mem = HI_NULL;
     frw_event_sched_queue_stru    *sched_queue = HI_NULL;
@@ -570,6 +653,37 @@ hi_void frw_event_process_all_event(hi_void)
     }
 }
 
+/* ****************************************************************************
+ 功能描述  : frw任务处理事件队列中的所有事件
+**************************************************************************** */
+hi_void frw_event_process_all_event(hi_void)
+{
+    /* 其他线程正在执行，其释放执行权时会重新调度frw任务 */
+    if (frw_event_exec_claim(FRW_EVENT_EXEC_FRW) != HI_TRUE) {
+        return;
+    }
+
+    frw_event_process_queue();
+    /* 此后新投递的事件会使frw任务的唤醒条件再次成立，无需在此重新调度 */
+    (hi_void)frw_event_exec_release();
+}
+
+/* ****************************************************************************
+ 功能描述  : 在调用者上下文清空事件队列，执行权被frw任务或直接分发路径占用时等待其释放，
+             保证返回前已投递的事件均已处理。不可在frw任务上下文调用
+**************************************************************************** */
+hi_void frw_event_drain_all_event(hi_void)
+{
+    while (frw_event_exec_claim(FRW_EVENT_EXEC_DRAIN) != HI_TRUE) {
+        oal_msleep(1);
+    }
+
+    frw_event_process_queue();
+    if (frw_event_exec_release() == HI_TRUE) {
+        frw_task_sched();
+    }
+}
+
 /* ****************************************************************************
  功能描述  : 事件内存出队
  输入参数  : pst_event_queue: 事件队列
@@ -258,10 +258,12 @@ frw_event_mem_stru *frw_event_alloc(hi_u16 us_payload_length);
 hi_u32 frw_event_free(frw_event_mem_stru *event_mem);
 hi_u32 frw_event_dispatch_event(frw_event_mem_stru *event_mem);
 hi_u32 frw_event_post_event(frw_event_mem_stru *event_mem);
+hi_u32 frw_event_direct_dispatch(frw_event_mem_stru *event_mem);
 hi_void frw_event_table_register(frw_event_type_enum_uint8 type, frw_event_pipeline_enum_uint8 pipeline,
     const frw_event_sub_table_item_stru *sub_table);
 hi_u32 frw_event_flush_event_queue(frw_event_type_enum_uint8 event_type);
 hi_void frw_event_process_all_event(hi_void);
+hi_void frw_event_drain_all_event(hi_void);
 hi_u8 frw_is_vap_event_queue_empty(hi_u8 vap_id, hi_u8 event_type);
 const frw_event_sub_table_item_stru *frw_get_event_sub_table(hi_u8 type, hi_u8 pipeline);
 hi_u8 frw_task_thread_condition_check(hi_void);
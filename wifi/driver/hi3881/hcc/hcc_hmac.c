@@ -26,6 +26,7 @@
 #include "hmac_tx_data.h"
 #include "oam_ext_if.h"
 #include "oal_util.h"
+#include "net_adpater.h"
 #ifndef _PRE_FEATURE_HCC_TASK
 #include "flow_control.h"
 #endif
@@ -185,6 +186,10 @@ hi_u32 hcc_host_tx(hcc_handler_stru *hcc_handler, oal_netbuf_stru *netbuf, const
     hi_u32 err_code;
     hcc_tx_cb_stru *hcc_cb = HI_NULL;
     hi_u8 is_vipframe = HI_FALSE;
+    /* netbuf入队后可能随时被发送释放，统计所需字段在入队前取出; 非数据帧以非法vap_id跳过统计 */
+    hi_u8 stats_vap_id = WLAN_VAP_NUM_PER_BOARD;
+    hi_u8 stats_ac = WLAN_WME_AC_BE;
+    hi_u32 stats_len = oal_netbuf_len(netbuf) - param->extend_len;
 #ifdef _PRE_FEATURE_HCC_TASK
     hcc_trans_queue_stru *hcc_queue = HI_NULL;
     hcc_queue = &hcc_handler->hcc_transer_info.hcc_queues[HCC_TX].queues[param->queue_id];
@@ -207,10 +212,15 @@ hi_u32 hcc_host_tx(hcc_handler_stru *hcc_handler, oal_netbuf_stru *netbuf, const
         dmac_tx_ctl_stru *dmac_tx_ctrl = HI_NULL;
         hi_u8 *hcc_hdr = (hi_u8 *)oal_netbuf_data(netbuf);
         dmac_tx_ctrl = (dmac_tx_ctl_stru *)(hcc_hdr + HCC_HDR_LEN + sizeof(frw_hcc_extend_hdr_stru));
+        if (dmac_tx_ctrl != HI_NULL) {
+            stats_vap_id = dmac_tx_ctrl->tx_vap_index;
+            stats_ac = dmac_tx_ctrl->ac;
+        }
         if (dmac_tx_ctrl != HI_NULL &&
             dmac_tx_ctrl->is_vipframe != HI_TRUE && dmac_tx_ctrl->high_prio_sch != HI_TRUE &&
-            hcc_list_overflow()) {
-            /* 非关键帧 */
+            hcc_list_overflow(dmac_tx_ctrl->ac)) {
+            /* 非关键帧，按所属AC的水线反压 */
+            wal_netdev_stats_tx_drop(stats_vap_id, WAL_NETDEV_DROP_HCC_OVERFLOW);
             oal_netbuf_free(netbuf);
             return HI_SUCCESS;
         }
@@ -221,10 +231,12 @@ hi_u32 hcc_host_tx(hcc_handler_stru *hcc_handler, oal_netbuf_stru *netbuf, const
         }
 
         if (is_vipframe && hcc_discard_key_frame()) {
+            wal_netdev_stats_tx_drop(stats_vap_id, WAL_NETDEV_DROP_HCC_OVERFLOW);
             oal_netbuf_free(netbuf);
             return HI_SUCCESS;
         }
     }
+    wal_netdev_stats_tx(stats_vap_id, stats_ac, stats_len);
 
 #ifdef _PRE_FEATURE_HCC_TASK
     if (is_vipframe) {
@@ -25,6 +25,7 @@
 #include "oam_ext_if.h"
 #include "hmac_ext_if.h"
 #include "wal_main.h"
+#include "net_adpater.h"
 #ifdef CONFIG_MMC
 #include "plat_pm_wlan.h"
 #endif
@@ -41,6 +42,7 @@ extern "C" {
   全局变量定义
 **************************************************************************** */
 hi_u32 g_hcc_rx_thread_enable = 1;
+hi_u32 g_hcc_rx_fast_path_enable = 1;   /* 已建立连接的RX数据帧在hcc线程直接交hmac处理，绕过frw事件队列 */
 hi_u32 g_hcc_assemble_count = 8;
 hi_u32 g_hcc_credit_bottom_value = 2;
 hi_u32 g_ul_tcp_ack_wait_sche_cnt = 1;
@@ -78,9 +80,18 @@ static hi_u8 g_device_is_ready = HI_FALSE;
 #endif
 #define LOW_PRIORITY_COUNT                  1000
 #define KEY_FRAME_COUNT                     2000
+/* 低优先级队列按AC反压的恢复水线为停止水线的一半，避免在门限附近反复启停 */
+#define hcc_ac_wake_waterline(stop)         ((stop) >> 1)
 
 static hi_u8 g_abandon_key_frame = HI_FALSE;
-static hi_u8 g_list_overflow_flag = HI_FALSE;
+static hi_u8 g_list_overflow_bmap = 0;   /* bit(ac)置位表示该AC的非关键帧需要丢弃 */
+/* 各AC在DATA_LO_QUEUE上的停止水线(由队列深度推导)，高优先级AC可使用更深的队列，BE打满不会阻塞VO */
+static const hi_u16 g_aus_hcc_ac_stop_waterline[WLAN_WME_AC_BUTT] = {
+    LOW_PRIORITY_COUNT >> 1,                                /* BE */
+    LOW_PRIORITY_COUNT >> 2,                                /* BK */
+    (LOW_PRIORITY_COUNT >> 1) + (LOW_PRIORITY_COUNT >> 2),  /* VI */
+    LOW_PRIORITY_COUNT                                      /* VO */
+};
 static hi_u32 g_lo_buf_times = 0;
 
 #define WLAN_HEART_BEAT_ENABLE_WAIT_TIMEOUT 200 /* 等待device回复心跳使能/禁用命令的超时时间：200 ms */
@@ -349,8 +360,11 @@ hi_s32 hcc_host_proc_rx_queue_impl(oal_netbuf_head_stru *head, void *handler, in
         }
         hcc_hdr = (hcc_header_stru *)oal_netbuf_data(netbuf);
         if (hcc_host_check_header_vaild(hcc_hdr) != HI_TRUE) {
-            oal_print_hex_dump((hi_u8 *)hcc_hdr, HCC_HDR_TOTAL_LEN, 16, "invalid hcc header: "); /* 16进制 */
-            oam_error_log0(0, 0, "hcc_host_send_rx_queue:: invalid hcc_header");
+            /* 非法头必须丢弃, 限速只作用于打印 */
+            if (oam_log_site_allowed() == HI_TRUE) {
+                oal_print_hex_dump((hi_u8 *)hcc_hdr, HCC_HDR_TOTAL_LEN, 16, "invalid hcc header: "); /* 16进制 */
+                oam_error_log0(0, 0, "hcc_host_send_rx_queue:: invalid hcc_header");
+            }
             count++;
             oal_netbuf_free(netbuf);
             return count;
@@ -823,9 +837,31 @@ hi_void hcc_tx_sleep(hi_void)
     }
 }
 
-hi_u8 hcc_list_overflow(hi_void)
+/* ****************************************************************************
+ 功能描述  : 查询某个AC的低优先级队列是否处于反压状态
+**************************************************************************** */
+hi_u8 hcc_list_overflow(hi_u8 ac)
 {
-    return g_list_overflow_flag;
+    if (ac >= WLAN_WME_AC_BUTT) {
+        ac = WLAN_WME_AC_BE;
+    }
+    return (g_list_overflow_bmap & bit(ac)) ? HI_TRUE : HI_FALSE;
+}
+
+/* ****************************************************************************
+ 功能描述  : 根据DATA_LO_QUEUE深度刷新各AC的反压状态，超过停止水线置位，降到恢复水线以下清除
+**************************************************************************** */
+static hi_void hcc_update_list_overflow(hi_u32 queue_len)
+{
+    hi_u8 ac;
+
+    for (ac = 0; ac < WLAN_WME_AC_BUTT; ac++) {
+        if (queue_len > g_aus_hcc_ac_stop_waterline[ac]) {
+            g_list_overflow_bmap |= (hi_u8)bit(ac);
+        } else if (queue_len <= hcc_ac_wake_waterline(g_aus_hcc_ac_stop_waterline[ac])) {
+            g_list_overflow_bmap &= (hi_u8)~bit(ac);
+        }
+    }
 }
 
 hi_void hcc_clear_tx_queues(hcc_handler_stru *hcc)
@@ -929,11 +965,8 @@ hi_s32 hcc_host_proc_tx_queue_impl(oal_netbuf_head_stru *buffQueue, void *handle
     g_des_cnt = hcc_handler->hcc_transer_info.tx_flow_ctrl.des_cnt;
 
     if (type == DATA_LO_QUEUE) {
-        if (remain_len > LOW_PRIORITY_COUNT) {
-            g_list_overflow_flag = HI_TRUE;
-        } else {
-            g_list_overflow_flag = HI_FALSE;
-        }
+        hcc_update_list_overflow(remain_len);
+        wal_netdev_stats_queue_update(remain_len);
 
         if (remain_len > KEY_FRAME_COUNT) {
             g_abandon_key_frame = HI_TRUE;
@@ -1114,7 +1147,7 @@ static hi_void hcc_rx_netbuf_list_handler(hcc_handler_stru *hcc_handler, oal_net
             break;
         }
         hcc_hdr = (hcc_header_stru *)oal_netbuf_data(netbuf);
-        if (hcc_host_check_header_vaild(hcc_hdr) != HI_TRUE) {
+        if ((hcc_host_check_header_vaild(hcc_hdr) != HI_TRUE) && (oam_log_site_allowed() == HI_TRUE)) {
             oal_print_hex_dump((hi_u8 *)hcc_hdr, HCC_HDR_TOTAL_LEN, 16, "invalid hcc header: "); /* group size 16 */
         }
 
@@ -1371,6 +1404,28 @@ hi_s32 hcc_hmac_rx_extend_hdr_vaild_check(const frw_hcc_extend_hdr_stru *hcc_ext
     return HI_TRUE;
 }
 
+/* ****************************************************************************
+ 功能描述  : 判断RX事件能否走快速路径: 仅限UP状态且已有关联用户的VAP上的数据帧，
+             管理帧及连接建立过程中的帧仍经frw事件队列串行处理
+**************************************************************************** */
+static hi_u8 hcc_hmac_rx_fast_path_allowed(const hmac_vap_stru *hmac_vap, const frw_hcc_extend_hdr_stru *hcc_ext_hdr)
+{
+    mac_vap_stru *mac_vap = hmac_vap->base_vap;
+
+    if ((g_hcc_rx_fast_path_enable == 0) || (hcc_ext_hdr->nest_type != FRW_EVENT_TYPE_WLAN_DRX) ||
+        ((hcc_ext_hdr->nest_sub_type != DMAC_WLAN_DRX_EVENT_SUB_TYPE_RX_STA) &&
+        (hcc_ext_hdr->nest_sub_type != DMAC_WLAN_DRX_EVENT_SUB_TYPE_RX_AP))) {
+        return HI_FALSE;
+    }
+
+    /* STA在UP状态即已与AP关联，AP需要至少有一个关联用户，具体帧的用户合法性仍由hmac接收流程检查 */
+    if ((mac_vap == HI_NULL) || (mac_vap->vap_state != MAC_VAP_STATE_UP) || (mac_vap->user_nums == 0)) {
+        return HI_FALSE;
+    }
+
+    return HI_TRUE;
+}
+
 hi_s32 hcc_hmac_rx_wifi_post_func(hi_u8 hcc_subtype, const hcc_netbuf_stru *hcc_netbuf, hi_u8 *context)
 {
     hi_unref_param(hcc_subtype);
@@ -1412,6 +1467,14 @@ hi_s32 hcc_hmac_rx_wifi_post_func(hi_u8 hcc_subtype, const hcc_netbuf_stru *hcc_
     event_payload->netbuf = hcc_netbuf->pst_netbuf;
     event_payload->buf_len = oal_netbuf_len(hcc_netbuf->pst_netbuf);
 
+    /* frw空闲且无排队事件时直接在本线程处理，执行权与frw任务互斥，不会中断frw任务的执行;
+       任何竞争都会使直接分发失败，退回到事件投递 */
+    if ((hcc_hmac_rx_fast_path_allowed(hmac_vap, hcc_ext_hdr) == HI_TRUE) &&
+        (frw_event_direct_dispatch(event_mem) == HI_SUCCESS)) {
+        frw_event_free(event_mem);
+        return HI_SUCCESS;
+    }
+
     frw_event_task_lock();
     /* 更改HCC发送RX事件由函数直接调用为event事件抛送，防止HCC中断frw任务的执行造成异常 */
     err_code = (hi_s32)frw_event_post_event(event_mem);
@@ -1739,7 +1802,7 @@ hi_u32 hcc_host_init(struct BusDev *bus)
     hi_u32 err_code;
 #endif
     hcc_handler_stru *hcc_handler = HI_NULL;
-    g_list_overflow_flag = HI_FALSE;
+    g_list_overflow_bmap = 0;
     g_abandon_key_frame = HI_FALSE;
     g_hcc_host_handler = HI_NULL;
     hcc_handler = (hcc_handler_stru *)oal_memalloc(sizeof(hcc_handler_stru));
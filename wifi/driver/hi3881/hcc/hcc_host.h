@@ -401,6 +401,8 @@ hi_void hcc_host_tx_queue_sched(hi_void);
 hi_s32 queues_flow_ctrl_check(hcc_handler_stru *hcc_handler, hcc_chan_type dir);
 hi_s32 queues_len_check(hcc_handler_stru *hcc_handler, hcc_chan_type dir);
 hi_void hcc_sched_transfer(hcc_handler_stru *hcc_handler);
+hi_void hcc_rx_sched_transfer(hcc_handler_stru *hcc_handler);
+hi_void hcc_tx_network_startall_queues(const hcc_handler_stru *hcc_handler);
 hi_void hcc_print_device_mem_info(hi_void);
 hi_void hi_wifi_device_deinit(const hcc_handler_stru *hcc_handler);
 hi_void hcc_exit_task_thread(hcc_handler_stru *hcc);
@@ -408,7 +410,7 @@ hi_u8 hcc_get_thread_exit_flag(hi_void);
 hi_s32 hcc_host_proc_tx_queue(hcc_handler_stru *hcc_handler, hcc_queue_type_enum type);
 hi_s32 hcc_host_proc_rx_queue(hcc_handler_stru *hcc_handler, hcc_queue_type_enum type);
 hi_void hcc_clear_all_queues(hcc_handler_stru *hcc_handler, hi_s32 is_need_lock);
-hi_u8 hcc_list_overflow(hi_void);
+hi_u8 hcc_list_overflow(hi_u8 ac);
 hi_u32 hcc_host_tx(hcc_handler_stru *hcc_handler, oal_netbuf_stru *netbuf, const hcc_transfer_param *param);
 hi_u32 hcc_send_control_msg(hcc_handler_stru *hcc_handler, hi_u8 sub_type, hi_u8 *buf, int len);
 hi_s32 hi_wifi_enable_heart_beat(hi_bool enable);
@@ -68,6 +68,49 @@ hi_u8 g_efuseMacExist = false;
 hi_u8 g_wait_mac_set = 1;
 #define netif_is_not_ready() (NETIF_FLOW_CTRL_ON == g_netif_flow_ctrl)
 
+/* ****************************************************************************
+  主机侧收发统计: 每个CPU一份计数，写入方关本地中断后单写者更新，全程无锁
+  seq为奇数表示该CPU正在更新，快照读者据此重试，保证读到的每个CPU计数自洽
+**************************************************************************** */
+typedef struct {
+    volatile hi_u32 seq;
+    wal_netdev_stats_cnt_stru vap[WLAN_VAP_NUM_PER_BOARD];
+} wal_netdev_stats_ctx_stru;
+
+#if (_PRE_OS_VERSION_LINUX == _PRE_OS_VERSION)
+typedef unsigned long wal_netdev_stats_irq_flag;
+static DEFINE_PER_CPU(wal_netdev_stats_ctx_stru, g_wal_netdev_stats);
+#define wal_netdev_stats_ctx_num()          nr_cpu_ids
+#define wal_netdev_stats_ctx_valid(_id)     cpu_possible(_id)
+#define wal_netdev_stats_ctx(_id)           per_cpu_ptr(&g_wal_netdev_stats, _id)
+#define wal_netdev_stats_ctx_local()        this_cpu_ptr(&g_wal_netdev_stats)
+#define wal_netdev_stats_irq_save(_flags)   local_irq_save(_flags)
+#define wal_netdev_stats_irq_restore(_flags) local_irq_restore(_flags)
+#define wal_netdev_stats_barrier()          oal_smp_mb()
+#elif (_PRE_OS_VERSION_LITEOS == _PRE_OS_VERSION)
+typedef hi_u32 wal_netdev_stats_irq_flag;
+#ifdef LOSCFG_KERNEL_SMP
+#define WAL_NETDEV_STATS_CTX_NUM            LOSCFG_KERNEL_CORE_NUM
+#define wal_netdev_stats_ctx_id()           ArchCurrCpuid()
+#else
+#define WAL_NETDEV_STATS_CTX_NUM            1
+#define wal_netdev_stats_ctx_id()           0
+#endif
+static wal_netdev_stats_ctx_stru g_wal_netdev_stats[WAL_NETDEV_STATS_CTX_NUM];
+#define wal_netdev_stats_ctx_num()          WAL_NETDEV_STATS_CTX_NUM
+#define wal_netdev_stats_ctx_valid(_id)     HI_TRUE
+#define wal_netdev_stats_ctx(_id)           (&g_wal_netdev_stats[_id])
+#define wal_netdev_stats_ctx_local()        (&g_wal_netdev_stats[wal_netdev_stats_ctx_id()])
+#define wal_netdev_stats_irq_save(_flags)   ((_flags) = LOS_IntLock())
+#define wal_netdev_stats_irq_restore(_flags) LOS_IntRestore(_flags)
+#define wal_netdev_stats_barrier()          __sync_synchronize() /* oal_smp_mb在LiteOS下为空，这里需要真实屏障 */
+#endif
+
+/* 以下为单写者更新的量值(gauge)，不需要按CPU拆分 */
+static volatile hi_u32 g_wal_netdev_queue_len = 0;
+static volatile hi_u32 g_wal_netdev_queue_peak = 0;
+static volatile hi_u32 g_wal_netdev_flowctl_on_cnt = 0;
+
 /* ****************************************************************************
   3 函数实现
 **************************************************************************** */
@@ -309,6 +352,9 @@ hi_void netif_set_flow_ctrl_status(const struct NetDevice *netDev, netif_flow_ct
     }
 
     if (status == NETIF_FLOW_CTRL_ON) {
+        if (g_netif_flow_ctrl != NETIF_FLOW_CTRL_ON) {
+            g_wal_netdev_flowctl_on_cnt++;
+        }
         g_netif_flow_ctrl = NETIF_FLOW_CTRL_ON;
     } else if (status == NETIF_FLOW_CTRL_OFF) {
         g_netif_flow_ctrl = NETIF_FLOW_CTRL_OFF;
@@ -1136,22 +1182,206 @@ hi_s32 wal_netdev_stop(oal_net_device_stru *netdev)
     return HI_SUCCESS;
 }
 
+/* ****************************************************************************
+ 功能描述  : 开始更新本CPU的统计计数，返回时本地中断已关闭
+**************************************************************************** */
+static inline wal_netdev_stats_ctx_stru *wal_netdev_stats_begin(wal_netdev_stats_irq_flag *flags)
+{
+    wal_netdev_stats_ctx_stru *ctx = HI_NULL;
+
+    wal_netdev_stats_irq_save(*flags);
+    ctx = wal_netdev_stats_ctx_local();
+    ctx->seq++;
+    wal_netdev_stats_barrier();
+    return ctx;
+}
+
+static inline hi_void wal_netdev_stats_end(wal_netdev_stats_ctx_stru *ctx, wal_netdev_stats_irq_flag flags)
+{
+    wal_netdev_stats_barrier();
+    ctx->seq++;
+    wal_netdev_stats_irq_restore(flags);
+}
+
+/* ****************************************************************************
+ 功能描述  : 统计一个成功交给hcc的发送报文
+ 输入参数  : vap_id: 发送VAP, ac: 报文所属AC, len: 报文长度
+**************************************************************************** */
+hi_void wal_netdev_stats_tx(hi_u8 vap_id, hi_u8 ac, hi_u32 len)
+{
+    wal_netdev_stats_irq_flag flags;
+    wal_netdev_stats_ctx_stru *ctx = HI_NULL;
+
+    if (vap_id >= WLAN_VAP_NUM_PER_BOARD) {
+        return;
+    }
+    ac = (ac >= WLAN_WME_AC_BUTT) ? WLAN_WME_AC_BE : ac;
+
+    ctx = wal_netdev_stats_begin(&flags);
+    ctx->vap[vap_id].tx_packets[ac]++;
+    ctx->vap[vap_id].tx_bytes[ac] += len;
+    wal_netdev_stats_end(ctx, flags);
+}
+
+/* ****************************************************************************
+ 功能描述  : 统计一个上报协议栈的接收报文
+ 输入参数  : vap_id: 接收VAP, ac: 报文所属AC, len: 报文长度
+**************************************************************************** */
+hi_void wal_netdev_stats_rx(hi_u8 vap_id, hi_u8 ac, hi_u32 len)
+{
+    wal_netdev_stats_irq_flag flags;
+    wal_netdev_stats_ctx_stru *ctx = HI_NULL;
+
+    if (vap_id >= WLAN_VAP_NUM_PER_BOARD) {
+        return;
+    }
+    ac = (ac >= WLAN_WME_AC_BUTT) ? WLAN_WME_AC_BE : ac;
+
+    ctx = wal_netdev_stats_begin(&flags);
+    ctx->vap[vap_id].rx_packets[ac]++;
+    ctx->vap[vap_id].rx_bytes[ac] += len;
+    wal_netdev_stats_end(ctx, flags);
+}
+
+/* ****************************************************************************
+ 功能描述  : 按原因统计发送方向丢包
+**************************************************************************** */
+hi_void wal_netdev_stats_tx_drop(hi_u8 vap_id, wal_netdev_drop_reason_enum_uint8 reason)
+{
+    wal_netdev_stats_irq_flag flags;
+    wal_netdev_stats_ctx_stru *ctx = HI_NULL;
+
+    if (vap_id >= WLAN_VAP_NUM_PER_BOARD) {
+        return;
+    }
+    reason = (reason >= WAL_NETDEV_DROP_BUTT) ? WAL_NETDEV_DROP_OTHER : reason;
+
+    ctx = wal_netdev_stats_begin(&flags);
+    ctx->vap[vap_id].tx_drop[reason]++;
+    wal_netdev_stats_end(ctx, flags);
+}
+
+/* ****************************************************************************
+ 功能描述  : 按原因统计接收方向丢包
+**************************************************************************** */
+hi_void wal_netdev_stats_rx_drop(hi_u8 vap_id, wal_netdev_drop_reason_enum_uint8 reason)
+{
+    wal_netdev_stats_irq_flag flags;
+    wal_netdev_stats_ctx_stru *ctx = HI_NULL;
+
+    if (vap_id >= WLAN_VAP_NUM_PER_BOARD) {
+        return;
+    }
+    reason = (reason >= WAL_NETDEV_DROP_BUTT) ? WAL_NETDEV_DROP_OTHER : reason;
+
+    ctx = wal_netdev_stats_begin(&flags);
+    ctx->vap[vap_id].rx_drop[reason]++;
+    wal_netdev_stats_end(ctx, flags);
+}
+
+/* ****************************************************************************
+ 功能描述  : 刷新hcc DATA_LO发送队列的占用，仅由hcc发送线程调用
+**************************************************************************** */
+hi_void wal_netdev_stats_queue_update(hi_u32 queue_len)
+{
+    g_wal_netdev_queue_len = queue_len;
+    if (queue_len > g_wal_netdev_queue_peak) {
+        g_wal_netdev_queue_peak = queue_len;
+    }
+}
+
+static hi_void wal_netdev_stats_cnt_add(wal_netdev_stats_cnt_stru *sum, const wal_netdev_stats_cnt_stru *cnt)
+{
+    hi_u8 idx;
+
+    for (idx = 0; idx < WLAN_WME_AC_BUTT; idx++) {
+        sum->tx_packets[idx] += cnt->tx_packets[idx];
+        sum->tx_bytes[idx] += cnt->tx_bytes[idx];
+        sum->rx_packets[idx] += cnt->rx_packets[idx];
+        sum->rx_bytes[idx] += cnt->rx_bytes[idx];
+    }
+    for (idx = 0; idx < WAL_NETDEV_DROP_BUTT; idx++) {
+        sum->tx_drop[idx] += cnt->tx_drop[idx];
+        sum->rx_drop[idx] += cnt->rx_drop[idx];
+    }
+}
+
+/* ****************************************************************************
+ 功能描述  : 获取指定VAP的统计快照，逐CPU按seq无锁读取后求和，不会读到更新一半的计数
+ 输入参数  : vap_id: VAP索引
+ 输出参数  : snapshot: 统计快照
+**************************************************************************** */
+hi_void wal_netdev_stats_snapshot(hi_u8 vap_id, wal_netdev_stats_snapshot_stru *snapshot)
+{
+    wal_netdev_stats_cnt_stru cnt;
+    wal_netdev_stats_ctx_stru *ctx = HI_NULL;
+    hi_u32 id;
+    hi_u32 seq;
+
+    if (snapshot == HI_NULL) {
+        return;
+    }
+    memset_s(snapshot, sizeof(wal_netdev_stats_snapshot_stru), 0, sizeof(wal_netdev_stats_snapshot_stru));
+    if (vap_id >= WLAN_VAP_NUM_PER_BOARD) {
+        return;
+    }
+
+    for (id = 0; id < (hi_u32)wal_netdev_stats_ctx_num(); id++) {
+        if (!wal_netdev_stats_ctx_valid(id)) {
+            continue;
+        }
+        ctx = wal_netdev_stats_ctx(id);
+        do {
+            seq = ctx->seq;
+            wal_netdev_stats_barrier();
+            cnt = ctx->vap[vap_id];
+            wal_netdev_stats_barrier();
+        } while (((seq & 1) != 0) || (seq != ctx->seq));
+        wal_netdev_stats_cnt_add(&snapshot->cnt, &cnt);
+    }
+
+    snapshot->queue_len = g_wal_netdev_queue_len;
+    snapshot->queue_peak = g_wal_netdev_queue_peak;
+    snapshot->flowctl_on_cnt = g_wal_netdev_flowctl_on_cnt;
+}
+
 /* ****************************************************************************
  函 数 名  : wal_netdev_get_stats
- 功能描述  : 获取统计信息
+ 功能描述  : 获取统计信息，由统计快照汇总各AC计数和各原因丢包
 **************************************************************************** */
 static oal_net_device_stats_stru *wal_netdev_get_stats(oal_net_device_stru *netdev)
 {
     oal_net_device_stats_stru *stats = HI_NULL;
+    wal_netdev_stats_snapshot_stru snapshot;
+    hi_u8 idx;
 
     if (netdev == HI_NULL) {
         return HI_NULL;
     }
-    stats = &(netdev->stats); // modify by zhangwensheng temp
-    stats->rxPackets = 10;
-    stats->rxBytes = 10;
-    stats->txPackets = 10;
-    stats->txBytes = 10;
+    stats = &(netdev->stats);
+
+    mac_vap_stru *mac_vap = (mac_vap_stru *)oal_net_dev_priv(netdev);
+    if (mac_vap == HI_NULL) {
+        return stats;
+    }
+    wal_netdev_stats_snapshot(mac_vap->vap_id, &snapshot);
+
+    stats->rxPackets = 0;
+    stats->rxBytes = 0;
+    stats->txPackets = 0;
+    stats->txBytes = 0;
+    stats->rxDropped = 0;
+    stats->txDropped = 0;
+    for (idx = 0; idx < WLAN_WME_AC_BUTT; idx++) {
+        stats->rxPackets += (hi_u32)snapshot.cnt.rx_packets[idx];
+        stats->rxBytes += (hi_u32)snapshot.cnt.rx_bytes[idx];
+        stats->txPackets += (hi_u32)snapshot.cnt.tx_packets[idx];
+        stats->txBytes += (hi_u32)snapshot.cnt.tx_bytes[idx];
+    }
+    for (idx = 0; idx < WAL_NETDEV_DROP_BUTT; idx++) {
+        stats->rxDropped += snapshot.cnt.rx_drop[idx];
+        stats->txDropped += snapshot.cnt.tx_drop[idx];
+    }
 
     return stats;
 }
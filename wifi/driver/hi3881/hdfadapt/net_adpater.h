@@ -57,6 +57,17 @@ typedef enum {
     WAL_ADDR_IDX_BUTT
 } wal_addr_idx;
 
+/* 主机侧丢包原因，按发生的阶段细分 */
+typedef enum {
+    WAL_NETDEV_DROP_FLOWCTL      = 0,   /* 主机侧发送队列超限(流控)丢弃 */
+    WAL_NETDEV_DROP_HCC_OVERFLOW = 1,   /* hcc队列按AC水线反压或关键帧缓存溢出丢弃 */
+    WAL_NETDEV_DROP_NOMEM        = 2,   /* netbuf/事件内存申请失败 */
+    WAL_NETDEV_DROP_VAP_DOWN     = 3,   /* VAP未处于UP/PAUSE状态 */
+    WAL_NETDEV_DROP_OTHER        = 4,   /* hmac收发流程其他失败 */
+    WAL_NETDEV_DROP_BUTT
+} wal_netdev_drop_reason_enum;
+typedef hi_u8 wal_netdev_drop_reason_enum_uint8;
+
 /* ****************************************************************************
   7 STRUCT定义
 **************************************************************************** */
@@ -65,6 +76,24 @@ typedef struct {
     hi_u16 us_status;
 } wal_dev_addr_stru;
 
+/* 单个VAP的收发计数: 发送字节按hcc负载长度，接收字节按上报协议栈的帧长 */
+typedef struct {
+    hi_u64 tx_packets[WLAN_WME_AC_BUTT];
+    hi_u64 tx_bytes[WLAN_WME_AC_BUTT];
+    hi_u64 rx_packets[WLAN_WME_AC_BUTT];
+    hi_u64 rx_bytes[WLAN_WME_AC_BUTT];
+    hi_u32 tx_drop[WAL_NETDEV_DROP_BUTT];
+    hi_u32 rx_drop[WAL_NETDEV_DROP_BUTT];
+} wal_netdev_stats_cnt_stru;
+
+/* 统计快照: 各CPU计数之和，以及获取快照时刻的队列占用 */
+typedef struct {
+    wal_netdev_stats_cnt_stru cnt;
+    hi_u32 queue_len;           /* hcc DATA_LO发送队列当前深度 */
+    hi_u32 queue_peak;          /* hcc DATA_LO发送队列历史最大深度 */
+    hi_u32 flowctl_on_cnt;      /* 协议栈流控打开次数 */
+} wal_netdev_stats_snapshot_stru;
+
 /* ****************************************************************************
   10 函数声明
 **************************************************************************** */
@@ -91,6 +120,12 @@ oal_net_device_ops_stru *wal_get_net_dev_ops(hi_void);
 hi_u32 wal_get_efuse_mac_addr(hi_void);
 hi_s32 InitNetdev(struct NetDevice *netDevice, nl80211_iftype_uint8 type);
 hi_s32 DeinitNetdev(nl80211_iftype_uint8 type);
+hi_void wal_netdev_stats_tx(hi_u8 vap_id, hi_u8 ac, hi_u32 len);
+hi_void wal_netdev_stats_rx(hi_u8 vap_id, hi_u8 ac, hi_u32 len);
+hi_void wal_netdev_stats_tx_drop(hi_u8 vap_id, wal_netdev_drop_reason_enum_uint8 reason);
+hi_void wal_netdev_stats_rx_drop(hi_u8 vap_id, wal_netdev_drop_reason_enum_uint8 reason);
+hi_void wal_netdev_stats_queue_update(hi_u32 queue_len);
+hi_void wal_netdev_stats_snapshot(hi_u8 vap_id, wal_netdev_stats_snapshot_stru *snapshot);
 #ifdef __cplusplus
 #if __cplusplus
 }
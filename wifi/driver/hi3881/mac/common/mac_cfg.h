@@ -603,10 +603,10 @@ typedef struct {
     hi_u8 auc_rsv[3];          /* 3 byte保留字段，保证word对齐 */
 } mac_cfg_p2p_stat_param_stru;
 
-/* 组播转单播 发送参数 */
+/* 组播转单播 侦听参数 */
 typedef struct {
-    hi_u8 m2u_mcast_mode;
-    hi_u8 m2u_snoop_on;
+    hi_u8 m2u_snoop_on;     /* 组播侦听及转单播开关 */
+    hi_u8 max_member;       /* 成员数不超过该门限时转单播 */
 } mac_cfg_m2u_snoop_on_param_stru;
 
 /* =================== 以下为解析内核配置参数转化为驱动内部参数下发的结构体 ======================== */
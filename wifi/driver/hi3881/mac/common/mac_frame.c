@@ -104,6 +104,110 @@ WIFI_ROM_TEXT hi_u8 *mac_find_vendor_ie(hi_u32 oui, hi_u8 oui_type, hi_u8 *puc_i
     return HI_NULL;
 }
 
+/* ****************************************************************************
+ 功能描述  : 获取厂家自定义IE在索引表中的槽位，未收录的IE返回MAC_IE_IDX_BUTT
+**************************************************************************** */
+static mac_ie_idx_enum_uint8 mac_ie_vendor_index_slot(const hi_u8 *puc_ie)
+{
+    const mac_ieee80211_vendor_ie_stru *ie = (const mac_ieee80211_vendor_ie_stru *)puc_ie;
+    hi_u32 ie_oui;
+
+    if (ie->len < (sizeof(mac_ieee80211_vendor_ie_stru) - MAC_IE_HDR_LEN)) {
+        return MAC_IE_IDX_BUTT;
+    }
+    ie_oui = ((hi_u32)ie->auc_oui[0] << 16) |                /* auc_oui[0]存于最高16bit */
+        ((hi_u32)ie->auc_oui[1] << 8) | ie->auc_oui[2];      /* auc_oui[1]存于次高8bit，auc_oui[2]存于最低8bit */
+    if (ie_oui == MAC_WLAN_OUI_MICROSOFT) {
+        if (ie->oui_type == MAC_WLAN_OUI_TYPE_MICROSOFT_WPA) {
+            return MAC_IE_IDX_WPA;
+        } else if (ie->oui_type == MAC_WLAN_OUI_TYPE_MICROSOFT_WPS) {
+            return MAC_IE_IDX_WPS;
+        } else if ((ie->len >= 6) && (mac_is_wmm_ie(puc_ie) == HI_TRUE)) { /* mac_is_wmm_ie检查到puc_ie[7]，len至少6 */
+            return MAC_IE_IDX_WMM;
+        }
+    } else if ((ie_oui == MAC_WLAN_OUI_WFA) && (ie->oui_type == MAC_WLAN_OUI_TYPE_WFA_P2P)) {
+        return MAC_IE_IDX_P2P;
+    } else if ((ie_oui == MAC_WLAN_OUI_VENDOR) && (ie->oui_type == MAC_OUITYPE_ANY)) {
+        return MAC_IE_IDX_ANY;
+#ifdef _PRE_WLAN_FEATURE_MESH_ROM
+    } else if ((ie_oui == MAC_WLAN_OUI_VENDOR) && (ie->oui_type == MAC_OUITYPE_MESH) &&
+        (ie->len >= MAC_MESH_MESHID_OFFSET - MAC_IE_HDR_LEN) &&
+        (puc_ie[MAC_IE_VENDOR_SPEC_MESH_SUBTYPE_POS] == MAC_OUISUBTYPE_MESH_HISI_MESHID)) {
+        /* 与mac_get_meshid一致，只收录能读到meshid长度字段的IE */
+        return MAC_IE_IDX_MESH_ID;
+#endif
+    }
+    return MAC_IE_IDX_BUTT;
+}
+
+/* ****************************************************************************
+ 功能描述  : 获取IE在索引表中的槽位，未收录的IE返回MAC_IE_IDX_BUTT
+**************************************************************************** */
+static mac_ie_idx_enum_uint8 mac_ie_index_slot(const hi_u8 *puc_ie)
+{
+    switch (puc_ie[0]) {
+        case MAC_EID_SSID:
+            return MAC_IE_IDX_SSID;
+        case MAC_EID_RATES:
+            return MAC_IE_IDX_RATES;
+        case MAC_EID_DSPARMS:
+            return MAC_IE_IDX_DSPARMS;
+        case MAC_EID_TIM:
+            return MAC_IE_IDX_TIM;
+        case MAC_EID_COUNTRY:
+            return MAC_IE_IDX_COUNTRY;
+        case MAC_EID_RSN:
+            return MAC_IE_IDX_RSN;
+        case MAC_EID_XRATES:
+            return MAC_IE_IDX_XRATES;
+        case MAC_EID_HT_CAP:
+            return MAC_IE_IDX_HT_CAP;
+        case MAC_EID_HT_OPERATION:
+            return MAC_IE_IDX_HT_OPERATION;
+        case MAC_EID_OBSS_SCAN:
+            return MAC_IE_IDX_OBSS_SCAN;
+        case MAC_EID_EXT_CAPS:
+            return MAC_IE_IDX_EXT_CAPS;
+#ifdef _PRE_WLAN_FEATURE_MESH_ROM
+        case MAC_EID_MESH_CONF:
+            return MAC_IE_IDX_MESH_CONF;
+#endif
+        case MAC_EID_VENDOR:
+            return mac_ie_vendor_index_slot(puc_ie);
+        default:
+            return MAC_IE_IDX_BUTT;
+    }
+}
+
+/* ****************************************************************************
+ 功能描述  : 单次遍历IE区，记录常用IE第一次出现的位置，替代对同一帧反复调用mac_find_ie
+ 输入参数  : [1]puc_ies IE区起始地址
+             [2]ie_len IE区长度
+ 输出参数  : [1]ie_index 索引表
+**************************************************************************** */
+hi_void mac_ie_build_index(mac_ie_index_stru *ie_index, hi_u8 *puc_ies, hi_u32 ie_len)
+{
+    hi_u8 *puc_pos = puc_ies;
+    hi_u32 remain = ie_len;
+    mac_ie_idx_enum_uint8 slot;
+
+    /* 安全编程规则6.6例外(1) 对固定长度的结构体进行内存初始化 */
+    memset_s(ie_index, sizeof(mac_ie_index_stru), 0, sizeof(mac_ie_index_stru));
+    if (puc_ies == HI_NULL) {
+        return;
+    }
+
+    /* 与mac_find_ie保持一致: 遇到长度越界的IE即停止，其后的IE视为不存在 */
+    while ((remain >= MAC_IE_HDR_LEN) && (remain >= (hi_u32)(MAC_IE_HDR_LEN + puc_pos[1]))) {
+        slot = mac_ie_index_slot(puc_pos);
+        if ((slot != MAC_IE_IDX_BUTT) && (ie_index->apuc_ie[slot] == HI_NULL)) {
+            ie_index->apuc_ie[slot] = puc_pos;
+        }
+        remain -= (hi_u32)(MAC_IE_HDR_LEN + puc_pos[1]);
+        puc_pos += MAC_IE_HDR_LEN + puc_pos[1];
+    }
+}
+
 /* ****************************************************************************
  功能描述  : 作为ap时，根据mib值，设置cap info
  输入参数  : pst_vap      : 指向vap
@@ -288,6 +288,9 @@ extern "C" {
 /* ICMP协议报文 */
 #define MAC_ICMP_PROTOCAL                                  1
 
+/* IGMP协议报文 */
+#define MAC_IGMP_PROTOCAL                                  2
+
 #define MAC_VENDER_IE                                      0xAC853D /* 打桩HW IE */
 #define MAC_HISI_HISTREAM_IE                               0x11     /* histream IE */
 
@@ -341,6 +344,12 @@ extern "C" {
 #define MAC_IGMPV2_LEAVE_TYPE     0x17
 #define MAC_IGMPV3_REPORT_TYPE    0x22
 
+/* MLD(ICMPv6) record type */
+#define MAC_MLD_QUERY_TYPE        130
+#define MAC_MLDV1_REPORT_TYPE     131
+#define MAC_MLDV1_DONE_TYPE       132
+#define MAC_MLDV2_REPORT_TYPE     143
+#define MAC_IPV6_NEXTHDR_HOP      0     /* IPv6逐跳选项扩展头 */
 
 /* V3 group record types [grec_type] */
 #define IGMPV3_MODE_IS_INCLUDE        1
@@ -1613,6 +1622,41 @@ typedef struct mac_set_quiet_ie_info_stru {
     hi_u16 us_qoffset;
 } mac_set_quiet_ie_info_stru;
 
+/* IE索引表中的槽位，只收录解析流程中频繁查找的IE */
+typedef enum {
+    MAC_IE_IDX_SSID,
+    MAC_IE_IDX_RATES,
+    MAC_IE_IDX_DSPARMS,
+    MAC_IE_IDX_TIM,
+    MAC_IE_IDX_COUNTRY,
+    MAC_IE_IDX_RSN,
+    MAC_IE_IDX_XRATES,
+    MAC_IE_IDX_HT_CAP,
+    MAC_IE_IDX_HT_OPERATION,
+    MAC_IE_IDX_OBSS_SCAN,
+    MAC_IE_IDX_EXT_CAPS,
+#ifdef _PRE_WLAN_FEATURE_MESH_ROM
+    MAC_IE_IDX_MESH_CONF,
+#endif
+    /* 以下为厂家自定义IE，按OUI + OUI type区分 */
+    MAC_IE_IDX_WPA,
+    MAC_IE_IDX_WMM,
+    MAC_IE_IDX_WPS,
+    MAC_IE_IDX_P2P,
+    MAC_IE_IDX_ANY,
+#ifdef _PRE_WLAN_FEATURE_MESH_ROM
+    MAC_IE_IDX_MESH_ID,     /* Hisi Mesh私有IE中的meshid子类型 */
+#endif
+
+    MAC_IE_IDX_BUTT
+} mac_ie_idx_enum;
+typedef hi_u8 mac_ie_idx_enum_uint8;
+
+/* 单次遍历IE区得到的索引表，记录每种IE第一次出现的位置，与mac_find_ie的查找结果一致 */
+typedef struct {
+    hi_u8 *apuc_ie[MAC_IE_IDX_BUTT];
+} mac_ie_index_stru;
+
 /* ****************************************************************************
   函数声明
 **************************************************************************** */
@@ -1660,6 +1704,7 @@ hi_u8 mac_get_bss_type(hi_u16 us_cap_info);
 hi_u8 *mac_get_wmm_ie(hi_u8 *puc_beacon_body, hi_u16 us_frame_len, hi_u16 us_offset);
 hi_u8 *mac_find_ie(hi_u8 eid, hi_u8 *puc_ies, hi_u32 l_len);
 hi_u8 *mac_find_vendor_ie(hi_u32 oui, hi_u8 oui_type, hi_u8 *puc_ies, hi_s32 l_len);
+hi_void mac_ie_build_index(mac_ie_index_stru *ie_index, hi_u8 *puc_ies, hi_u32 ie_len);
 hi_u8 *mac_get_ssid(hi_u8 *puc_beacon_body, hi_s32 l_frame_body_len, hi_u8 *puc_ssid_len);
 hi_u16 mac_get_beacon_period(const hi_u8 *puc_beacon_body);
 hi_u16 mac_get_rsn_capability(const hi_u8 *puc_rsn_ie);
@@ -2265,6 +2310,14 @@ static inline hi_u8 mac_is_wmm_ie(const hi_u8 *puc_ie)
     return HI_FALSE;
 }
 
+/* ****************************************************************************
+ 功能描述  : 从IE索引表中获取指定IE，不存在时返回空指针
+**************************************************************************** */
+static inline hi_u8 *mac_ie_index_find(const mac_ie_index_stru *ie_index, mac_ie_idx_enum_uint8 idx)
+{
+    return ie_index->apuc_ie[idx];
+}
+
 /* ****************************************************************************
  功能描述  : 设置Channel Switch Announcement IE
  输入参数  : pst_mac_vap: MAC VAP结构体指针
@@ -484,27 +484,25 @@ wlan_mib_mimo_power_save_enum_uint8 mac_ie_proc_sm_power_save_field(hi_u8 smps)
     作    者   : HiSilicon
     修改内容   : 新生成函数
 **************************************************************************** */
-hi_u8 mac_ie_get_chan_num(hi_u8 *puc_frame_body, hi_u16 us_frame_len, hi_u16 us_offset, hi_u8 curr_chan)
+hi_u8 mac_ie_get_chan_num(const mac_ie_index_stru *ie_index, hi_u8 curr_chan)
 {
     hi_u8 chan_num;
     hi_u8 *puc_ie_start_addr = HI_NULL;
 
-    if (us_frame_len > us_offset) {
-        /* 在DSSS Param set ie中解析chan num */
-        puc_ie_start_addr = mac_find_ie(MAC_EID_DSPARMS, puc_frame_body + us_offset, us_frame_len - us_offset);
-        if ((puc_ie_start_addr != HI_NULL) && (puc_ie_start_addr[1] == MAC_DSPARMS_LEN)) {
-            chan_num = puc_ie_start_addr[2]; /* 从ie_start_addr第2 byte获取信道数 */
-            if (mac_is_channel_num_valid(mac_get_band_by_channel_num(chan_num), chan_num) == HI_SUCCESS) {
-                return chan_num;
-            }
+    /* 在DSSS Param set ie中解析chan num */
+    puc_ie_start_addr = mac_ie_index_find(ie_index, MAC_IE_IDX_DSPARMS);
+    if ((puc_ie_start_addr != HI_NULL) && (puc_ie_start_addr[1] == MAC_DSPARMS_LEN)) {
+        chan_num = puc_ie_start_addr[2]; /* 从ie_start_addr第2 byte获取信道数 */
+        if (mac_is_channel_num_valid(mac_get_band_by_channel_num(chan_num), chan_num) == HI_SUCCESS) {
+            return chan_num;
         }
-        /* 在HT operation ie中解析 chan num */
-        puc_ie_start_addr = mac_find_ie(MAC_EID_HT_OPERATION, puc_frame_body + us_offset, us_frame_len - us_offset);
-        if ((puc_ie_start_addr != HI_NULL) && (puc_ie_start_addr[1] >= 1)) {
-            chan_num = puc_ie_start_addr[2]; /* 从ie_start_addr第2 byte获取信道数 */
-            if (mac_is_channel_num_valid(mac_get_band_by_channel_num(chan_num), chan_num) == HI_SUCCESS) {
-                return chan_num;
-            }
+    }
+    /* 在HT operation ie中解析 chan num */
+    puc_ie_start_addr = mac_ie_index_find(ie_index, MAC_IE_IDX_HT_OPERATION);
+    if ((puc_ie_start_addr != HI_NULL) && (puc_ie_start_addr[1] >= 1)) {
+        chan_num = puc_ie_start_addr[2]; /* 从ie_start_addr第2 byte获取信道数 */
+        if (mac_is_channel_num_valid(mac_get_band_by_channel_num(chan_num), chan_num) == HI_SUCCESS) {
+            return chan_num;
         }
     }
     chan_num = curr_chan;
@@ -98,7 +98,7 @@ hi_u8 mac_ie_proc_ht_supported_channel_width(const mac_user_stru *mac_user_sta,
     hi_u8 supported_channel_width, hi_bool prev_asoc_ht);
 hi_u8 mac_ie_proc_lsig_txop_protection_support(const mac_user_stru *mac_user_sta, mac_vap_stru *mac_vap,
     hi_u8 lsig_txop_protection_support, hi_bool prev_asoc_ht);
-hi_u8 mac_ie_get_chan_num(hi_u8 *puc_frame_body, hi_u16 us_frame_len, hi_u16 us_offset, hi_u8 curr_chan);
+hi_u8 mac_ie_get_chan_num(const mac_ie_index_stru *ie_index, hi_u8 curr_chan);
 hi_u32 mac_set_second_channel_offset_ie(wlan_channel_bandwidth_enum_uint8 bw, hi_u8 *pauc_buffer,
     hi_u8 *puc_output_len);
 hi_u8 mac_ie_check_p2p_action(const hi_u8 *puc_payload);
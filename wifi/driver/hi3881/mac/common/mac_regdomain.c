@@ -195,27 +195,19 @@ hi_void mac_get_channel_num_from_idx(hi_u8 band, hi_u8 idx, hi_u8 *puc_channel_n
 **************************************************************************** */
 hi_u32 mac_get_channel_idx_from_num(hi_u8 band, hi_u8 channel_num, hi_u8 *puc_channel_idx)
 {
-    mac_channel_info_stru *channel = HI_NULL;
-    hi_u8 total_channel_num = 0;
     hi_u8 idx;
 
-    /* 根据频段获取信道信息 */
-    switch (band) {
-        case MAC_RC_START_FREQ_2:
-            channel = g_ast_channel_list_2g;
-            total_channel_num = (hi_u8)MAC_CHANNEL_FREQ_2_BUTT;
-            break;
-        default:
-            return HI_ERR_CODE_INVALID_CONFIG;
+    if (band != MAC_RC_START_FREQ_2) {
+        return HI_ERR_CODE_INVALID_CONFIG;
     }
-    /* 检查信道索引号 */
-    for (idx = 0; idx < total_channel_num; idx++) {
-        if (channel[idx].chan_number == channel_num) {
-            *puc_channel_idx = idx;
-            return HI_SUCCESS;
-        }
+    /* 2.4G信道表按信道号1~14连续排列，信道号减1即为索引，直接查表 */
+    idx = channel_num - 1;
+    if ((channel_num == 0) || (idx >= (hi_u8)MAC_CHANNEL_FREQ_2_BUTT) ||
+        (g_ast_channel_list_2g[idx].chan_number != channel_num)) {
+        return HI_ERR_CODE_INVALID_CONFIG;
     }
-    return HI_ERR_CODE_INVALID_CONFIG;
+    *puc_channel_idx = idx;
+    return HI_SUCCESS;
 }
 
 /* ****************************************************************************
@@ -44,32 +44,6 @@ extern "C" {
 #endif /* end of _PRE_WLAN_FEATURE_TX_CLASSIFY_LAN_TO_WLAN */
 #define MAC_RES_USER_SIZE (4000 + FEATURE_TX_CLASSIFY_LAN_TO_WLAN_RES_SIZE)
 
-/* ****************************************************************************
-  STRUCT定义
-**************************************************************************** */
-typedef struct {
-    hi_list             entry;
-    hi_u8               user_idx;                /* 记录对应的USER的索引值 */
-    hi_u8               uc_resv;
-    hi_u16              us_hash_res_idx;            /* 记录对应的HASH资源池的索引值 */
-}mac_res_user_hash_stru;
-
-typedef struct {
-    mac_res_user_hash_stru  *user_hash_info;
-    oal_queue_stru           queue;
-    hi_u32                  *pul_idx;
-    hi_u8                   *puc_user_cnt;
-}mac_res_hash_stru;
-
-/* ****************************************************************************
-  10 函数声明
-**************************************************************************** */
-hi_void mac_res_exit(hi_void);
-hi_u32 mac_res_init(hi_void);
-hi_u32 mac_res_free_hash(hi_u32 hash_idx);
-hi_u32 mac_res_alloc_hash(hi_u8 *puc_hash_idx);
-mac_res_user_hash_stru *mac_res_get_hash(hi_u8 dev_idx);
-
 #ifdef __cplusplus
 #if __cplusplus
 }
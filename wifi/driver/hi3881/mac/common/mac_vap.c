@@ -255,6 +255,56 @@ WIFI_ROM_TEXT hi_void mac_vap_init_wme_param(const mac_vap_stru *mac_vap)
     }
 }
 
+/* ****************************************************************************
+ 功能描述  : 在用户哈希表中插入键值，线性探测到第一个空槽
+ 返 回 值  : 插入的槽位，表中已存在或表满时返回MAC_INVALID_USER_ID
+**************************************************************************** */
+WIFI_ROM_TEXT static hi_u8 mac_vap_user_hash_insert(mac_vap_stru *mac_vap, hi_u64 ull_key, hi_u8 user_idx)
+{
+    hi_u32 slot = mac_calculate_hash_value(ull_key);
+    hi_u32 loop;
+
+    for (loop = 0; loop < MAC_VAP_USER_HASH_MAX_VALUE; loop++) {
+        if (mac_vap->aull_user_hash_key[slot] == ull_key) {
+            return MAC_INVALID_USER_ID;
+        }
+        if (mac_vap->aull_user_hash_key[slot] == 0) {
+            mac_vap->aull_user_hash_key[slot] = ull_key;
+            mac_vap->auc_user_hash_idx[slot]  = user_idx;
+            return (hi_u8)slot;
+        }
+        slot = (slot + 1) & (MAC_VAP_USER_HASH_MAX_VALUE - 1);
+    }
+    return MAC_INVALID_USER_ID;
+}
+
+/* ****************************************************************************
+ 功能描述  : 删除用户哈希表槽位，后续探测链上的表项前移填补空洞，不使用墓碑
+**************************************************************************** */
+WIFI_ROM_TEXT static hi_void mac_vap_user_hash_remove(mac_vap_stru *mac_vap, hi_u32 slot)
+{
+    const hi_u32 mask = MAC_VAP_USER_HASH_MAX_VALUE - 1;
+    hi_u32 hole = slot;
+    hi_u32 next = (slot + 1) & mask;
+
+    while (mac_vap->aull_user_hash_key[next] != 0) {
+        hi_u32 home = mac_calculate_hash_value(mac_vap->aull_user_hash_key[next]);
+        /* 表项的理想槽位不在(hole, next]区间内时，前移到空洞处仍可被探测到 */
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            mac_user_stru *user = mac_user_get_user_stru(mac_vap->auc_user_hash_idx[next]);
+            mac_vap->aull_user_hash_key[hole] = mac_vap->aull_user_hash_key[next];
+            mac_vap->auc_user_hash_idx[hole]  = mac_vap->auc_user_hash_idx[next];
+            if (user != HI_NULL) {
+                user->user_hash_idx = (hi_u8)hole;
+            }
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+    mac_vap->aull_user_hash_key[hole] = 0;
+    mac_vap->auc_user_hash_idx[hole]  = MAC_INVALID_USER_ID;
+}
+
 /* ****************************************************************************
  功能描述  : 增加关联用户，获取hash值并加入hash表中
  输入参数  : vap对象内存指针，以及user对象指针(user对象需要在调用此函数前申请并赋值)
@@ -266,48 +316,39 @@ WIFI_ROM_TEXT hi_void mac_vap_init_wme_param(const mac_vap_stru *mac_vap)
 WIFI_ROM_TEXT hi_u32 mac_vap_add_assoc_user(mac_vap_stru *mac_vap, hi_u8 user_idx)
 {
     mac_user_stru              *user = HI_NULL;
-    mac_res_user_hash_stru     *hash = HI_NULL;
-    hi_u32                  rslt;
-    hi_u8                   hash_idx;
-    hi_list                    *dlist_head = HI_NULL;
-    unsigned long            irq_save;
+    hi_u64                      ull_key;
+    hi_u8                       slot;
+    unsigned long               irq_save;
+
     user = mac_user_get_user_stru(user_idx);
     if (oal_unlikely(user == HI_NULL)) {
         oam_error_log1(mac_vap->vap_id, OAM_SF_ANY, "{mac_vap_add_assoc_user::pst_user[%d] null.}", user_idx);
         return HI_ERR_CODE_PTR_NULL;
     }
-    user->user_hash_idx = mac_calculate_hash_value(user->user_mac_addr);
-    rslt = mac_res_alloc_hash(&hash_idx);
-    if (rslt != HI_SUCCESS) {
-        oam_warning_log1(mac_vap->vap_id, OAM_SF_ANY, "{mac_vap_add_assoc_user::alloc hash failed[%d].}", rslt);
-        return rslt;
-    }
-    hash = mac_res_get_hash(hash_idx);
 
     if (mac_vap_user_exist(&(user->user_dlist), &(mac_vap->mac_user_list_head)) == HI_TRUE) {
-        mac_res_free_hash(hash_idx);
         oam_error_log1(mac_vap->vap_id, OAM_SF_ASSOC, "{mac_vap_add_assoc_user::user[%d] already exist.}", user_idx);
         return HI_ERR_CODE_PTR_NULL;
     }
-    hash->us_hash_res_idx = hash_idx; /* 记录HASH对应的资源池索引值 */
-    hash->user_idx = user_idx;        /* 记录对应的用户索引值 */
-    dlist_head = &(mac_vap->ast_user_hash[user->user_hash_idx]);
-    hi_list_head_insert(&(hash->entry), dlist_head);
-    dlist_head = &(mac_vap->mac_user_list_head); /* 加入双向链表表头 */
-    hi_list_head_insert(&(user->user_dlist), dlist_head);
 
+    ull_key = mac_addr_to_key(user->user_mac_addr);
     oal_spin_lock_irq_save(&mac_vap->cache_user_lock, &irq_save);
-
-    if (memcpy_s(mac_vap->auc_cache_user_mac_addr, WLAN_MAC_ADDR_LEN, /* 更新cache user */
-        user->user_mac_addr, WLAN_MAC_ADDR_LEN) != EOK) {
-        oam_error_log0(mac_vap->vap_id, OAM_SF_ASSOC, "{mac_vap_add_assoc_user::mem safe func err!}");
+    slot = mac_vap_user_hash_insert(mac_vap, ull_key, user_idx);
+    if (slot == MAC_INVALID_USER_ID) {
         oal_spin_unlock_irq_restore(&mac_vap->cache_user_lock, &irq_save);
+        oam_warning_log1(mac_vap->vap_id, OAM_SF_ANY, "{mac_vap_add_assoc_user::hash insert failed, user[%d].}",
+            user_idx);
         return HI_FAIL;
     }
-    mac_vap->cache_user_id = user_idx;
+    user->user_hash_idx = slot;
 
+    /* 更新cache user */
+    mac_vap->ull_cache_user_key = ull_key;
+    mac_vap->cache_user_id = user_idx;
     oal_spin_unlock_irq_restore(&mac_vap->cache_user_lock, &irq_save);
 
+    hi_list_head_insert(&(user->user_dlist), &(mac_vap->mac_user_list_head)); /* 加入双向链表表头 */
+
     if (mac_vap->vap_mode == WLAN_VAP_MODE_BSS_STA) { /* 记录STA模式下的与之关联的VAP的id */
         mac_vap_set_assoc_id(mac_vap, user_idx);
     }
@@ -315,61 +356,14 @@ WIFI_ROM_TEXT hi_u32 mac_vap_add_assoc_user(mac_vap_stru *mac_vap, hi_u8 user_id
     return HI_SUCCESS;
 }
 
-WIFI_ROM_TEXT hi_u32 mac_vap_user_remove_list(const hi_list *hash_head, mac_user_stru *user, hi_u8 user_idx)
-{
-    mac_user_stru          *user_temp = HI_NULL;
-    hi_list                *entry = HI_NULL;
-    mac_res_user_hash_stru *user_hash = HI_NULL;
-    hi_list                *dlist_tmp = HI_NULL;
-    hi_u32                  ret = HI_FAIL;
-
-    hi_list_for_each_safe(entry, dlist_tmp, hash_head) {
-        user_hash = (mac_res_user_hash_stru *)entry;
-        user_temp = mac_user_get_user_stru(user_hash->user_idx);
-        if (user_temp == HI_NULL) {
-            continue;
-        }
-        if (!oal_compare_mac_addr(user->user_mac_addr, user_temp->user_mac_addr, WLAN_MAC_ADDR_LEN)) {
-            hi_list_delete(entry);
-            /* 从双向链表中拆掉 */
-            hi_list_delete(&(user->user_dlist));
-            mac_res_free_hash(user_hash->us_hash_res_idx);
-
-            /* 初始化相应成员 */
-            user->user_hash_idx = 0xff;
-            user->us_assoc_id   = user_idx;
-            user->is_multi_user = HI_FALSE;
-            /* 安全编程规则6.6例外(1) 对固定长度的数组进行初始化，或对固定长度的结构体进行内存初始化 */
-            memset_s(user->user_mac_addr, WLAN_MAC_ADDR_LEN, 0, WLAN_MAC_ADDR_LEN);
-            user->vap_id          = 0x0f;
-            user->user_asoc_state = MAC_USER_STATE_BUTT;
-
-            ret = HI_SUCCESS;
-        }
-    }
-
-    return ret;
-}
-
 /* ****************************************************************************
  功能描述  : 删除用户，将用户从双向链表中删除，并从hash表中删除
 **************************************************************************** */
 WIFI_ROM_TEXT hi_u32 mac_vap_del_user(mac_vap_stru *mac_vap, hi_u8 user_idx)
 {
     mac_user_stru          *user = HI_NULL;
-    hi_list                *hash_head = HI_NULL;
-    hi_u32                 ret;
     unsigned long          irq_save;
 
-    oal_spin_lock_irq_save(&mac_vap->cache_user_lock, &irq_save);
-
-    if (user_idx == mac_vap->cache_user_id) { /* 与cache user id对比 , 相等则清空cache user */
-        oal_set_mac_addr_zero(mac_vap->auc_cache_user_mac_addr);
-        mac_vap->cache_user_id = MAC_INVALID_USER_ID;
-    }
-
-    oal_spin_unlock_irq_restore(&mac_vap->cache_user_lock, &irq_save);
-
     user = mac_user_get_user_stru(user_idx);
     if (oal_unlikely(user == HI_NULL)) {
         oam_error_log1(mac_vap->vap_id, OAM_SF_ASSOC, "{mac_vap_del_user::pst_user null, user_idx is %d}", user_idx);
@@ -382,24 +376,45 @@ WIFI_ROM_TEXT hi_u32 mac_vap_del_user(mac_vap_stru *mac_vap, hi_u8 user_idx)
         return HI_FAIL;
     }
 
-    hash_head = &(mac_vap->ast_user_hash[user->user_hash_idx]);
-    ret = mac_vap_user_remove_list(hash_head, user, user_idx);
-    if (ret == HI_SUCCESS) {
-        /* vap已关联 user个数-- */
-        if (mac_vap->user_nums) {
-            mac_vap->user_nums--;
-        }
-        /* STA模式下将关联的VAP的id置为非法值 */
-        if (mac_vap->vap_mode == WLAN_VAP_MODE_BSS_STA) {
-            mac_vap_set_assoc_id(mac_vap, 0xff);
-        }
-        return HI_SUCCESS;
+    oal_spin_lock_irq_save(&mac_vap->cache_user_lock, &irq_save);
+
+    if (user_idx == mac_vap->cache_user_id) { /* 与cache user id对比 , 相等则清空cache user */
+        mac_vap->ull_cache_user_key = 0;
+        mac_vap->cache_user_id = MAC_INVALID_USER_ID;
+    }
+
+    if ((mac_vap->auc_user_hash_idx[user->user_hash_idx] != user_idx) ||
+        (mac_vap->aull_user_hash_key[user->user_hash_idx] != mac_addr_to_key(user->user_mac_addr))) {
+        oal_spin_unlock_irq_restore(&mac_vap->cache_user_lock, &irq_save);
+        oam_warning_log1(mac_vap->vap_id, OAM_SF_ASSOC,
+            "{mac_vap_del_user::delete user failed,user idx is %d.}", user_idx);
+        return HI_FAIL;
     }
+    mac_vap_user_hash_remove(mac_vap, user->user_hash_idx);
 
-    oam_warning_log1(mac_vap->vap_id, OAM_SF_ASSOC,
-        "{mac_vap_del_user::delete user failed,user idx is %d.}", user_idx);
+    oal_spin_unlock_irq_restore(&mac_vap->cache_user_lock, &irq_save);
 
-    return HI_FAIL;
+    /* 从双向链表中拆掉 */
+    hi_list_delete(&(user->user_dlist));
+
+    /* 初始化相应成员 */
+    user->user_hash_idx = 0xff;
+    user->us_assoc_id   = user_idx;
+    user->is_multi_user = HI_FALSE;
+    /* 安全编程规则6.6例外(1) 对固定长度的数组进行初始化，或对固定长度的结构体进行内存初始化 */
+    memset_s(user->user_mac_addr, WLAN_MAC_ADDR_LEN, 0, WLAN_MAC_ADDR_LEN);
+    user->vap_id          = 0x0f;
+    user->user_asoc_state = MAC_USER_STATE_BUTT;
+
+    /* vap已关联 user个数-- */
+    if (mac_vap->user_nums) {
+        mac_vap->user_nums--;
+    }
+    /* STA模式下将关联的VAP的id置为非法值 */
+    if (mac_vap->vap_mode == WLAN_VAP_MODE_BSS_STA) {
+        mac_vap_set_assoc_id(mac_vap, 0xff);
+    }
+    return HI_SUCCESS;
 }
 
 /* ****************************************************************************
@@ -409,9 +424,9 @@ WIFI_ROM_TEXT hi_u32 mac_vap_find_user_by_macaddr(mac_vap_stru *mac_vap, const h
     hi_u8 *puc_user_idx)
 {
     mac_user_stru              *mac_user = HI_NULL;
-    hi_u32                      user_hash_value;
-    mac_res_user_hash_stru     *hash = HI_NULL;
-    hi_list                    *entry = HI_NULL;
+    hi_u64                      ull_key;
+    hi_u32                      slot;
+    hi_u32                      loop;
     unsigned long               irq_save;
 
     if (mac_vap->vap_mode == WLAN_VAP_MODE_BSS_STA) {
@@ -426,40 +441,29 @@ WIFI_ROM_TEXT hi_u32 mac_vap_find_user_by_macaddr(mac_vap_stru *mac_vap, const h
         return HI_FAIL;
     }
 
+    ull_key = mac_addr_to_key(sta_mac_addr);
+
     oal_spin_lock_irq_save(&mac_vap->cache_user_lock, &irq_save);
 
     /* 与cache user对比 , 相等则直接返回cache user id */
-    if (!oal_compare_mac_addr(mac_vap->auc_cache_user_mac_addr, sta_mac_addr, mac_addr_len)) {
+    if (ull_key == mac_vap->ull_cache_user_key) {
         *puc_user_idx = mac_vap->cache_user_id;
         oal_spin_unlock_irq_restore(&mac_vap->cache_user_lock, &irq_save);
         return (hi_u32)((*puc_user_idx != MAC_INVALID_USER_ID) ? HI_SUCCESS : HI_FAIL);
     }
 
-    user_hash_value = mac_calculate_hash_value(sta_mac_addr);
-    hi_list_for_each(entry, &(mac_vap->ast_user_hash[user_hash_value])) {
-        hash = (mac_res_user_hash_stru *)entry;
-
-        mac_user = mac_user_get_user_stru(hash->user_idx);
-        if (mac_user == HI_NULL) {
-            oam_error_log1(mac_vap->vap_id, OAM_SF_ANY,
-                           "{mac_vap_find_user_by_macaddr::pst_mac_user null.user idx %d}",
-                           hash->user_idx);
-            continue;
-        }
-
-        /* 相同的MAC地址 */
-        if (!oal_compare_mac_addr(mac_user->user_mac_addr, sta_mac_addr, mac_addr_len)) {
-            *puc_user_idx = hash->user_idx;
+    /* 线性探测，遇到空槽即可确定用户不存在 */
+    slot = mac_calculate_hash_value(ull_key);
+    for (loop = 0; (loop < MAC_VAP_USER_HASH_MAX_VALUE) && (mac_vap->aull_user_hash_key[slot] != 0); loop++) {
+        if (mac_vap->aull_user_hash_key[slot] == ull_key) {
+            *puc_user_idx = mac_vap->auc_user_hash_idx[slot];
             /* 更新cache user */
-            if (memcpy_s(mac_vap->auc_cache_user_mac_addr, WLAN_MAC_ADDR_LEN, mac_user->user_mac_addr,
-                WLAN_MAC_ADDR_LEN) != EOK) {
-                oam_error_log0(0, 0, "{mac_vap_find_user_by_macaddr::mem safe func err!}");
-                continue;
-            }
-            mac_vap->cache_user_id = (hi_u8)hash->user_idx;
+            mac_vap->ull_cache_user_key = ull_key;
+            mac_vap->cache_user_id = *puc_user_idx;
             oal_spin_unlock_irq_restore(&mac_vap->cache_user_lock, &irq_save);
             return (hi_u32)((*puc_user_idx != MAC_INVALID_USER_ID) ? HI_SUCCESS : HI_FAIL);
         }
+        slot = (slot + 1) & (MAC_VAP_USER_HASH_MAX_VALUE - 1);
     }
     oal_spin_unlock_irq_restore(&mac_vap->cache_user_lock, &irq_save);
 
@@ -1269,8 +1273,9 @@ WIFI_ROM_TEXT hi_u32 mac_vap_init(mac_vap_stru *mac_vap, hi_u8 vap_id, const mac
     mac_vap->cap_flag.disable_2ght40 = HI_TRUE;
     mac_vap->ch_switch_info.new_bandwidth = WLAN_BAND_WIDTH_BUTT;
 
+    mac_vap->cache_user_id = MAC_INVALID_USER_ID;
     for (loop = 0; loop < MAC_VAP_USER_HASH_MAX_VALUE; loop++) {
-        hi_list_init(&(mac_vap->ast_user_hash[loop]));
+        mac_vap->auc_user_hash_idx[loop] = MAC_INVALID_USER_ID;
     }
     hi_list_init(&mac_vap->mac_user_list_head);
 
@@ -79,10 +79,17 @@ extern "C" {
 #define MAC_MESH_DEFAULT_ID                 255       /* Mesh MBR节点默认ID号，分配默认id进行tbtt计算后的值 */
 #define MAC_MESH_MAX_MBR_NUM                5         /* MBR节点最大数目 */
 
-#define MAC_VAP_USER_HASH_MAX_VALUE         4         /* 31H最大支持8个用户 数量少HASH桶缩减1倍 */
-/* HASH计算取MAC最后两个相加 降低复杂度 */
-#define mac_calculate_hash_value(_puc_mac_addr) \
-    (((_puc_mac_addr)[4] + (_puc_mac_addr)[5]) & (MAC_VAP_USER_HASH_MAX_VALUE - 1))
+#define MAC_VAP_USER_HASH_BITS              4
+/* 开放寻址哈希表槽位数，31H最大支持8个用户，槽位取2倍保证探测链短 */
+#define MAC_VAP_USER_HASH_MAX_VALUE         (1 << MAC_VAP_USER_HASH_BITS)
+/* MAC地址转换为64位键值，比较一次即可判断地址相同，全0地址作为空槽标记 */
+#define mac_addr_to_key(_puc_mac_addr) \
+    (((hi_u64)(_puc_mac_addr)[0] << 40) | ((hi_u64)(_puc_mac_addr)[1] << 32) | \
+    ((hi_u64)(_puc_mac_addr)[2] << 24) | ((hi_u64)(_puc_mac_addr)[3] << 16) | \
+    ((hi_u64)(_puc_mac_addr)[4] << 8) | (hi_u64)(_puc_mac_addr)[5])
+/* 高低32位折叠后乘法散列取高位，同厂商OUI的地址也能均匀分布 */
+#define mac_calculate_hash_value(_ull_key) \
+    (((((hi_u32)(_ull_key)) ^ ((hi_u32)((_ull_key) >> 32))) * 0x9E3779B1U) >> (32 - MAC_VAP_USER_HASH_BITS))
 
 #define is_ap(_pst_mac_vap)  ((WLAN_VAP_MODE_BSS_AP  == (_pst_mac_vap)->vap_mode) || \
     ((_pst_mac_vap)->vap_mode == WLAN_VAP_MODE_MESH))
@@ -810,13 +817,14 @@ typedef struct {
 
     hi_u8                           is_mbr;                   /* 标识是否是MBR节点(true:MBR,false:MR) */
     hi_u8                           vap_rx_nss;
-    hi_u8                           auc_cache_user_mac_addr[WLAN_MAC_ADDR_LEN];     /* cache user对应的MAC地址 */
 
     /* VAP为STA模式时保存AP分配给STA的AID(从响应帧获取),取值范围1~2007; VAP为AP模式时，不用此成员变量 */
     hi_u16                          us_sta_aid;
     hi_u16                          us_assoc_user_cap_info;                         /* sta要关联的用户的能力信息 */
 
-    hi_list                             ast_user_hash[MAC_VAP_USER_HASH_MAX_VALUE]; /* hash数组,使用HASH结构内的DLIST */
+    hi_u64                              ull_cache_user_key;          /* cache user对应的MAC地址键值 */
+    hi_u64                              aull_user_hash_key[MAC_VAP_USER_HASH_MAX_VALUE]; /* 用户哈希表键值,0为空槽 */
+    hi_u8                               auc_user_hash_idx[MAC_VAP_USER_HASH_MAX_VALUE];  /* 哈希槽对应的用户索引 */
     hi_list                             mac_user_list_head;          /* 关联用户节点双向链表,使用USER结构内的DLIST */
     mac_cap_flag_stru                   cap_flag;                    /* vap能力特性标识 */
     wlan_mib_ieee802dot11_stru         *mib_info;        /* mib信息(当时配置vap时，可以直接将指针值为NULL，节省空间)  */
@@ -255,6 +255,7 @@ hi_u32 hmac_config_11i_add_key(mac_vap_stru *mac_vap, hi_u16 us_len, const hi_u8
     }
     /* 设置用户8021x端口合法性的状态为合法 */
     hmac_user->base_user->port_valid = HI_TRUE;
+    hmac_user_invalidate_tx_hdr_template(hmac_user);
 
     /* **************************************************************************
     抛事件到DMAC层, 同步DMAC数据
@@ -39,6 +39,10 @@
 #include "hmac_sme_sta.h"
 #include "hmac_blockack.h"
 #include "hmac_p2p.h"
+#include "net_adpater.h"
+#ifdef _PRE_WLAN_FEATURE_M2U
+#include "hmac_m2u.h"
+#endif
 
 #ifdef __cplusplus
 #if __cplusplus
@@ -4739,6 +4743,8 @@ hi_u32 hmac_config_set_edca_opt_switch_ap(mac_vap_stru *mac_vap, hi_u16 us_len,
     /* 设置参数，并启动或者停止edca参数调整定时器 */
     if (flag == 1) {
         hmac_vap->edca_opt_flag_ap = 1;
+        /* 重新使能后首个周期必须同步一次统计结果 */
+        hmac_vap->edca_opt_traffic_synced = HI_FALSE;
         frw_timer_restart_timer(&(hmac_vap->edca_opt_timer), hmac_vap->us_edca_opt_time_ms, HI_TRUE);
     } else {
         hmac_vap->edca_opt_flag_ap = 0;
@@ -4796,6 +4802,44 @@ hi_u32 hmac_config_set_edca_opt_cycle_ap(mac_vap_stru *mac_vap, hi_u16 us_len, c
 
 #endif
 
+#if defined(_PRE_WLAN_FEATURE_M2U) && defined(_PRE_WLAN_FEATURE_HIPRIV)
+/* ****************************************************************************
+ 功能描述  : 设置组播侦听及转单播开关、转单播成员数门限
+ 返 回 值  : 错误码
+**************************************************************************** */
+hi_u32 hmac_config_m2u_snoop_on(mac_vap_stru *mac_vap, hi_u16 us_len, const hi_u8 *puc_param)
+{
+    hi_unref_param(us_len);
+
+    hmac_vap_stru *hmac_vap = hmac_vap_get_vap_stru(mac_vap->vap_id);
+    if (hmac_vap == HI_NULL) {
+        oam_warning_log1(0, OAM_SF_M2U, "hmac_config_m2u_snoop_on, hmac_vap_get_vap_stru fail.vap_id = %u",
+            mac_vap->vap_id);
+        return HI_ERR_CODE_PTR_NULL;
+    }
+
+    if (mac_vap->vap_mode != WLAN_VAP_MODE_BSS_AP) {
+        oam_warning_log1(mac_vap->vap_id, OAM_SF_M2U, "{hmac_config_m2u_snoop_on::not ap mode[%d].}",
+            mac_vap->vap_mode);
+        return HI_ERR_CODE_CONFIG_UNSUPPORT;
+    }
+
+    const mac_cfg_m2u_snoop_on_param_stru *m2u_param = (const mac_cfg_m2u_snoop_on_param_stru *)puc_param;
+    if ((m2u_param->max_member == 0) || (m2u_param->max_member > HMAC_M2U_MEMBER_MAX_NUM)) {
+        oam_warning_log1(mac_vap->vap_id, OAM_SF_M2U, "{hmac_config_m2u_snoop_on::max_member[%d] invalid.}",
+            m2u_param->max_member);
+        return HI_ERR_CODE_INVALID_CONFIG;
+    }
+
+    hmac_m2u_set_snoop(hmac_vap, m2u_param->m2u_snoop_on, m2u_param->max_member);
+
+    oam_warning_log2(mac_vap->vap_id, OAM_SF_M2U, "{hmac_config_m2u_snoop_on::snoop_on=%d, max_member=%d.}",
+        hmac_vap->m2u.snoop_on, hmac_vap->m2u.max_member);
+
+    return HI_SUCCESS;
+}
+#endif
+
 #ifdef _PRE_WLAN_FEATURE_STA_PM
 /* ****************************************************************************
  功能描述  : 120S低功耗定时器超时处理函数
@@ -5230,7 +5274,13 @@ hi_u32 hmac_init_user_security_port(const mac_vap_stru *mac_vap, mac_user_stru *
 hi_u32 hmac_user_set_asoc_state(const mac_vap_stru *mac_vap, mac_user_stru *mac_user,
     mac_user_asoc_state_enum_uint8 value)
 {
+    hmac_user_stru *hmac_user = (hmac_user_stru *)hmac_user_get_user_stru((hi_u8)mac_user->us_assoc_id);
+
     mac_user_set_asoc_state(mac_user, value);
+    /* 关联状态变化后用户能力可能改变，发送帧头模板需重新生成 */
+    if (hmac_user != HI_NULL) {
+        hmac_user_invalidate_tx_hdr_template(hmac_user);
+    }
 #if (_PRE_MULTI_CORE_MODE_OFFLOAD_DMAC == _PRE_MULTI_CORE_MODE)
     /* dmac offload架构下，同步user关联状态信息到dmac */
     hi_u32 ret = hmac_config_user_asoc_state_syn(mac_vap, mac_user);
@@ -5349,6 +5399,7 @@ oal_net_dev_tx_enum hmac_vap_start_xmit(oal_netbuf_stru *netbuf, oal_net_device_
     netbuf = oal_netbuf_unshare(netbuf);
     if (netbuf == HI_NULL) {
         oam_error_log0(0, OAM_SF_TX, "{wal_vap_start_xmit::the unshare netbuf = HI_NULL!}\r\n");
+        wal_netdev_stats_tx_drop(mac_vap->vap_id, WAL_NETDEV_DROP_NOMEM);
         return OAL_NETDEV_TX_OK;
     }
 
@@ -5374,9 +5425,11 @@ oal_net_dev_tx_enum hmac_vap_start_xmit(oal_netbuf_stru *netbuf, oal_net_device_
                 OAL_NETBUF_QUEUE_TAIL(&(hmac_vap->tx_queue_head[hmac_vap->in_queue_id]), netbuf);
                 hi_task_unlock();
             } else {
+                wal_netdev_stats_tx_drop(mac_vap->vap_id, WAL_NETDEV_DROP_FLOWCTL);
                 oal_netbuf_free(netbuf);
             }
         } else {
+            wal_netdev_stats_tx_drop(mac_vap->vap_id, WAL_NETDEV_DROP_FLOWCTL);
             oal_netbuf_free(netbuf);
         }
 
@@ -5468,12 +5521,14 @@ oal_net_dev_tx_enum hmac_bridge_vap_xmit(oal_net_device_stru *netdev, oal_netbuf
 #endif
     if (oal_unlikely(netbuf == HI_NULL)) {
         oam_warning_log0(mac_vap->vap_id, OAM_SF_TX, "{hmac_bridge_vap_xmit::the unshare netbuf = HI_NULL!}");
+        wal_netdev_stats_tx_drop(mac_vap->vap_id, WAL_NETDEV_DROP_NOMEM);
         return OAL_NETDEV_TX_OK;
     }
 
 #ifdef _PRE_WLAN_FEATURE_WOW
     /* wow 过滤开关 */
     if (HI_TRUE == hmac_wow_tx_check_filter_switch()) {
+        wal_netdev_stats_tx_drop(mac_vap->vap_id, WAL_NETDEV_DROP_OTHER);
         oal_netbuf_free(netbuf);
         return OAL_NETDEV_TX_OK;
     }
@@ -5483,6 +5538,7 @@ oal_net_dev_tx_enum hmac_bridge_vap_xmit(oal_net_device_stru *netdev, oal_netbuf
     if (oal_unlikely(!((mac_vap->vap_state == MAC_VAP_STATE_UP) || (mac_vap->vap_state == MAC_VAP_STATE_PAUSE)))) {
         oam_info_log1(mac_vap->vap_id, OAM_SF_TX, "{hmac_bridge_vap_xmit::vap state[%d] != MAC_VAP_STATE_{UP|PAUSE}}",
             mac_vap->vap_state);
+        wal_netdev_stats_tx_drop(mac_vap->vap_id, WAL_NETDEV_DROP_VAP_DOWN);
         oal_netbuf_free(netbuf);
         return OAL_NETDEV_TX_OK;
     }
@@ -5511,9 +5567,10 @@ oal_net_dev_tx_enum hmac_bridge_vap_xmit(oal_net_device_stru *netdev, oal_netbuf
     }
 #endif
 
-    oal_net_dev_tx_enum ret_value = (hmac_tx_lan_to_wlan(mac_vap, netbuf) != HI_SUCCESS) ?
-        OAL_NETDEV_TX_BUSY : OAL_NETDEV_TX_OK;
-    if (oal_unlikely(ret_value != OAL_NETDEV_TX_OK)) {
+    hi_u32 ret = hmac_tx_lan_to_wlan(mac_vap, netbuf);
+    if (oal_unlikely(ret != HI_SUCCESS)) {
+        wal_netdev_stats_tx_drop(mac_vap->vap_id, (ret == HI_ERR_CODE_ALLOC_MEM_FAIL) ?
+            WAL_NETDEV_DROP_NOMEM : WAL_NETDEV_DROP_OTHER);
         hmac_free_netbuf_list(netbuf);
     }
 
@@ -5649,27 +5706,23 @@ hi_u32 hmac_btcoex_delba_foreach_user(mac_vap_stru *mac_vap)
     hi_u32 ret = 0;
     mac_cfg_delba_req_param_stru mac_cfg_delba_param;
     mac_user_stru *mac_user = HI_NULL;
-    hi_u8 user_idx;
-    hi_list *entry = HI_NULL;
-    mac_res_user_hash_stru *res_hash = HI_NULL;
+    hi_u8 slot;
 
     mac_cfg_delba_param.direction = MAC_RECIPIENT_DELBA;
 
-    for (user_idx = 0; user_idx < MAC_VAP_USER_HASH_MAX_VALUE; user_idx++) {
-        hi_list_for_each(entry, &(mac_vap->ast_user_hash[user_idx])) {
-            res_hash = (mac_res_user_hash_stru *)entry;
-
-            mac_user = mac_user_get_user_stru(res_hash->user_idx);
-            if (mac_user == HI_NULL) {
-                oam_warning_log1(mac_vap->vap_id, OAM_SF_COEX,
-                    "{hmac_btcoex_delba_foreach_user::pst_mac_user null, user_idx: %d.}", res_hash->user_idx);
-                entry = res_hash->entry.next;
-                continue;
-            }
-            ret = hmac_btcoex_delba_foreach_tid(mac_vap, mac_user, &mac_cfg_delba_param);
-            if (ret != HI_SUCCESS) {
-                return ret;
-            }
+    for (slot = 0; slot < MAC_VAP_USER_HASH_MAX_VALUE; slot++) {
+        if (mac_vap->aull_user_hash_key[slot] == 0) {
+            continue;
+        }
+        mac_user = mac_user_get_user_stru(mac_vap->auc_user_hash_idx[slot]);
+        if (mac_user == HI_NULL) {
+            oam_warning_log1(mac_vap->vap_id, OAM_SF_COEX,
+                "{hmac_btcoex_delba_foreach_user::pst_mac_user null, user_idx: %d.}", mac_vap->auc_user_hash_idx[slot]);
+            continue;
+        }
+        ret = hmac_btcoex_delba_foreach_tid(mac_vap, mac_user, &mac_cfg_delba_param);
+        if (ret != HI_SUCCESS) {
+            return ret;
         }
     }
 
@@ -6679,6 +6732,7 @@ hi_u32 hmac_config_set_mesh_user(mac_vap_stru *mac_vap, hi_u16 us_len, const hi_
             hmac_user->base_user->mesh_initiative_role = set_mesh->mesh_initiative_peering;
             /* Mesh下ESTAB状态即为关联成功 */
             mac_user_set_asoc_state(hmac_user->base_user, MAC_USER_STATE_ASSOC);
+            hmac_user_invalidate_tx_hdr_template(hmac_user);
             /* 通知算法 */
             hmac_user_add_notify_alg(mac_vap, user_index);
 
@@ -240,6 +240,9 @@ hi_u32 hmac_config_set_edca_opt_switch_sta(mac_vap_stru *mac_vap, hi_u16 us_len,
 hi_u32 hmac_config_set_edca_opt_switch_ap(mac_vap_stru *mac_vap, hi_u16 us_len, const hi_u8 *puc_param);
 #endif
 hi_u32 hmac_config_set_edca_opt_cycle_ap(mac_vap_stru *mac_vap, hi_u16 us_len, const hi_u8 *puc_param);
+#if defined(_PRE_WLAN_FEATURE_M2U) && defined(_PRE_WLAN_FEATURE_HIPRIV)
+hi_u32 hmac_config_m2u_snoop_on(mac_vap_stru *mac_vap, hi_u16 us_len, const hi_u8 *puc_param);
+#endif
 
 hi_u32 hmac_config_set_wps_ie(mac_vap_stru *mac_vap, hi_u16 us_len, hi_u8 *puc_param);
 
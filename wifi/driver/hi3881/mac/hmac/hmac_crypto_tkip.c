@@ -117,8 +117,52 @@ addrerr:
     return;
 }
 
+/* ****************************************************************************
+ 功能描述  : 对连续内存中的word_num个32位小端字执行Michael运算
+             小端CPU且4字节对齐时直接按字读取并4路展开，否则按字节拼接
+**************************************************************************** */
+static hi_void hmac_crypto_tkip_michael_words(hi_u32 *pul_l, hi_u32 *pul_r, const hi_u8 *puc_data, hi_u32 word_num)
+{
+    hi_u32 l = *pul_l;
+    hi_u32 r = *pul_r;
+
+#if (_PRE_LITTLE_CPU_ENDIAN == _PRE_CPU_ENDIAN)
+    if (((uintptr_t)puc_data & (sizeof(hi_u32) - 1)) == 0) {
+        const hi_u32 *pul_data = (const hi_u32 *)puc_data;
+
+        for (; word_num >= 4; word_num -= 4) { /* 4 每轮展开处理4个字 */
+            l ^= pul_data[0];
+            michael_block(l, r);
+            l ^= pul_data[1];
+            michael_block(l, r);
+            l ^= pul_data[2]; /* 2 数组索引 */
+            michael_block(l, r);
+            l ^= pul_data[3]; /* 3 数组索引 */
+            michael_block(l, r);
+            pul_data += 4;    /* 4 每轮展开处理4个字 */
+        }
+        for (; word_num > 0; word_num--) {
+            l ^= *pul_data++;
+            michael_block(l, r);
+        }
+        *pul_l = l;
+        *pul_r = r;
+        return;
+    }
+#endif
+
+    for (; word_num > 0; word_num--) {
+        l ^= get_le32(puc_data, 4); /* 4 一次计算长度 */
+        michael_block(l, r);
+        puc_data += sizeof(hi_u32);
+    }
+    *pul_l = l;
+    *pul_r = r;
+}
+
 /* ****************************************************************************
  功能描述  : 生成mic校验码
+             每个netbuf内的连续数据按字批量处理，只有跨netbuf的不足4字节部分经过暂存区拼接
  输入参数  : key 密钥(8byte)
  返 回 值  : 0:成功,其他:失败
  修改历史      :
@@ -126,12 +170,12 @@ addrerr:
     作    者   : HiSilicon
     修改内容   : 新生成函数
 **************************************************************************** */
-/* 规则5.1 避免函数过长，函数不超过50行（非空非注释），申请例外: 算法函数，功能内聚，建议屏蔽 */
 static hi_u32 hmac_crypto_tkip_michael_mic(const hi_u8 *puc_key, const oal_netbuf_stru *netbuf,
     mac_ieee80211_frame_stru *frame_header, const hmac_michael_mic_info_stru *michael_mic_info)
 {
     hi_u8  auc_hdr[AUC_HDR_SIZE] = {0};
-    hi_u32 offset = michael_mic_info->offset;
+    hi_u8  auc_carry[sizeof(hi_u32)] = {0}; /* 跨netbuf的不足4字节数据暂存区 */
+    hi_u32 carry_len = 0;
     hi_u32 data_len = michael_mic_info->data_len;
 
     hmac_crypto_tkip_michael_hdr(frame_header, auc_hdr, AUC_HDR_SIZE);
@@ -140,33 +184,36 @@ static hi_u32 hmac_crypto_tkip_michael_mic(const hi_u8 *puc_key, const oal_netbu
     hi_u32 lsb = get_le32(puc_key + 4, 4); /* 4 偏移量 */
 
     /* Michael MIC pseudo header: DA, SA, 3 x 0, Priority */
-    msb ^= get_le32(auc_hdr, 4); /* 4 一次计算长度 */
-    michael_block(msb, lsb);
-    msb ^= get_le32(&auc_hdr[4], 4); /* 4 元素索引 */
-    michael_block(msb, lsb);
-    msb ^= get_le32(&auc_hdr[8], 4); /* 8 元素索引, 4 一次计算长度 */
-    michael_block(msb, lsb);
-    msb ^= get_le32(&auc_hdr[12], 4); /* 12 元素索引, 4 一次计算长度 */
-    michael_block(msb, lsb);
+    hmac_crypto_tkip_michael_words(&msb, &lsb, auc_hdr, AUC_HDR_SIZE / sizeof(hi_u32));
 
     /* first buffer has special handling */
-    const hi_u8 *puc_data = oal_netbuf_data(netbuf) + offset;
-    hi_u32 space = oal_netbuf_len(netbuf) - offset;
+    const hi_u8 *puc_data = oal_netbuf_data(netbuf) + michael_mic_info->offset;
+    hi_u32 space = oal_netbuf_len(netbuf) - michael_mic_info->offset;
 
     for (;;) {
         space = (space > data_len) ? data_len : space;
+        data_len -= space;
 
-        /* collect 32-bit blocks from current buffer */
-        while (space >= sizeof(hi_u32)) {
-            msb ^= get_le32(puc_data, 4); /* 4 一次计算长度 */
-            michael_block(msb, lsb);
+        /* 先用本netbuf头部数据补齐上一个netbuf遗留的不完整字 */
+        while ((carry_len != 0) && (carry_len < sizeof(hi_u32)) && (space != 0)) {
+            auc_carry[carry_len++] = *puc_data++;
+            space--;
+        }
+        if (carry_len == sizeof(hi_u32)) {
+            hmac_crypto_tkip_michael_words(&msb, &lsb, auc_carry, 1);
+            carry_len = 0;
+        }
 
-            puc_data += sizeof(hi_u32);
-            space    -= sizeof(hi_u32);
-            data_len -= sizeof(hi_u32);
+        /* collect 32-bit blocks from current buffer */
+        hmac_crypto_tkip_michael_words(&msb, &lsb, puc_data, space / sizeof(hi_u32));
+        puc_data += space & ~(sizeof(hi_u32) - 1);
+        space &= (sizeof(hi_u32) - 1);
+        while (space != 0) {
+            auc_carry[carry_len++] = *puc_data++;
+            space--;
         }
 
-        if (data_len < sizeof(hi_u32)) {
+        if (data_len == 0) {
             break;
         }
 
@@ -174,53 +221,16 @@ static hi_u32 hmac_crypto_tkip_michael_mic(const hi_u8 *puc_key, const oal_netbu
         if (netbuf == NULL) {
             return HI_ERR_CODE_SECURITY_BUFF_NUM;
         }
-
-        if (space != 0) {
-            /*
-             * Block straddles buffers, split references.
-             */
-            const hi_u8 *puc_data_next = oal_netbuf_data(netbuf);
-            if ((sizeof(hi_u32) - space) > oal_netbuf_len(netbuf)) {
-                return HI_ERR_CODE_SECURITY_BUFF_LEN;
-            }
-
-            if (space == 1) {
-                msb ^= get_le32_split(puc_data[0], puc_data_next[0], puc_data_next[1], puc_data_next[2]); /* 2 */
-                puc_data = puc_data_next + 3;       /* 3 用于计算 */
-                space = oal_netbuf_len(netbuf) - 3; /* 3 用于计算 */
-            } else if (space == 2) {                /* 2 case 标志 */
-                msb ^= get_le32_split(puc_data[0], puc_data[1], puc_data_next[0], puc_data_next[1]);
-                puc_data = puc_data_next + 2;                                                   /* 2 用于计算 */
-                space = oal_netbuf_len(netbuf) - 2;                                             /* 2 用于计算 */
-            } else if (space == 3) {                                                            /* 3 case 标志 */
-                msb ^= get_le32_split(puc_data[0], puc_data[1], puc_data[2], puc_data_next[0]); /* 2 元素索引 */
-                puc_data = puc_data_next + 1;
-                space = oal_netbuf_len(netbuf) - 1;
-            }
-
-            michael_block(msb, lsb);
-            data_len -= sizeof(hi_u32);
-        } else {
-            /*
-             * Setup for next buffer.
-             */
-            puc_data = oal_netbuf_data(netbuf);
-            space = oal_netbuf_len(netbuf);
-        }
+        puc_data = oal_netbuf_data(netbuf);
+        space = oal_netbuf_len(netbuf);
     }
 
     /* Last block and padding (0x5a, 4..7 x 0) */
-    if (data_len == 0) {
-        msb ^= get_le32_split(0x5a, 0, 0, 0);
-    } else if (data_len == 1) {
-        msb ^= get_le32_split(puc_data[0], 0x5a, 0, 0);
-    } else if (data_len == 2) { /* 2 case 标志 */
-        msb ^= get_le32_split(puc_data[0], puc_data[1], 0x5a, 0);
-    } else if (data_len == 3) {                                             /* 3 case 标志 */
-        msb ^= get_le32_split(puc_data[0], puc_data[1], puc_data[2], 0x5a); /* 2 数组索引 */
+    auc_carry[carry_len++] = 0x5a;
+    while (carry_len < sizeof(hi_u32)) {
+        auc_carry[carry_len++] = 0;
     }
-
-    michael_block(msb, lsb);
+    hmac_crypto_tkip_michael_words(&msb, &lsb, auc_carry, 1);
     /* l ^= 0; */
     michael_block(msb, lsb);
 
@@ -37,19 +37,27 @@ extern "C" {
 /* ****************************************************************************
   2 宏定义
 **************************************************************************** */
+#define HMAC_SCAN_BSS_HASH_NUM  32  /* 扫描结果按BSSID散列的桶个数，须为2的幂 */
+/* 同一厂商的BSSID前3字节相同，取后3字节异或 */
+#define hmac_scan_bss_hash_value(_puc_bssid) \
+    (((_puc_bssid)[3] ^ (_puc_bssid)[4] ^ (_puc_bssid)[5]) & (HMAC_SCAN_BSS_HASH_NUM - 1))
+
 /* ****************************************************************************
   7 STRUCT定义
 **************************************************************************** */
 /* 存储每个扫描到的bss信息 */
 typedef struct {
-    hi_list                dlist_head;        /* 链表指针 */
+    hi_list                dlist_head;        /* 链表指针，按更新时间先后挂在bss_list_head上 */
+    hi_list                hash_dlist;        /* 按BSSID散列的桶链表指针 */
+    hi_u32                 beacon_fp;         /* 帧体指纹(不含时间戳和TIM)，仅由beacon更新的节点有效 */
     mac_bss_dscr_stru      bss_dscr_info;    /* bss描述信息，包括上报的管理帧 */
 } hmac_scanned_bss_info;
 
 /* 存储在hmac device下的扫描结果维护的结构体 */
 typedef struct {
     oal_spin_lock_stru  st_lock;
-    hi_list             bss_list_head;
+    hi_list             bss_list_head;                          /* 表头最旧、表尾最新，老化从表头开始 */
+    hi_list             ast_bss_hash[HMAC_SCAN_BSS_HASH_NUM];   /* BSSID散列索引 */
     hi_u32              bss_num;
 } hmac_bss_mgmt_stru;
 
@@ -85,6 +93,8 @@ typedef struct {
     mac_channel_stru                       p2p_listen_channel;
     /* 记录请求信道列表的map,11b模式下收到非当前信道扫描帧过滤使用,5g管理帧不使用11b速率 */
     hi_u32                                 scan_2g_ch_list_map;
+    hi_u32                                 beacon_dedup_hit;        /* 指纹命中、跳过IE解析的beacon数 */
+    hi_u32                                 beacon_dedup_miss;       /* 指纹未命中、完整解析的beacon数 */
 } hmac_scan_stru;
 
 typedef struct {
@@ -48,6 +48,26 @@ static hi_void hmac_edca_opt_stat_traffic_num(const hmac_vap_stru *hmac_vap,
 /* ****************************************************************************
   5 函数实现
 **************************************************************************** */
+/* ****************************************************************************
+ 功能描述  : 带滞回判断一条业务流是否活跃: 超过门限置为活跃，低于门限一半才恢复为不活跃，
+             避免报文数在门限附近波动时edca参数来回切换
+**************************************************************************** */
+static hi_u8 hmac_edca_opt_update_active(hmac_user_stru *hmac_user, hi_u8 ac_idx, hi_u8 data_type, hi_u32 threshold)
+{
+    hi_u16 bit_mask = (hi_u16)bit(ac_idx * WLAN_TXRX_DATA_BUTT + data_type);
+    hi_u32 pkt_num = hmac_user->txrx_data_stat[ac_idx][data_type];
+
+    if (pkt_num > threshold) {
+        hmac_user->us_edca_opt_active_bmap |= bit_mask;
+    } else if (pkt_num <= (threshold >> 1)) {
+        hmac_user->us_edca_opt_active_bmap &= (hi_u16)(~bit_mask);
+    }
+    /* 统计完毕置0 */
+    hmac_user->txrx_data_stat[ac_idx][data_type] = 0;
+
+    return ((hmac_user->us_edca_opt_active_bmap & bit_mask) != 0) ? HI_TRUE : HI_FALSE;
+}
+
 /* ****************************************************************************
  功能描述  : edca调整统计上/下行，TCP/UDP流数目
  修改历史      :
@@ -61,8 +81,10 @@ static hi_void hmac_edca_opt_stat_traffic_num(const hmac_vap_stru *hmac_vap,
     mac_user_stru *user = HI_NULL;
     hmac_user_stru *hmac_user = HI_NULL;
     hi_u8 ac_idx;
+    hi_u8 data_type;
     mac_vap_stru *mac_vap = hmac_vap->base_vap;
     hi_list *list_pos = HI_NULL;
+    hi_u32 threshold = hmac_edca_opt_pkt_threshold(hmac_vap->us_edca_opt_time_ms);
 
     list_pos = mac_vap->mac_user_list_head.next;
 
@@ -74,24 +96,10 @@ static hi_void hmac_edca_opt_stat_traffic_num(const hmac_vap_stru *hmac_vap,
         }
 
         for (ac_idx = 0; ac_idx < WLAN_WME_AC_BUTT; ac_idx++) {
-            /* 遍历所有的数据类型 嵌套超4层整改删除for循环 */
-            if (hmac_user->txrx_data_stat[ac_idx][WLAN_TX_TCP_DATA] > HMAC_EDCA_OPT_PKT_NUM) {
-                ppuc_traffic_num[ac_idx][WLAN_TX_TCP_DATA]++;
-            }
-            if (hmac_user->txrx_data_stat[ac_idx][WLAN_RX_TCP_DATA] > HMAC_EDCA_OPT_PKT_NUM) {
-                ppuc_traffic_num[ac_idx][WLAN_RX_TCP_DATA]++;
+            for (data_type = 0; data_type < WLAN_TXRX_DATA_BUTT; data_type++) {
+                ppuc_traffic_num[ac_idx][data_type] +=
+                    hmac_edca_opt_update_active(hmac_user, ac_idx, data_type, threshold);
             }
-            if (hmac_user->txrx_data_stat[ac_idx][WLAN_TX_UDP_DATA] > HMAC_EDCA_OPT_PKT_NUM) {
-                ppuc_traffic_num[ac_idx][WLAN_TX_UDP_DATA]++;
-            }
-            if (hmac_user->txrx_data_stat[ac_idx][WLAN_RX_UDP_DATA] > HMAC_EDCA_OPT_PKT_NUM) {
-                ppuc_traffic_num[ac_idx][WLAN_RX_UDP_DATA]++;
-            }
-            /* 统计完毕置0 */
-            hmac_user->txrx_data_stat[ac_idx][WLAN_TX_TCP_DATA] = 0;
-            hmac_user->txrx_data_stat[ac_idx][WLAN_RX_TCP_DATA] = 0;
-            hmac_user->txrx_data_stat[ac_idx][WLAN_TX_UDP_DATA] = 0;
-            hmac_user->txrx_data_stat[ac_idx][WLAN_RX_UDP_DATA] = 0;
         }
     }
 }
@@ -123,6 +131,15 @@ hi_u32 hmac_edca_opt_timeout_fn(hi_void *arg)
     /* 统计device下所有用户上/下行 TPC/UDP条数目 */
     hmac_edca_opt_stat_traffic_num(hmac_vap, aast_uc_traffic_num);
 
+    /* 业务流统计与上次同步结果一致时dmac侧选择的edca参数不会变化，不再抛事件，
+       但连续跳过HMAC_EDCA_OPT_MAX_SKIP_CNT个周期后仍同步一次 */
+    if ((hmac_vap->edca_opt_traffic_synced == HI_TRUE) &&
+        (hmac_vap->edca_opt_skip_cnt < HMAC_EDCA_OPT_MAX_SKIP_CNT) &&
+        (memcmp(hmac_vap->aauc_edca_opt_traffic, aast_uc_traffic_num, sizeof(aast_uc_traffic_num)) == 0)) {
+        hmac_vap->edca_opt_skip_cnt++;
+        return HI_SUCCESS;
+    }
+
     /* **************************************************************************
         抛事件到dmac模块,将统计信息报给dmac
     ************************************************************************** */
@@ -151,6 +168,13 @@ hi_u32 hmac_edca_opt_timeout_fn(hi_void *arg)
     hcc_hmac_tx_control_event(event_mem, sizeof(aast_uc_traffic_num));
     frw_event_free(event_mem);
 
+    /* 记录已同步的统计结果 */
+    if (memcpy_s(hmac_vap->aauc_edca_opt_traffic, sizeof(hmac_vap->aauc_edca_opt_traffic), aast_uc_traffic_num,
+        sizeof(aast_uc_traffic_num)) == EOK) {
+        hmac_vap->edca_opt_traffic_synced = HI_TRUE;
+        hmac_vap->edca_opt_skip_cnt = 0;
+    }
+
     return HI_SUCCESS;
 }
 
@@ -168,10 +192,15 @@ hi_void hmac_edca_opt_rx_pkts_stat(hmac_user_stru *hmac_user, hi_u8 tidno, const
         return;
     }
 
+    /* u16计数饱和，避免高速下行时计数翻转被误判为无业务 */
     if (ip->protocol == MAC_UDP_PROTOCAL) {
-        hmac_user->txrx_data_stat[wlan_wme_tid_to_ac(tidno)][WLAN_RX_UDP_DATA]++;
+        if (hmac_user->txrx_data_stat[wlan_wme_tid_to_ac(tidno)][WLAN_RX_UDP_DATA] < 0xFFFF) {
+            hmac_user->txrx_data_stat[wlan_wme_tid_to_ac(tidno)][WLAN_RX_UDP_DATA]++;
+        }
     } else if (ip->protocol == MAC_TCP_PROTOCAL) {
-        hmac_user->txrx_data_stat[wlan_wme_tid_to_ac(tidno)][WLAN_RX_TCP_DATA]++;
+        if (hmac_user->txrx_data_stat[wlan_wme_tid_to_ac(tidno)][WLAN_RX_TCP_DATA] < 0xFFFF) {
+            hmac_user->txrx_data_stat[wlan_wme_tid_to_ac(tidno)][WLAN_RX_TCP_DATA]++;
+        }
     }
 }
 
@@ -202,12 +231,15 @@ hi_void hmac_edca_opt_tx_pkts_stat(const hmac_tx_ctl_stru *tx_ctl, hi_u8 tidno,
         return;
     }
 
-    /* mips优化:解决开启业务统计性能差10M问题 */
+    /* mips优化:解决开启业务统计性能差10M问题，超过门限后不再计数 */
+    hi_u32 stat_max = hmac_edca_opt_pkt_threshold(hmac_vap->us_edca_opt_time_ms) + HMAC_EDCA_OPT_STAT_MARGIN;
+    if (stat_max > 0xFFFF) {
+        stat_max = 0xFFFF;
+    }
     if (((ip->protocol == MAC_UDP_PROTOCAL) &&
-        (hmac_user->txrx_data_stat[wlan_wme_tid_to_ac(tidno)][WLAN_TX_UDP_DATA] < (HMAC_EDCA_OPT_PKT_NUM + 10))) ||
-        ((ip->protocol == MAC_TCP_PROTOCAL) &&                                    /* 10：偏移位 */
-        (hmac_user->txrx_data_stat[wlan_wme_tid_to_ac(tidno)][WLAN_TX_TCP_DATA] < /* 10：偏移位 */
-        (HMAC_EDCA_OPT_PKT_NUM + 10)))) {
+        (hmac_user->txrx_data_stat[wlan_wme_tid_to_ac(tidno)][WLAN_TX_UDP_DATA] < stat_max)) ||
+        ((ip->protocol == MAC_TCP_PROTOCAL) &&
+        (hmac_user->txrx_data_stat[wlan_wme_tid_to_ac(tidno)][WLAN_TX_TCP_DATA] < stat_max))) {
         /* 过滤IP_LEN 小于 HMAC_EDCA_OPT_MIN_PKT_LEN的报文 */
         if (oal_net2host_short(ip->us_tot_len) < HMAC_EDCA_OPT_MIN_PKT_LEN) {
             return;
@@ -40,6 +40,10 @@ extern "C" {
 #define HMAC_EDCA_OPT_MIN_PKT_LEN       256                 /* 小于该长度的ip报文不被统计，排除chariot控制报文 */
 #define HMAC_EDCA_OPT_TIME_MS           30000               /* edca参数调整默认定时器 */
 #define HMAC_EDCA_OPT_PKT_NUM           ((HMAC_EDCA_OPT_TIME_MS) >> 3)  /* 平均每毫秒报文个数 */
+#define HMAC_EDCA_OPT_STAT_MARGIN       10                  /* 统计超过门限该余量后不再计数 */
+#define HMAC_EDCA_OPT_MAX_SKIP_CNT      4                   /* 统计未变化时最多连续跳过的同步周期数 */
+/* 业务流活跃门限与调整周期成正比，默认周期下等于HMAC_EDCA_OPT_PKT_NUM；低于门限一半才判为不活跃 */
+#define hmac_edca_opt_pkt_threshold(_us_cycle_ms)   ((hi_u32)(_us_cycle_ms) >> 3)
 #define WLAN_EDCA_OPT_MAX_WEIGHT_STA    3
 #define WLAN_EDCA_OPT_WEIGHT_STA        2
 
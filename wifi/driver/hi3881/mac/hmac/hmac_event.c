@@ -236,6 +236,9 @@ static const wal_wid_op_stru g_ast_board_wid_op[] = {
 #endif
     {WLAN_CFGID_EDCA_OPT_CYCLE_AP,    HI_FALSE,  {0},   HI_NULL,           hmac_config_set_edca_opt_cycle_ap},
 #endif
+#if defined(_PRE_WLAN_FEATURE_M2U) && defined(_PRE_WLAN_FEATURE_HIPRIV)
+    {WLAN_CFGID_M2U_SNOOP_ON,         HI_FALSE,  {0},   HI_NULL,           hmac_config_m2u_snoop_on},
+#endif
 
 #ifdef _PRE_WLAN_FEATURE_OFFLOAD_FLOWCTL
 #ifdef _PRE_WLAN_FEATURE_HIPRIV
@@ -690,8 +693,7 @@ hi_u32 wal_set_msg_response(hi_u32 request_address, hi_u8 rsp_toal_len, const hi
         }
     }
 
-    /* 唤醒WAL等待的进程 */
-    wal_cfg_msg_task_sched();
+    /* 等待该请求的WAL进程已在wal_set_msg_response_by_addr中单独唤醒 */
     return HI_SUCCESS;
 }
 
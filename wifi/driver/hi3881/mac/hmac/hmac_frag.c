@@ -173,7 +173,40 @@ hi_u32 hmac_frag_process_proc(const hmac_vap_stru *hmac_vap, const hmac_user_str
 }
 
 /* ****************************************************************************
- 功能描述  : 解分片超时处理
+ 功能描述  : 释放去分片上下文中缓存的分片并将上下文置为空闲
+**************************************************************************** */
+static hi_void hmac_defrag_ctx_free(hmac_defrag_ctx_stru *defrag_ctx)
+{
+    hi_u8 idx;
+
+    for (idx = 0; idx < defrag_ctx->frag_cnt; idx++) {
+        oal_netbuf_free(defrag_ctx->past_frag[idx]);
+    }
+    (hi_void)memset_s(defrag_ctx, sizeof(hmac_defrag_ctx_stru), 0, sizeof(hmac_defrag_ctx_stru));
+}
+
+/* ****************************************************************************
+ 功能描述  : 获取最早开始重组的活动上下文，没有活动上下文时返回空
+**************************************************************************** */
+static hmac_defrag_ctx_stru *hmac_defrag_ctx_oldest(hmac_user_stru *hmac_user, hi_u32 now_ms)
+{
+    hmac_defrag_ctx_stru *oldest = HI_NULL;
+    hi_u8 idx;
+
+    for (idx = 0; idx < HMAC_DEFRAG_CTX_NUM; idx++) {
+        hmac_defrag_ctx_stru *defrag_ctx = &hmac_user->ast_defrag_ctx[idx];
+        if (defrag_ctx->frag_cnt == 0) {
+            continue;
+        }
+        if ((oldest == HI_NULL) || ((now_ms - defrag_ctx->last_ms) > (now_ms - oldest->last_ms))) {
+            oldest = defrag_ctx;
+        }
+    }
+    return oldest;
+}
+
+/* ****************************************************************************
+ 功能描述  : 解分片超时处理，用户下所有重组上下文共用一个定时器
  修改历史      :
   1.日    期   : 2014年2月20日
     作    者   : HiSilicon
@@ -181,34 +214,101 @@ hi_u32 hmac_frag_process_proc(const hmac_vap_stru *hmac_vap, const hmac_user_str
 **************************************************************************** */
 hi_u32 hmac_defrag_timeout_fn(hi_void *arg)
 {
-    hmac_user_stru *hmac_user = HI_NULL;
-    oal_netbuf_stru *netbuf = HI_NULL;
-    hmac_user = (hmac_user_stru *)arg;
+    hmac_user_stru *hmac_user = (hmac_user_stru *)arg;
+    hmac_defrag_ctx_stru *oldest = HI_NULL;
+    hi_u32 now_ms = (hi_u32)hi_get_milli_seconds();
+    hi_u8 idx;
 
     /* 超时后释放正在重组的分片报文 */
-    if (hmac_user->defrag_netbuf != HI_NULL) {
-        netbuf = hmac_user->defrag_netbuf;
-
-        oal_netbuf_free(netbuf);
-        hmac_user->defrag_netbuf = HI_NULL;
+    for (idx = 0; idx < HMAC_DEFRAG_CTX_NUM; idx++) {
+        hmac_defrag_ctx_stru *defrag_ctx = &hmac_user->ast_defrag_ctx[idx];
+        if ((defrag_ctx->frag_cnt != 0) && ((now_ms - defrag_ctx->last_ms) >= HMAC_FRAG_TIMEOUT)) {
+            oam_info_log3(hmac_user->base_user->vap_id, OAM_SF_ANY,
+                "{hmac_defrag_timeout_fn::tid %d seq %d frag_cnt %d timeout.}",
+                defrag_ctx->tid, defrag_ctx->us_seq_num, defrag_ctx->frag_cnt);
+            hmac_defrag_ctx_free(defrag_ctx);
+        }
     }
 
+    /* 仍有上下文在重组，按最早上下文的剩余时间重新启动定时器 */
+    oldest = hmac_defrag_ctx_oldest(hmac_user, now_ms);
+    if (oldest != HI_NULL) {
+        frw_timer_restart_timer(&hmac_user->defrag_timer, HMAC_FRAG_TIMEOUT - (now_ms - oldest->last_ms), HI_FALSE);
+    }
     return HI_SUCCESS;
 }
 
-static hi_u32 hmac_defrag_process_frame(hmac_user_stru *hmac_user, oal_netbuf_stru *netbuf, hi_u8 frag_num,
-    const mac_ieee80211_frame_stru *mac_hdr, hi_u8 more_frag)
+/* ****************************************************************************
+ 功能描述  : 释放用户下全部去分片上下文及定时器，用户删除时调用
+**************************************************************************** */
+hi_void hmac_defrag_clear(hmac_user_stru *hmac_user)
 {
-    /* 首片分片的分片号不为0则释放 */
-    if (frag_num != 0) {
-        oal_netbuf_free(netbuf);
-        oam_info_log3(hmac_user->base_user->vap_id, OAM_SF_ANY,
-            "{hmac_defrag_process:frag_num not Zero %d,seq_num %d,frag %d}", frag_num, mac_hdr->seq_num, more_frag);
-        return HI_FAIL;
+    hi_u8 idx;
+
+    for (idx = 0; idx < HMAC_DEFRAG_CTX_NUM; idx++) {
+        if (hmac_user->ast_defrag_ctx[idx].frag_cnt != 0) {
+            hmac_defrag_ctx_free(&hmac_user->ast_defrag_ctx[idx]);
+        }
+    }
+    if (hmac_user->defrag_timer.is_registerd == HI_TRUE) {
+        frw_timer_immediate_destroy_timer(&hmac_user->defrag_timer);
+    }
+}
+
+/* ****************************************************************************
+ 功能描述  : 按TID和序列号查找正在重组的上下文
+**************************************************************************** */
+static hmac_defrag_ctx_stru *hmac_defrag_ctx_lookup(hmac_user_stru *hmac_user, hi_u8 tid,
+    const mac_ieee80211_frame_stru *mac_hdr)
+{
+    hi_u8 idx;
+
+    for (idx = 0; idx < HMAC_DEFRAG_CTX_NUM; idx++) {
+        hmac_defrag_ctx_stru *defrag_ctx = &hmac_user->ast_defrag_ctx[idx];
+        if ((defrag_ctx->frag_cnt == 0) || (defrag_ctx->tid != tid) || (defrag_ctx->us_seq_num != mac_hdr->seq_num)) {
+            continue;
+        }
+        /* 发送端地址由用户保证，接收地址仍需与首片一致 */
+        const mac_ieee80211_frame_stru *first_hdr =
+            (mac_ieee80211_frame_stru *)oal_netbuf_data(defrag_ctx->past_frag[0]);
+        if (oal_compare_mac_addr(first_hdr->auc_address1, mac_hdr->auc_address1, WLAN_MAC_ADDR_LEN) == 0) {
+            return defrag_ctx;
+        }
     }
+    return HI_NULL;
+}
+
+/* ****************************************************************************
+ 功能描述  : 为新MSDU分配重组上下文，无空闲上下文时淘汰最早的上下文
+**************************************************************************** */
+static hmac_defrag_ctx_stru *hmac_defrag_ctx_alloc(hmac_user_stru *hmac_user, hi_u32 now_ms)
+{
+    hmac_defrag_ctx_stru *defrag_ctx = HI_NULL;
+    hi_u8 idx;
+
+    for (idx = 0; idx < HMAC_DEFRAG_CTX_NUM; idx++) {
+        if (hmac_user->ast_defrag_ctx[idx].frag_cnt == 0) {
+            return &hmac_user->ast_defrag_ctx[idx];
+        }
+    }
+
+    defrag_ctx = hmac_defrag_ctx_oldest(hmac_user, now_ms);
+    oam_info_log2(hmac_user->base_user->vap_id, OAM_SF_ANY, "{hmac_defrag_ctx_alloc::evict tid %d seq %d.}",
+        defrag_ctx->tid, defrag_ctx->us_seq_num);
+    hmac_defrag_ctx_free(defrag_ctx);
+    return defrag_ctx;
+}
+
+/* ****************************************************************************
+ 功能描述  : 分片收齐后一次性拷贝成连续的MSDU，并释放上下文
+**************************************************************************** */
+static oal_netbuf_stru *hmac_defrag_ctx_build(hmac_user_stru *hmac_user, hmac_defrag_ctx_stru *defrag_ctx)
+{
+    oal_netbuf_stru *first = defrag_ctx->past_frag[0];
+    hi_u32 buf_size = HMAC_MAX_FRAG_SIZE;
+    hi_u32 offset = 0;
+    hi_u8 idx;
 
-    /* 启动超时定时器，超时释放重组报文 */
-    frw_timer_create_timer(&hmac_user->defrag_timer, hmac_defrag_timeout_fn, HMAC_FRAG_TIMEOUT, hmac_user, HI_FALSE);
 #ifdef _PRE_LWIP_ZERO_COPY
     oal_netbuf_stru *new_buf = oal_pbuf_netbuf_alloc(HMAC_MAX_FRAG_SIZE);
 #else
@@ -216,62 +316,104 @@ static hi_u32 hmac_defrag_process_frame(hmac_user_stru *hmac_user, oal_netbuf_st
     oal_netbuf_stru *new_buf = oal_netbuf_alloc(HMAC_MAX_FRAG_SIZE, 0, 4); /* align 4 */
 #endif
     if (new_buf == HI_NULL) {
-        oam_error_log0(hmac_user->base_user->vap_id, OAM_SF_ANY, "{hmac_defrag_process::Alloc new_buf null.}");
-        oal_netbuf_free(netbuf);
-        return HI_FAIL;
+        oam_error_log0(hmac_user->base_user->vap_id, OAM_SF_ANY, "{hmac_defrag_ctx_build::Alloc new_buf null.}");
+        hmac_defrag_ctx_free(defrag_ctx);
+        return HI_NULL;
     }
 
-    if (memcpy_s(oal_netbuf_cb(new_buf), oal_netbuf_cb_size(), oal_netbuf_cb(netbuf), oal_netbuf_cb_size()) != EOK) {
-        oam_error_log0(0, OAM_SF_ANY, "{hmac_defrag_process::mem safe function err!}");
+    if (memcpy_s(oal_netbuf_cb(new_buf), oal_netbuf_cb_size(), oal_netbuf_cb(first), oal_netbuf_cb_size()) != EOK) {
+        oam_error_log0(0, OAM_SF_ANY, "{hmac_defrag_ctx_build::mem safe function err!}");
         oal_netbuf_free(new_buf);
-        oal_netbuf_free(netbuf);
-        return HI_FAIL;
+        hmac_defrag_ctx_free(defrag_ctx);
+        return HI_NULL;
     }
     hmac_rx_ctl_stru *rx_ctl = (hmac_rx_ctl_stru *)oal_netbuf_cb(new_buf);
-    hmac_user->defrag_netbuf = new_buf;
 
 #ifdef _PRE_LWIP_ZERO_COPY
     oal_netbuf_reserve(new_buf, WLAN_MAX_MAC_HDR_LEN - rx_ctl->mac_header_len);
+    buf_size -= (WLAN_MAX_MAC_HDR_LEN - rx_ctl->mac_header_len);
 #endif
 
-    /* 将分片报文拷贝到新申请的报文中并挂接到用户结构体下，释放原有的报文 */
-    oal_netbuf_init(new_buf, oal_netbuf_len(netbuf));
-    if (memcpy_s(oal_netbuf_data(new_buf), HMAC_MAX_FRAG_SIZE, oal_netbuf_data(netbuf), oal_netbuf_len(netbuf)) != EOK) {
-        oam_error_log0(0, 0, "hmac_defrag_process_frame:: memcpy_s FAILED");
-        oal_netbuf_free(hmac_user->defrag_netbuf);
-        hmac_user->defrag_netbuf = HI_NULL;
-        oal_netbuf_free(netbuf);
-        return HI_FAIL;
+    /* 首片带MAC头，后续分片在入队时已剥掉MAC头，顺序拷贝即得完整MSDU */
+    oal_netbuf_init(new_buf, defrag_ctx->us_total_len);
+    for (idx = 0; idx < defrag_ctx->frag_cnt; idx++) {
+        oal_netbuf_stru *frag = defrag_ctx->past_frag[idx];
+        if (memcpy_s(oal_netbuf_data(new_buf) + offset, buf_size - offset, oal_netbuf_data(frag),
+            oal_netbuf_len(frag)) != EOK) {
+            oam_error_log0(0, 0, "hmac_defrag_ctx_build:: memcpy_s FAILED");
+            oal_netbuf_free(new_buf);
+            hmac_defrag_ctx_free(defrag_ctx);
+            return HI_NULL;
+        }
+        offset += oal_netbuf_len(frag);
     }
     rx_ctl->pul_mac_hdr_start_addr = (hi_u32 *)oal_netbuf_header(new_buf);
-    oal_netbuf_free(netbuf);
+    ((mac_ieee80211_frame_stru *)oal_netbuf_header(new_buf))->frag_num = 0;
 
-    return HI_SUCCESS;
+    hmac_defrag_ctx_free(defrag_ctx);
+    return new_buf;
 }
 
-oal_netbuf_stru *hmac_get_defraged_netbuf(hmac_user_stru *hmac_user, mac_ieee80211_frame_stru *last_hdr)
+/* ****************************************************************************
+ 功能描述  : 将分片挂入对应的重组上下文，分片号不连续时丢弃
+**************************************************************************** */
+static hmac_defrag_ctx_stru *hmac_defrag_ctx_add(hmac_user_stru *hmac_user, oal_netbuf_stru *netbuf, hi_u8 tid,
+    hi_u32 hrdsize)
 {
-    oal_netbuf_stru *netbuf = hmac_user->defrag_netbuf;
-    /* 对重组好的报文进行mic检查 */
-    if (hmac_de_mic(hmac_user, netbuf) != HI_SUCCESS) {
+    mac_ieee80211_frame_stru *mac_hdr = (mac_ieee80211_frame_stru *)oal_netbuf_data(netbuf);
+    hmac_defrag_ctx_stru *defrag_ctx = hmac_defrag_ctx_lookup(hmac_user, tid, mac_hdr);
+    hi_u8 frag_num = (hi_u8)mac_hdr->frag_num;
+    hi_u32 now_ms = (hi_u32)hi_get_milli_seconds();
+
+    if (frag_num == 0) {
+        /* 同一MSDU重新从首片开始则丢弃之前收到的分片 */
+        if (defrag_ctx != HI_NULL) {
+            hmac_defrag_ctx_free(defrag_ctx);
+        } else {
+            /* 首个活动上下文启动定时器，其余上下文由超时处理按剩余时间续期 */
+            if (hmac_defrag_ctx_oldest(hmac_user, now_ms) == HI_NULL) {
+                frw_timer_create_timer(&hmac_user->defrag_timer, hmac_defrag_timeout_fn, HMAC_FRAG_TIMEOUT,
+                    hmac_user, HI_FALSE);
+            }
+            defrag_ctx = hmac_defrag_ctx_alloc(hmac_user, now_ms);
+        }
+        defrag_ctx->tid = tid;
+        defrag_ctx->us_seq_num = (hi_u16)mac_hdr->seq_num;
+    } else if (defrag_ctx == HI_NULL) {
+        /* 首片分片的分片号不为0则释放 */
+        oam_info_log2(hmac_user->base_user->vap_id, OAM_SF_ANY, "{hmac_defrag_ctx_add:no ctx,seq_num %d,frag %d}",
+            mac_hdr->seq_num, frag_num);
         oal_netbuf_free(netbuf);
-        netbuf = HI_NULL;
-        last_hdr = HI_NULL;
+        return HI_NULL;
+    } else if (frag_num < defrag_ctx->frag_cnt) {
+        /* 重传的分片只丢弃本分片，不影响已收到的部分 */
+        oal_netbuf_free(netbuf);
+        return HI_NULL;
+    } else if (frag_num != defrag_ctx->frag_cnt) {
+        /* 中间分片丢失，整个MSDU无法恢复 */
+        hmac_defrag_ctx_free(defrag_ctx);
+        oal_netbuf_free(netbuf);
+        return HI_NULL;
+    } else {
+        oal_netbuf_pull(netbuf, hrdsize);
     }
 
-    hmac_user->defrag_netbuf = HI_NULL;
-    if (last_hdr == HI_NULL) {
-        oam_error_log0(0, 0, "{get_defraged_netbuf::pst_last_hdr null.}");
+    if ((hi_u32)defrag_ctx->us_total_len + oal_netbuf_len(netbuf) > HMAC_MAX_FRAG_SIZE) {
+        oam_warning_log1(hmac_user->base_user->vap_id, OAM_SF_ANY, "{hmac_defrag_ctx_add:too long, seq_num %d}",
+            mac_hdr->seq_num);
+        hmac_defrag_ctx_free(defrag_ctx);
+        oal_netbuf_free(netbuf);
         return HI_NULL;
     }
 
-    last_hdr->frag_num = 0;
-    frw_timer_immediate_destroy_timer(&hmac_user->defrag_timer);
-    return netbuf;
+    defrag_ctx->past_frag[defrag_ctx->frag_cnt++] = netbuf;
+    defrag_ctx->us_total_len += (hi_u16)oal_netbuf_len(netbuf);
+    defrag_ctx->last_ms = now_ms;
+    return defrag_ctx;
 }
 
 /* ****************************************************************************
- 功能描述  : 去分片处理
+ 功能描述  : 去分片处理，每用户按TID和序列号同时维护多个重组上下文
  修改历史      :
   1.日    期   : 2014年2月20日
     作    者   : HiSilicon
@@ -279,58 +421,36 @@ oal_netbuf_stru *hmac_get_defraged_netbuf(hmac_user_stru *hmac_user, mac_ieee802
 **************************************************************************** */
 oal_netbuf_stru *hmac_defrag_process(hmac_user_stru *hmac_user, oal_netbuf_stru *netbuf, hi_u32 hrdsize)
 {
-    mac_ieee80211_frame_stru *last_hdr = HI_NULL;
-
     mac_ieee80211_frame_stru *mac_hdr = (mac_ieee80211_frame_stru *)oal_netbuf_data(netbuf);
     hi_u8 more_frag = (hi_u8)mac_hdr->frame_control.more_frag;
+    hi_u8 tid = WLAN_TID_MAX_NUM; /* 非QoS数据帧使用独立的序列号空间 */
 
-    /* 如果没有什么可以去分片的则直接返回 */
-    if (!more_frag && ((hi_u8)mac_hdr->frag_num == 0) && (hmac_user->defrag_netbuf == HI_NULL)) {
+    /* 如果没有什么可以去分片的则直接返回，不影响其它正在重组的MSDU */
+    if (!more_frag && ((hi_u8)mac_hdr->frag_num == 0)) {
         return netbuf;
     }
 
-    /* 首先检查到来的分片报文是不是属于正在重组的分片报文 */
-    if (hmac_user->defrag_netbuf != HI_NULL) {
-        frw_timer_restart_timer(&hmac_user->defrag_timer, HMAC_FRAG_TIMEOUT, HI_FALSE);
-        last_hdr = (mac_ieee80211_frame_stru *)oal_netbuf_data(hmac_user->defrag_netbuf);
-        /* 如果地址不匹配，序列号不匹配，分片号不匹配则释放现在正在重组的报文 */
-        if (mac_hdr->seq_num != last_hdr->seq_num || (hi_u8)mac_hdr->frag_num != ((hi_u8)last_hdr->frag_num + 1) ||
-            oal_compare_mac_addr(last_hdr->auc_address1, mac_hdr->auc_address1, WLAN_MAC_ADDR_LEN) ||
-            oal_compare_mac_addr(last_hdr->auc_address2, mac_hdr->auc_address2, WLAN_MAC_ADDR_LEN)) {
-            oal_netbuf_free(hmac_user->defrag_netbuf);
-            frw_timer_immediate_destroy_timer(&hmac_user->defrag_timer);
-            hmac_user->defrag_netbuf = HI_NULL;
-        }
+    if (mac_hdr->frame_control.sub_type == WLAN_QOS_DATA) {
+        tid = mac_get_tid_value((hi_u8 *)mac_hdr, mac_is_4addr((hi_u8 *)mac_hdr));
     }
 
-    /* 判断到来的分片报文是否是第一个分片 */
-    if (hmac_user->defrag_netbuf == HI_NULL) {
-        if (hmac_defrag_process_frame(hmac_user, netbuf, (hi_u8)mac_hdr->frag_num, mac_hdr, more_frag) != HI_SUCCESS) {
-            return HI_NULL;
-        }
-    } else {
-        /* 此分片是期望的到来的分片，重启定时器，并进行重组 */
-        frw_timer_restart_timer(&hmac_user->defrag_timer, HMAC_FRAG_TIMEOUT, HI_FALSE);
-        oal_netbuf_pull(netbuf, hrdsize);
-        /* 去分片失败释放当前分片报文 */
-        if (oal_netbuf_concat(hmac_user->defrag_netbuf, netbuf) != HI_SUCCESS) {
-            oal_netbuf_free(hmac_user->defrag_netbuf);
-            oal_netbuf_free(netbuf);
-            frw_timer_immediate_destroy_timer(&hmac_user->defrag_timer);
-            hmac_user->defrag_netbuf = HI_NULL;
-            return HI_NULL;
-        }
-        /* 记录最新分片报文的分片号 */
-        last_hdr->seq_num   = mac_hdr->seq_num;
-        last_hdr->frag_num  = mac_hdr->frag_num;
+    hmac_defrag_ctx_stru *defrag_ctx = hmac_defrag_ctx_add(hmac_user, netbuf, tid, hrdsize);
+    /* 判断是否重组完毕，存在更多报文返回空指针，重组完毕返回组好的报文 */
+    if ((defrag_ctx == HI_NULL) || more_frag) {
+        return HI_NULL;
     }
 
-    /* 判断是否重组完毕，存在更多报文返回空指针，重组完毕返回组好的报文 */
-    if (more_frag) {
+    netbuf = hmac_defrag_ctx_build(hmac_user, defrag_ctx);
+    if (netbuf == HI_NULL) {
         return HI_NULL;
     }
 
-    return hmac_get_defraged_netbuf(hmac_user, last_hdr);
+    /* 对重组好的报文进行mic检查 */
+    if (hmac_de_mic(hmac_user, netbuf) != HI_SUCCESS) {
+        oal_netbuf_free(netbuf);
+        return HI_NULL;
+    }
+    return netbuf;
 }
 
 #ifdef __cplusplus
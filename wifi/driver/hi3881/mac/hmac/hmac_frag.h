@@ -41,6 +41,7 @@ extern "C" {
   3 函数声明
 **************************************************************************** */
 oal_netbuf_stru *hmac_defrag_process(hmac_user_stru *hmac_user, oal_netbuf_stru *netbuf, hi_u32 hrdsize);
+hi_void hmac_defrag_clear(hmac_user_stru *hmac_user);
 hi_u32 hmac_frag_process_proc(const hmac_vap_stru *hmac_vap, const hmac_user_stru *hmac_user, oal_netbuf_stru *netbuf,
     hmac_tx_ctl_stru *tx_ctl);
 
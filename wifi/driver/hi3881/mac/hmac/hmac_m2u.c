@@ -0,0 +1,691 @@
+/*
+ * Copyright (C) 2021 HiSilicon (Shanghai) Technologies CO., LIMITED.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+/* ****************************************************************************
+  1 头文件包含
+**************************************************************************** */
+#include "oal_net.h"
+#include "oam_ext_if.h"
+#include "mac_frame.h"
+#include "hmac_m2u.h"
+#include "hmac_user.h"
+#include "hmac_tx_data.h"
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C" {
+#endif
+#endif
+
+/* ****************************************************************************
+  2 宏定义
+**************************************************************************** */
+#define HMAC_M2U_IPV4_ADDR_LEN          4
+#define HMAC_M2U_IPV6_ADDR_LEN          16
+#define HMAC_M2U_IPV4_CLASS_D_MASK      0xF0
+#define HMAC_M2U_IPV4_CLASS_D           0xE0
+#define HMAC_M2U_IPV4_LOCAL_PREFIX      0xE0        /* 224.0.0.x为本地链路控制组 */
+#define HMAC_M2U_IPV6_MCAST_PREFIX      0xFF
+#define HMAC_M2U_IPV6_SCOPE_MASK        0x0F
+#define HMAC_M2U_IPV6_SCOPE_LINK_LOCAL  0x02        /* 接口/链路本地范围的组播组不侦听 */
+#define HMAC_M2U_MLD_HDR_LEN            8           /* type,code,checksum,以及4字节类型相关字段 */
+#define HMAC_M2U_MLD_REC_HDR_LEN        4           /* MLDv2 record: type,aux_len,nsrcs */
+#define HMAC_M2U_MLD_NREC_OFFSET        6           /* MLDv2 report中record个数的偏移 */
+#define HMAC_M2U_IP_IHL_MASK            0x0F
+#define HMAC_M2U_WORD_SHIFT             2
+#define HMAC_M2U_IPV6_EXT_LEN_SHIFT     3           /* IPv6扩展头长度单位为8字节 */
+
+/* ****************************************************************************
+  3 枚举定义
+**************************************************************************** */
+typedef enum {
+    HMAC_M2U_ACTION_JOIN,
+    HMAC_M2U_ACTION_LEAVE,
+
+    HMAC_M2U_ACTION_BUTT
+} hmac_m2u_action_enum;
+typedef hi_u8 hmac_m2u_action_enum_uint8;
+
+/* ****************************************************************************
+  4 函数实现
+**************************************************************************** */
+static inline hi_bool hmac_m2u_is_expired(hi_u32 now, hi_u32 stamp)
+{
+    return (hi_bool)((hi_u32)(now - stamp) > HMAC_M2U_MEMBER_AGING_MS);
+}
+
+static inline hi_u16 hmac_m2u_get_u16(const hi_u8 *puc_data)
+{
+    return (hi_u16)(((hi_u16)puc_data[0] << 8) | puc_data[1]); /* 8: 网络序高字节 */
+}
+
+/* ****************************************************************************
+ 功能描述  : IPv4组播地址转换为组播mac地址(01:00:5e + 低23bit)
+ 返 回 值  : HI_TRUE 需要侦听的组播组; HI_FALSE 非组播或本地链路控制组
+**************************************************************************** */
+static hi_bool hmac_m2u_ipv4_to_mac(const hi_u8 *grp, hi_u8 *grp_mac)
+{
+    if ((grp[0] & HMAC_M2U_IPV4_CLASS_D_MASK) != HMAC_M2U_IPV4_CLASS_D) {
+        return HI_FALSE;
+    }
+    if ((grp[0] == HMAC_M2U_IPV4_LOCAL_PREFIX) && (grp[1] == 0) && (grp[2] == 0)) { /* 1 2 元素索引 */
+        return HI_FALSE;
+    }
+
+    grp_mac[0] = 0x01;
+    grp_mac[1] = 0x00;
+    grp_mac[2] = 0x5E;          /* 2 元素索引 */
+    grp_mac[3] = grp[1] & 0x7F; /* 3 元素索引 */
+    grp_mac[4] = grp[2];        /* 4 2 元素索引 */
+    grp_mac[5] = grp[3];        /* 5 3 元素索引 */
+    return HI_TRUE;
+}
+
+/* ****************************************************************************
+ 功能描述  : IPv6组播地址转换为组播mac地址(33:33 + 低32bit)
+ 返 回 值  : HI_TRUE 需要侦听的组播组; HI_FALSE 非组播或链路本地范围组播组
+**************************************************************************** */
+static hi_bool hmac_m2u_ipv6_to_mac(const hi_u8 *grp, hi_u8 *grp_mac)
+{
+    if ((grp[0] != HMAC_M2U_IPV6_MCAST_PREFIX) ||
+        ((grp[1] & HMAC_M2U_IPV6_SCOPE_MASK) <= HMAC_M2U_IPV6_SCOPE_LINK_LOCAL)) {
+        return HI_FALSE;
+    }
+
+    grp_mac[0] = 0x33;
+    grp_mac[1] = 0x33;
+    grp_mac[2] = grp[12]; /* 2 12 元素索引 */
+    grp_mac[3] = grp[13]; /* 3 13 元素索引 */
+    grp_mac[4] = grp[14]; /* 4 14 元素索引 */
+    grp_mac[5] = grp[15]; /* 5 15 元素索引 */
+    return HI_TRUE;
+}
+
+static hmac_m2u_group_stru *hmac_m2u_find_group(hmac_m2u_stru *m2u, const hi_u8 *grp_mac)
+{
+    hi_u8 idx;
+
+    for (idx = 0; idx < HMAC_M2U_GROUP_MAX_NUM; idx++) {
+        hmac_m2u_group_stru *group = &m2u->ast_group[idx];
+        if ((group->member_num != 0) && (memcmp(group->auc_grp_mac, grp_mac, WLAN_MAC_ADDR_LEN) == 0)) {
+            return group;
+        }
+    }
+
+    return HI_NULL;
+}
+
+static hmac_m2u_group_stru *hmac_m2u_alloc_group(hmac_m2u_stru *m2u, const hi_u8 *grp_mac)
+{
+    hi_u8 idx;
+
+    for (idx = 0; idx < HMAC_M2U_GROUP_MAX_NUM; idx++) {
+        hmac_m2u_group_stru *group = &m2u->ast_group[idx];
+        if (group->member_num == 0) {
+            /* 安全编程规则6.6例外(1) 固定长度的结构体进行内存初始化 */
+            memset_s(group, sizeof(hmac_m2u_group_stru), 0, sizeof(hmac_m2u_group_stru));
+            if (memcpy_s(group->auc_grp_mac, WLAN_MAC_ADDR_LEN, grp_mac, WLAN_MAC_ADDR_LEN) != EOK) {
+                return HI_NULL;
+            }
+            m2u->group_num++;
+            return group;
+        }
+    }
+
+    return HI_NULL;
+}
+
+/* ****************************************************************************
+ 功能描述  : 删除组播组的一个成员,成员为空时释放该组
+**************************************************************************** */
+static hi_void hmac_m2u_group_del_member(hmac_m2u_stru *m2u, hmac_m2u_group_stru *group, hi_u8 member_idx)
+{
+    if (member_idx >= group->member_num) {
+        return;
+    }
+
+    hi_u8 last = group->member_num - 1;
+
+    /* 用最后一个成员填补空位,保持成员数组紧凑 */
+    group->auc_user_idx[member_idx]  = group->auc_user_idx[last];
+    group->aul_timestamp[member_idx] = group->aul_timestamp[last];
+    group->member_num--;
+
+    if (group->member_num == 0) {
+        /* 安全编程规则6.6例外(1) 固定长度的结构体进行内存初始化 */
+        memset_s(group, sizeof(hmac_m2u_group_stru), 0, sizeof(hmac_m2u_group_stru));
+        m2u->group_num--;
+    }
+}
+
+/* ****************************************************************************
+ 功能描述  : 组播组成员老化,在查表时惰性执行,无需额外定时器
+**************************************************************************** */
+static hi_void hmac_m2u_group_aging(hmac_m2u_stru *m2u, hmac_m2u_group_stru *group, hi_u32 now)
+{
+    hi_u8 idx = 0;
+
+    if ((group->overflow == HI_TRUE) && hmac_m2u_is_expired(now, group->overflow_stamp)) {
+        group->overflow = HI_FALSE;
+    }
+
+    while ((group->member_num != 0) && (idx < group->member_num)) {
+        if (hmac_m2u_is_expired(now, group->aul_timestamp[idx])) {
+            hmac_m2u_group_del_member(m2u, group, idx);
+            continue;
+        }
+        idx++;
+    }
+}
+
+static hi_void hmac_m2u_group_leave(hmac_m2u_stru *m2u, hmac_m2u_group_stru *group, hi_u8 user_idx)
+{
+    hi_u8 idx;
+
+    for (idx = 0; idx < group->member_num; idx++) {
+        if (group->auc_user_idx[idx] == user_idx) {
+            hmac_m2u_group_del_member(m2u, group, idx);
+            return;
+        }
+    }
+}
+
+static hi_void hmac_m2u_group_join(hmac_m2u_stru *m2u, const hi_u8 *grp_mac, hi_u8 user_idx, hi_u32 now)
+{
+    hi_u8 idx;
+    hmac_m2u_group_stru *group = hmac_m2u_find_group(m2u, grp_mac);
+
+    if (group == HI_NULL) {
+        group = hmac_m2u_alloc_group(m2u, grp_mac);
+        if (group == HI_NULL) {
+            /* 组表已满,该组不记录,数据按组播发送 */
+            oam_info_log1(0, OAM_SF_M2U, "{hmac_m2u_group_join::group table full[%d].}", m2u->group_num);
+            return;
+        }
+    }
+
+    for (idx = 0; idx < group->member_num; idx++) {
+        if (group->auc_user_idx[idx] == user_idx) {
+            group->aul_timestamp[idx] = now;
+            return;
+        }
+    }
+
+    if (group->member_num < HMAC_M2U_MEMBER_MAX_NUM) {
+        group->auc_user_idx[group->member_num]  = user_idx;
+        group->aul_timestamp[group->member_num] = now;
+        group->member_num++;
+        return;
+    }
+
+    /* 成员表溢出,存在未记录的成员,溢出期间该组回退为组播 */
+    group->overflow       = HI_TRUE;
+    group->overflow_stamp = now;
+}
+
+static hi_void hmac_m2u_update_member(hmac_m2u_stru *m2u, const hi_u8 *grp_mac, hi_u8 user_idx,
+    hmac_m2u_action_enum_uint8 action)
+{
+    hi_u32 now = (hi_u32)hi_get_milli_seconds();
+    hmac_m2u_group_stru *group = hmac_m2u_find_group(m2u, grp_mac);
+
+    if (group != HI_NULL) {
+        hmac_m2u_group_aging(m2u, group, now);
+    }
+
+    if (action == HMAC_M2U_ACTION_JOIN) {
+        hmac_m2u_group_join(m2u, grp_mac, user_idx, now);
+    } else if ((group != HI_NULL) && (group->member_num != 0)) {
+        hmac_m2u_group_leave(m2u, group, user_idx);
+    }
+}
+
+/* ****************************************************************************
+ 功能描述  : 根据IGMPv3/MLDv2 record类型确定成员关系变化
+             EXCLUDE模式表示加入;INCLUDE模式且源列表为空表示离开;BLOCK不改变成员关系
+**************************************************************************** */
+static hmac_m2u_action_enum_uint8 hmac_m2u_record_action(hi_u8 rec_type, hi_u16 us_nsrcs)
+{
+    switch (rec_type) {
+        case IGMPV3_MODE_IS_EXCLUDE:
+        case IGMPV3_CHANGE_TO_EXCLUDE:
+            return HMAC_M2U_ACTION_JOIN;
+        case IGMPV3_MODE_IS_INCLUDE:
+        case IGMPV3_CHANGE_TO_INCLUDE:
+            return (us_nsrcs == 0) ? HMAC_M2U_ACTION_LEAVE : HMAC_M2U_ACTION_JOIN;
+        case IGMPV3_ALLOW_NEW_SOURCES:
+            return (us_nsrcs == 0) ? HMAC_M2U_ACTION_BUTT : HMAC_M2U_ACTION_JOIN;
+        default:
+            return HMAC_M2U_ACTION_BUTT;
+    }
+}
+
+static hi_void hmac_m2u_snoop_igmpv3(hmac_m2u_stru *m2u, hi_u8 user_idx, const hi_u8 *igmp, hi_u32 len)
+{
+    const mac_igmp_v3_report_stru *report = (const mac_igmp_v3_report_stru *)igmp;
+    hi_u16 us_ngrec = oal_net2host_short(report->us_ngrec);
+    hi_u32 offset = sizeof(mac_igmp_v3_report_stru);
+    hi_u8  grp_mac[WLAN_MAC_ADDR_LEN];
+    hi_u16 us_idx;
+
+    for (us_idx = 0; us_idx < us_ngrec; us_idx++) {
+        if (offset + sizeof(mac_igmp_v3_grec_stru) > len) {
+            return;
+        }
+
+        const mac_igmp_v3_grec_stru *grec = (const mac_igmp_v3_grec_stru *)(igmp + offset);
+        hi_u16 us_nsrcs = oal_net2host_short(grec->us_grec_nsrcs);
+        hmac_m2u_action_enum_uint8 action = hmac_m2u_record_action(grec->grec_type, us_nsrcs);
+        if ((action != HMAC_M2U_ACTION_BUTT) && hmac_m2u_ipv4_to_mac((const hi_u8 *)&grec->grec_mca, grp_mac)) {
+            hmac_m2u_update_member(m2u, grp_mac, user_idx, action);
+        }
+
+        offset += sizeof(mac_igmp_v3_grec_stru) + ((hi_u32)us_nsrcs * HMAC_M2U_IPV4_ADDR_LEN) +
+            ((hi_u32)grec->grec_auxwords << HMAC_M2U_WORD_SHIFT);
+    }
+}
+
+static hi_void hmac_m2u_snoop_igmp(hmac_m2u_stru *m2u, hi_u8 user_idx, const hi_u8 *ip, hi_u32 len)
+{
+    hi_u32 ihl = (hi_u32)(ip[0] & HMAC_M2U_IP_IHL_MASK) << HMAC_M2U_WORD_SHIFT;
+    hi_u8  grp_mac[WLAN_MAC_ADDR_LEN];
+
+    if ((ihl < sizeof(mac_ip_header_stru)) || (len < ihl + sizeof(mac_igmp_header_stru))) {
+        return;
+    }
+
+    const mac_igmp_header_stru *igmp = (const mac_igmp_header_stru *)(ip + ihl);
+    switch (igmp->type) {
+        case MAC_IGMPV1_REPORT_TYPE:
+        case MAC_IGMPV2_REPORT_TYPE:
+            if (hmac_m2u_ipv4_to_mac((const hi_u8 *)&igmp->group, grp_mac)) {
+                hmac_m2u_update_member(m2u, grp_mac, user_idx, HMAC_M2U_ACTION_JOIN);
+            }
+            break;
+        case MAC_IGMPV2_LEAVE_TYPE:
+            if (hmac_m2u_ipv4_to_mac((const hi_u8 *)&igmp->group, grp_mac)) {
+                hmac_m2u_update_member(m2u, grp_mac, user_idx, HMAC_M2U_ACTION_LEAVE);
+            }
+            break;
+        case MAC_IGMPV3_REPORT_TYPE:
+            hmac_m2u_snoop_igmpv3(m2u, user_idx, (const hi_u8 *)igmp, len - ihl);
+            break;
+        default:
+            break;
+    }
+}
+
+/* ****************************************************************************
+ 功能描述  : 获取IPv6报文中MLD报文的偏移,支持逐跳选项扩展头
+ 返 回 值  : MLD报文相对IPv6头的偏移,非MLD报文返回0
+**************************************************************************** */
+static hi_u32 hmac_m2u_get_mld_offset(const hi_u8 *ip6, hi_u32 len)
+{
+    const oal_ipv6hdr_stru *ipv6_hdr = (const oal_ipv6hdr_stru *)ip6;
+    hi_u32 offset = sizeof(oal_ipv6hdr_stru);
+    hi_u8  nexthdr;
+
+    if (len < offset + HMAC_M2U_MLD_HDR_LEN) {
+        return 0;
+    }
+
+    nexthdr = ipv6_hdr->nexthdr;
+    if (nexthdr == MAC_IPV6_NEXTHDR_HOP) {
+        nexthdr = ip6[offset];
+        offset += ((hi_u32)ip6[offset + 1] + 1) << HMAC_M2U_IPV6_EXT_LEN_SHIFT;
+    }
+
+    if ((nexthdr != OAL_IPPROTO_ICMPV6) || (len < offset + HMAC_M2U_MLD_HDR_LEN)) {
+        return 0;
+    }
+
+    if ((ip6[offset] != MAC_MLDV1_REPORT_TYPE) && (ip6[offset] != MAC_MLDV1_DONE_TYPE) &&
+        (ip6[offset] != MAC_MLDV2_REPORT_TYPE)) {
+        return 0;
+    }
+
+    return offset;
+}
+
+static hi_void hmac_m2u_snoop_mldv2(hmac_m2u_stru *m2u, hi_u8 user_idx, const hi_u8 *mld, hi_u32 len)
+{
+    hi_u16 us_nrec = hmac_m2u_get_u16(mld + HMAC_M2U_MLD_NREC_OFFSET);
+    hi_u32 offset = HMAC_M2U_MLD_HDR_LEN;
+    hi_u8  grp_mac[WLAN_MAC_ADDR_LEN];
+    hi_u16 us_idx;
+
+    for (us_idx = 0; us_idx < us_nrec; us_idx++) {
+        if (offset + HMAC_M2U_MLD_REC_HDR_LEN + HMAC_M2U_IPV6_ADDR_LEN > len) {
+            return;
+        }
+
+        const hi_u8 *rec = mld + offset;
+        hi_u16 us_nsrcs = hmac_m2u_get_u16(rec + 2); /* 2: 源地址个数偏移 */
+        hmac_m2u_action_enum_uint8 action = hmac_m2u_record_action(rec[0], us_nsrcs);
+        if ((action != HMAC_M2U_ACTION_BUTT) && hmac_m2u_ipv6_to_mac(rec + HMAC_M2U_MLD_REC_HDR_LEN, grp_mac)) {
+            hmac_m2u_update_member(m2u, grp_mac, user_idx, action);
+        }
+
+        offset += HMAC_M2U_MLD_REC_HDR_LEN + HMAC_M2U_IPV6_ADDR_LEN +
+            ((hi_u32)us_nsrcs * HMAC_M2U_IPV6_ADDR_LEN) + ((hi_u32)rec[1] << HMAC_M2U_WORD_SHIFT);
+    }
+}
+
+static hi_void hmac_m2u_snoop_mld(hmac_m2u_stru *m2u, hi_u8 user_idx, const hi_u8 *mld, hi_u32 len)
+{
+    hi_u8 grp_mac[WLAN_MAC_ADDR_LEN];
+
+    if (mld[0] == MAC_MLDV2_REPORT_TYPE) {
+        hmac_m2u_snoop_mldv2(m2u, user_idx, mld, len);
+        return;
+    }
+
+    /* MLDv1 report/done: 组播地址紧跟在8字节头之后 */
+    if ((len < HMAC_M2U_MLD_HDR_LEN + HMAC_M2U_IPV6_ADDR_LEN) ||
+        (hmac_m2u_ipv6_to_mac(mld + HMAC_M2U_MLD_HDR_LEN, grp_mac) == HI_FALSE)) {
+        return;
+    }
+
+    hmac_m2u_update_member(m2u, grp_mac, user_idx,
+        (mld[0] == MAC_MLDV1_REPORT_TYPE) ? HMAC_M2U_ACTION_JOIN : HMAC_M2U_ACTION_LEAVE);
+}
+
+/* ****************************************************************************
+ 功能描述  : 初始化vap的组播转单播侦听表,vap创建时调用,此时尚无收发并发访问
+**************************************************************************** */
+hi_void hmac_m2u_init(hmac_vap_stru *hmac_vap)
+{
+    /* 安全编程规则6.6例外(1) 固定长度的结构体进行内存初始化 */
+    memset_s(&hmac_vap->m2u, sizeof(hmac_m2u_stru), 0, sizeof(hmac_m2u_stru));
+    oal_spin_lock_init(&hmac_vap->m2u.lock);
+    hmac_vap->m2u.snoop_on   = HI_SWITCH_OFF;
+    hmac_vap->m2u.max_member = HMAC_M2U_DEFAULT_MAX_MEMBER;
+}
+
+/* ****************************************************************************
+ 功能描述  : 设置侦听开关及转单播成员数门限,关闭侦听时清空成员表,重新打开后按新上报的report重建
+**************************************************************************** */
+hi_void hmac_m2u_set_snoop(hmac_vap_stru *hmac_vap, hi_u8 snoop_on, hi_u8 max_member)
+{
+    hmac_m2u_stru *m2u = &hmac_vap->m2u;
+
+    oal_spin_lock_bh(&m2u->lock);
+    if (snoop_on == HI_SWITCH_OFF) {
+        /* 安全编程规则6.6例外(1) 固定长度的结构体进行内存初始化 */
+        memset_s(m2u->ast_group, sizeof(m2u->ast_group), 0, sizeof(m2u->ast_group));
+        m2u->group_num = 0;
+    }
+    m2u->snoop_on   = snoop_on;
+    m2u->max_member = max_member;
+    oal_spin_unlock_bh(&m2u->lock);
+}
+
+/* ****************************************************************************
+ 功能描述  : AP接收方向侦听STA发出的IGMP/MLD报文,更新组播组成员表
+ 输入参数  : mac_vap: 接收vap
+             ta: 发送端mac地址
+             netbuf: 已转换为以太网格式的报文
+**************************************************************************** */
+hi_void hmac_m2u_snoop_inspecting(mac_vap_stru *mac_vap, const hi_u8 *ta, const oal_netbuf_stru *netbuf)
+{
+    hi_u8  user_idx = 0;
+    hi_u32 offset = 0;
+
+    if (mac_vap->vap_mode != WLAN_VAP_MODE_BSS_AP) {
+        return;
+    }
+
+    hmac_vap_stru *hmac_vap = hmac_vap_get_vap_stru(mac_vap->vap_id);
+    if ((hmac_vap == HI_NULL) || (hmac_vap->m2u.snoop_on == HI_FALSE) ||
+        (oal_netbuf_len(netbuf) <= sizeof(mac_ether_header_stru))) {
+        return;
+    }
+
+    const mac_ether_header_stru *ether_hdr = (const mac_ether_header_stru *)oal_netbuf_data(netbuf);
+    const hi_u8 *puc_ip = (const hi_u8 *)(ether_hdr + 1);
+    hi_u32 len = oal_netbuf_len(netbuf) - sizeof(mac_ether_header_stru);
+
+    if (ether_hdr->us_ether_type == oal_host2net_short(ETHER_TYPE_IP)) {
+        if ((len < sizeof(mac_ip_header_stru)) ||
+            (((const mac_ip_header_stru *)puc_ip)->protocol != MAC_IGMP_PROTOCAL)) {
+            return;
+        }
+    } else if (ether_hdr->us_ether_type == oal_host2net_short(ETHER_TYPE_IPV6)) {
+        offset = hmac_m2u_get_mld_offset(puc_ip, len);
+        if (offset == 0) {
+            return;
+        }
+    } else {
+        return;
+    }
+
+    if (mac_vap_find_user_by_macaddr(mac_vap, ta, WLAN_MAC_ADDR_LEN, &user_idx) != HI_SUCCESS) {
+        return;
+    }
+
+    oal_spin_lock_bh(&hmac_vap->m2u.lock);
+    if (offset == 0) {
+        hmac_m2u_snoop_igmp(&hmac_vap->m2u, user_idx, puc_ip, len);
+    } else {
+        hmac_m2u_snoop_mld(&hmac_vap->m2u, user_idx, puc_ip + offset, len - offset);
+    }
+    oal_spin_unlock_bh(&hmac_vap->m2u.lock);
+}
+
+/* ****************************************************************************
+ 功能描述  : 用户删除时清除其在所有组播组中的成员记录
+**************************************************************************** */
+hi_void hmac_m2u_del_user(const mac_vap_stru *mac_vap, hi_u8 user_idx)
+{
+    hi_u8 idx;
+
+    hmac_vap_stru *hmac_vap = hmac_vap_get_vap_stru(mac_vap->vap_id);
+    if ((hmac_vap == HI_NULL) || (hmac_vap->m2u.group_num == 0)) {
+        return;
+    }
+
+    oal_spin_lock_bh(&hmac_vap->m2u.lock);
+    for (idx = 0; idx < HMAC_M2U_GROUP_MAX_NUM; idx++) {
+        hmac_m2u_group_stru *group = &hmac_vap->m2u.ast_group[idx];
+        if (group->member_num != 0) {
+            hmac_m2u_group_leave(&hmac_vap->m2u, group, user_idx);
+        }
+    }
+    oal_spin_unlock_bh(&hmac_vap->m2u.lock);
+}
+
+/* ****************************************************************************
+ 功能描述  : 判断是否为会被其他成员抑制的report(IGMPv1/v2, MLDv1)
+             侦听开启时这类report不向空口转发,避免STA因report抑制不再上报导致成员表不完整
+**************************************************************************** */
+static hi_bool hmac_m2u_is_suppressible_report(const oal_netbuf_stru *netbuf)
+{
+    const mac_ether_header_stru *ether_hdr = (const mac_ether_header_stru *)oal_netbuf_data(netbuf);
+    const hi_u8 *puc_ip = (const hi_u8 *)(ether_hdr + 1);
+    hi_u32 len = oal_netbuf_len(netbuf) - sizeof(mac_ether_header_stru);
+
+    if (ether_hdr->us_ether_type == oal_host2net_short(ETHER_TYPE_IP)) {
+        hi_u32 ihl = (hi_u32)(puc_ip[0] & HMAC_M2U_IP_IHL_MASK) << HMAC_M2U_WORD_SHIFT;
+        if ((len < sizeof(mac_ip_header_stru)) ||
+            (((const mac_ip_header_stru *)puc_ip)->protocol != MAC_IGMP_PROTOCAL) ||
+            (ihl < sizeof(mac_ip_header_stru)) || (len < ihl + sizeof(mac_igmp_header_stru))) {
+            return HI_FALSE;
+        }
+        return (hi_bool)((puc_ip[ihl] == MAC_IGMPV1_REPORT_TYPE) || (puc_ip[ihl] == MAC_IGMPV2_REPORT_TYPE));
+    }
+
+    if (ether_hdr->us_ether_type == oal_host2net_short(ETHER_TYPE_IPV6)) {
+        hi_u32 offset = hmac_m2u_get_mld_offset(puc_ip, len);
+        return (hi_bool)((offset != 0) && (puc_ip[offset] == MAC_MLDV1_REPORT_TYPE));
+    }
+
+    return HI_FALSE;
+}
+
+static oal_netbuf_stru *hmac_m2u_copy_netbuf(oal_netbuf_stru *netbuf)
+{
+    hi_u32 len = oal_netbuf_len(netbuf);
+
+    /* 保持与原报文相同的头部空间,供后续封装802.11头使用 */
+    oal_netbuf_stru *copy = oal_netbuf_alloc(len, oal_netbuf_headroom(netbuf), 4); /* align 4 */
+    if (copy == HI_NULL) {
+        return HI_NULL;
+    }
+
+    /* 拷贝为本地新申请的报文,cb不继承原报文的来源信息(如WLAN_DTX事件类型),与桥发送入口一致清零 */
+    if ((memset_s(oal_netbuf_cb(copy), oal_netbuf_cb_size(), 0, oal_netbuf_cb_size()) != EOK) ||
+        (memcpy_s(oal_netbuf_data(copy), oal_netbuf_tailroom(copy), oal_netbuf_data(netbuf), len) != EOK)) {
+        oal_netbuf_free(copy);
+        return HI_NULL;
+    }
+    oal_netbuf_put(copy, len);
+    oal_netbuf_copy_queue_mapping(copy, netbuf);
+
+    return copy;
+}
+
+/* ****************************************************************************
+ 功能描述  : 获取组内已关联成员的mac地址,跳过报文的源STA(src_user_idx),不向源STA回送
+**************************************************************************** */
+static hi_u8 hmac_m2u_get_active_members(hmac_vap_stru *hmac_vap, const hmac_m2u_group_stru *group,
+    hi_u8 src_user_idx, hi_u8 dst_mac[][WLAN_MAC_ADDR_LEN])
+{
+    hi_u8 idx;
+    hi_u8 num = 0;
+
+    for (idx = 0; idx < group->member_num; idx++) {
+        if (group->auc_user_idx[idx] == src_user_idx) {
+            continue;
+        }
+        hmac_user_stru *hmac_user = (hmac_user_stru *)hmac_user_get_user_stru(group->auc_user_idx[idx]);
+        if ((hmac_user == HI_NULL) || (hmac_user->base_user == HI_NULL) ||
+            (hmac_user->base_user->vap_id != hmac_vap->base_vap->vap_id) ||
+            (hmac_user->base_user->user_asoc_state != MAC_USER_STATE_ASSOC)) {
+            continue;
+        }
+        if (memcpy_s(dst_mac[num], WLAN_MAC_ADDR_LEN, hmac_user->base_user->user_mac_addr,
+            WLAN_MAC_ADDR_LEN) == EOK) {
+            num++;
+        }
+    }
+
+    return num;
+}
+
+/* ****************************************************************************
+ 功能描述  : 查表并老化组播组,拷贝出需转单播的成员mac地址,调用者持有m2u锁
+ 返 回 值  : HI_CONTINUE 按组播发送; HI_SUCCESS 转单播,num为成员个数,为0表示源STA是组内唯一成员,无需发送
+**************************************************************************** */
+static hi_u32 hmac_m2u_get_dst_list(hmac_vap_stru *hmac_vap, const hi_u8 *grp_mac, hi_u8 src_user_idx,
+    hi_u8 dst_mac[][WLAN_MAC_ADDR_LEN], hi_u8 *num)
+{
+    hmac_m2u_stru *m2u = &hmac_vap->m2u;
+
+    hmac_m2u_group_stru *group = hmac_m2u_find_group(m2u, grp_mac);
+    if (group == HI_NULL) {
+        return HI_CONTINUE;
+    }
+
+    hmac_m2u_group_aging(m2u, group, (hi_u32)hi_get_milli_seconds());
+    if ((group->member_num == 0) || (group->overflow == HI_TRUE) || (group->member_num > m2u->max_member)) {
+        return HI_CONTINUE;
+    }
+
+    *num = hmac_m2u_get_active_members(hmac_vap, group, src_user_idx, dst_mac);
+    if (*num != 0) {
+        return HI_SUCCESS;
+    }
+
+    return (hmac_m2u_get_active_members(hmac_vap, group, MAC_INVALID_USER_ID, dst_mac) != 0) ?
+        HI_SUCCESS : HI_CONTINUE;
+}
+
+/* ****************************************************************************
+ 功能描述  : AP发送方向组播转单播
+             组播组成员数不超过门限时,为每个成员复制一份报文并改写目的地址为成员mac,
+             按单播流程发送(可聚合,使用成员自身速率);否则按组播发送
+ 返 回 值  : HI_CONTINUE 未转换,继续按原流程发送; 其他 报文已处理,返回值即发送结果
+**************************************************************************** */
+hi_u32 hmac_m2u_convert(hmac_vap_stru *hmac_vap, oal_netbuf_stru *netbuf)
+{
+    hmac_m2u_stru *m2u = &hmac_vap->m2u;
+    hi_u8 dst_mac[HMAC_M2U_MEMBER_MAX_NUM][WLAN_MAC_ADDR_LEN];
+    mac_ether_header_stru *ether_hdr = (mac_ether_header_stru *)oal_netbuf_data(netbuf);
+    hi_u8 idx;
+    hi_u8 num = 0;
+    hi_u8 src_user_idx = MAC_INVALID_USER_ID;
+
+    if ((m2u->snoop_on == HI_FALSE) || !ether_is_multicast(ether_hdr->auc_ether_dhost) ||
+        ether_is_broadcast(ether_hdr->auc_ether_dhost)) {
+        return HI_CONTINUE;
+    }
+
+    /* 源地址为本VAP关联STA时为空口间中继报文,否则来自有线侧主机或AP自身 */
+    if (mac_vap_find_user_by_macaddr(hmac_vap->base_vap, ether_hdr->auc_ether_shost, WLAN_MAC_ADDR_LEN,
+        &src_user_idx) != HI_SUCCESS) {
+        src_user_idx = MAC_INVALID_USER_ID;
+    }
+
+    /* 仅抑制由关联STA上报并经AP中继的report,有线侧主机及AP自身的report照常发送 */
+    if ((src_user_idx != MAC_INVALID_USER_ID) && hmac_m2u_is_suppressible_report(netbuf)) {
+        oal_netbuf_free(netbuf);
+        return HI_SUCCESS;
+    }
+
+    /* 锁内只查表并拷贝成员mac地址,发送在锁外进行 */
+    oal_spin_lock_bh(&m2u->lock);
+    hi_u32 ret = hmac_m2u_get_dst_list(hmac_vap, ether_hdr->auc_ether_dhost, src_user_idx, dst_mac, &num);
+    oal_spin_unlock_bh(&m2u->lock);
+    if (ret != HI_SUCCESS) {
+        return ret;
+    }
+
+    if (num == 0) {
+        /* 源STA是组内唯一成员时无需回送,直接丢弃 */
+        oal_netbuf_free(netbuf);
+        return HI_SUCCESS;
+    }
+
+    /* 前num-1个成员发送拷贝,原报文发给最后一个成员 */
+    for (idx = 0; idx < num - 1; idx++) {
+        oal_netbuf_stru *copy = hmac_m2u_copy_netbuf(netbuf);
+        if (copy == HI_NULL) {
+            oam_warning_log1(hmac_vap->base_vap->vap_id, OAM_SF_M2U,
+                "{hmac_m2u_convert::copy netbuf failed, member[%d].}", idx);
+            break;
+        }
+
+        mac_ether_header_stru *copy_hdr = (mac_ether_header_stru *)oal_netbuf_data(copy);
+        if ((memcpy_s(copy_hdr->auc_ether_dhost, ETHER_ADDR_LEN, dst_mac[idx], WLAN_MAC_ADDR_LEN) != EOK) ||
+            (hmac_tx_lan_to_wlan(hmac_vap->base_vap, copy) != HI_SUCCESS)) {
+            oal_netbuf_free(copy);
+        }
+    }
+
+    if (memcpy_s(ether_hdr->auc_ether_dhost, ETHER_ADDR_LEN, dst_mac[num - 1], WLAN_MAC_ADDR_LEN) != EOK) {
+        return HI_FAIL;
+    }
+
+    return hmac_tx_lan_to_wlan(hmac_vap->base_vap, netbuf);
+}
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2021 HiSilicon (Shanghai) Technologies CO., LIMITED.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef __HMAC_M2U_H__
+#define __HMAC_M2U_H__
+
+/* ****************************************************************************
+   其他头文件包含
+**************************************************************************** */
+#include "oal_ext_if.h"
+#include "mac_vap.h"
+#include "hmac_vap.h"
+
+#ifdef __cplusplus
+#if __cplusplus
+extern "C" {
+#endif
+#endif
+
+/* ****************************************************************************
+   宏定义
+*****************************************************************************/
+#define HMAC_M2U_DEFAULT_MAX_MEMBER     4           /* 默认转单播的成员数门限 */
+#define HMAC_M2U_MEMBER_AGING_MS        260000      /* 成员老化时间, 与IGMP Group Membership Interval一致 */
+
+/* ****************************************************************************
+  函数声明
+**************************************************************************** */
+hi_void hmac_m2u_init(hmac_vap_stru *hmac_vap);
+hi_void hmac_m2u_set_snoop(hmac_vap_stru *hmac_vap, hi_u8 snoop_on, hi_u8 max_member);
+hi_void hmac_m2u_snoop_inspecting(mac_vap_stru *mac_vap, const hi_u8 *ta, const oal_netbuf_stru *netbuf);
+hi_void hmac_m2u_del_user(const mac_vap_stru *mac_vap, hi_u8 user_idx);
+hi_u32 hmac_m2u_convert(hmac_vap_stru *hmac_vap, oal_netbuf_stru *netbuf);
+
+#ifdef __cplusplus
+#if __cplusplus
+}
+#endif
+#endif
+#endif /* __HMAC_M2U_H__ */
@@ -200,15 +200,6 @@ hi_u32 hmac_main_init(hi_void)
         frw_timer_delete_all_timer();
         return HI_FAIL;
     }
-#if (_PRE_MULTI_CORE_MODE_OFFLOAD_DMAC == _PRE_MULTI_CORE_MODE)
-    return_code = mac_res_init();
-    if (return_code != HI_SUCCESS) {
-        oam_error_log1(0, OAM_SF_ANY, "hmac_main_init: mac_res_init return err code %d.", return_code);
-        frw_timer_delete_all_timer();
-        return HI_FAIL;
-    }
-#endif
-
     /* 如果初始化状态处于配置VAP成功前的状态，表明此次为HMAC第一次初始化，即重加载或启动初始化 */
     if (init_state < FRW_INIT_STATE_HMAC_CONFIG_VAP_SUCC) {
         /* 事件注册 */
@@ -265,7 +256,6 @@ hi_void hmac_main_exit(hi_void)
         oam_warning_log1(0, OAM_SF_ANY, "{hmac_main_exit::hmac_device_exit failed[%d].}", return_code);
         return;
     }
-    mac_res_exit();
 #if (_PRE_MULTI_CORE_MODE_OFFLOAD_DMAC == _PRE_MULTI_CORE_MODE)
     frw_set_init_state(FRW_INIT_STATE_FRW_SUCC);
 #else
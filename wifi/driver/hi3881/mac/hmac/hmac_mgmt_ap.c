@@ -55,8 +55,8 @@ extern "C" {
 /* ****************************************************************************
   2 全局变量定义
 **************************************************************************** */
-static hi_u32 hmac_ap_up_update_sta_sup_rates(hi_u8 *puc_payload, hmac_user_stru *hmac_user,
-    mac_status_code_enum_uint16 *pen_status_code, const hmac_sup_rates_info_stru *sup_rates_info);
+static hi_u32 hmac_ap_up_update_sta_sup_rates(const mac_ie_index_stru *ie_index, hmac_user_stru *hmac_user,
+    mac_status_code_enum_uint16 *pen_status_code, hi_u16 *pus_msg_idx);
 static hi_u32 hmac_ap_prepare_assoc_req(hmac_user_stru *hmac_user, const hi_u8 *puc_payload, hi_u32 payload_len,
     hi_u8 mgmt_frm_type);
 #ifdef _PRE_WLAN_FEATURE_MESH
@@ -556,10 +556,8 @@ hi_void hmac_resort_rates_info(hmac_user_stru *hmac_user, const hi_u8 *puc_ext_s
 
 /* ****************************************************************************
  功能描述  : 检查更新AP侧关联STA的速率信息
- 输入参数  : hi_u8                     *puc_payload    -- 关联帧帧体内容指针
-             hi_u32                     ul_msg_len     -- 关联帧帧体长度
+ 输入参数  : mac_ie_index_stru         *ie_index       -- 关联帧IE索引表
              hmac_user_stru                *pst_hmac_user  -- 关联用户的结构体指针
-             hi_u16                    *pus_msg_idx    -- 关联帧帧体偏移索引
  输出参数  : wlan_status_code_enum_uint16  *pen_status_code-- 关联状态码
              hi_u8                     *puc_num_rates  -- 关联用户的速率个数
              hi_u16                    *pus_msg_idx    -- 关联帧帧体偏移索引
@@ -569,8 +567,8 @@ hi_void hmac_resort_rates_info(hmac_user_stru *hmac_user, const hi_u8 *puc_ext_s
     作    者   : HiSilicon
     修改内容   : 新生成函数
 **************************************************************************** */
-static hi_u32 hmac_ap_up_update_sta_sup_rates(hi_u8 *puc_payload, hmac_user_stru *hmac_user,
-    mac_status_code_enum_uint16 *pen_status_code, const hmac_sup_rates_info_stru *sup_rates_info)
+static hi_u32 hmac_ap_up_update_sta_sup_rates(const mac_ie_index_stru *ie_index, hmac_user_stru *hmac_user,
+    mac_status_code_enum_uint16 *pen_status_code, hi_u16 *pus_msg_idx)
 {
     hi_u8 uc_num_rates = 0;
     hi_u32 loop;
@@ -588,10 +586,7 @@ static hi_u32 hmac_ap_up_update_sta_sup_rates(hi_u8 *puc_payload, hmac_user_stru
         return HI_ERR_CODE_PTR_NULL;
     }
 
-    if (sup_rates_info->msg_len > sup_rates_info->us_offset) {
-        puc_sup_rates_ie = mac_find_ie(MAC_EID_RATES, puc_payload + sup_rates_info->us_offset,
-            (sup_rates_info->msg_len - sup_rates_info->us_offset));
-    }
+    puc_sup_rates_ie = mac_ie_index_find(ie_index, MAC_IE_IDX_RATES);
     if (puc_sup_rates_ie == HI_NULL) {
         *pen_status_code = MAC_UNSUP_RATE;
         oam_error_log0(mac_user->vap_id, OAM_SF_ANY, "{hmac_ap_up_update_sta_user::puc_ie null.}");
@@ -602,7 +597,7 @@ static hi_u32 hmac_ap_up_update_sta_sup_rates(hi_u8 *puc_payload, hmac_user_stru
         /* 如果速率个数为0或超过最大支持速率 ，直接返回失败 */
         if (uc_num_rates == 0 || uc_num_rates > WLAN_MAX_SUPP_RATES) {
             *pen_status_code = MAC_UNSUP_RATE;
-            *(sup_rates_info->pus_msg_idx) = us_msg_idx;
+            *pus_msg_idx = us_msg_idx;
             oam_error_log0(mac_user->vap_id, OAM_SF_ANY,
                 "{hmac_ap_up_update_sta_sup_rates::the sta's rates are not supported.}");
             return HI_FAIL;
@@ -619,11 +614,8 @@ static hi_u32 hmac_ap_up_update_sta_sup_rates(hi_u8 *puc_payload, hmac_user_stru
         hmac_user->op_rates.rs_nrates = uc_num_rates;
     }
 
-    if (sup_rates_info->msg_len > sup_rates_info->us_offset) {
-        /* 如果存在扩展速率 */
-        puc_ext_sup_rates_ie = mac_find_ie(MAC_EID_XRATES, puc_payload + sup_rates_info->us_offset,
-            (sup_rates_info->msg_len - sup_rates_info->us_offset));
-    }
+    /* 如果存在扩展速率 */
+    puc_ext_sup_rates_ie = mac_ie_index_find(ie_index, MAC_IE_IDX_XRATES);
 
     hmac_resort_rates_info(hmac_user, puc_ext_sup_rates_ie, uc_num_rates);
 
@@ -632,7 +624,7 @@ static hi_u32 hmac_ap_up_update_sta_sup_rates(hi_u8 *puc_payload, hmac_user_stru
     **************************************************************** */
     hmac_check_sta_base_rate((hi_u8 *)hmac_user, pen_status_code);
 
-    *(sup_rates_info->pus_msg_idx) = us_msg_idx;
+    *pus_msg_idx = us_msg_idx;
     return HI_SUCCESS;
 }
 
@@ -764,14 +756,12 @@ static hi_u32 hmac_chk_assoc_req_sec_cap_auth_encry(const mac_vap_stru *mac_vap,
  功能描述  : AP 检查接收到的ASOC REQ消息中的SECURITY参数.如出错,则返回对应的错
              误码
  输入参数  : [1]hmac_vap
-             [2]puc_mac_hdr
-             [3]puc_payload
-             [4]msg_len
-             [5]hmac_user
-             [6]pen_status_code
+             [2]ie_index
+             [3]hmac_user
+             [4]pen_status_code
  返 回 值  : static hi_u8
 **************************************************************************** */
-static hi_u32 hmac_chk_assoc_req_sec_cap_auth(const hmac_vap_stru *vap, const hi_u8 *hdr, hi_u8 *payload, hi_u32 len,
+static hi_u32 hmac_chk_assoc_req_sec_cap_auth(const hmac_vap_stru *vap, const mac_ie_index_stru *ie_index,
     const hmac_user_stru *user, mac_status_code_enum_uint16 *status)
 {
     hi_u8 pcip_policy = WLAN_80211_CIPHER_SUITE_NO_ENCRYP;
@@ -790,16 +780,9 @@ static hi_u32 hmac_chk_assoc_req_sec_cap_auth(const hmac_vap_stru *vap, const hi
         return HI_SUCCESS;
     }
 
-    hi_u8 offset = MAC_CAP_INFO_LEN + MAC_LIS_INTERVAL_IE_LEN;
-    if (mac_get_frame_sub_type(hdr) == WLAN_FC0_SUBTYPE_REASSOC_REQ) {
-        offset += OAL_MAC_ADDR_LEN;
-    }
-    if (len > offset) {
-        /* 获取RSNA和WPA IE信息 */
-        puc_rsn_ie = mac_find_ie(MAC_EID_RSN, payload + offset, (len - offset));
-        puc_wpa_ie = mac_find_vendor_ie(MAC_WLAN_OUI_MICROSOFT, MAC_OUITYPE_WPA, payload + offset,
-            (hi_s32)(len - offset));
-    }
+    /* 获取RSNA和WPA IE信息 */
+    puc_rsn_ie = mac_ie_index_find(ie_index, MAC_IE_IDX_RSN);
+    puc_wpa_ie = mac_ie_index_find(ie_index, MAC_IE_IDX_WPA);
 
     if ((puc_rsn_ie == HI_NULL) && (puc_wpa_ie == HI_NULL)) {
         /* 加密方式不是WPA/WPA2， 则判断是否为WEP */
@@ -972,7 +955,6 @@ hi_u32 hmac_sta_ssid_and_sup_rate_proc(const hmac_update_sta_user_info_stru *upd
     hmac_user_stru *hmac_user, mac_status_code_enum_uint16 *status_code, mac_vap_stru *mac_vap, hi_u16 *msg_idx)
 {
     mac_cfg_ssid_param_stru cfg_ssid;
-    hmac_sup_rates_info_stru sup_rates;
     hi_u16 us_rate_len = 0;
 
 #ifdef _PRE_WLAN_FEATURE_MESH
@@ -1010,10 +992,7 @@ hi_u32 hmac_sta_ssid_and_sup_rate_proc(const hmac_update_sta_user_info_stru *upd
 #endif
 
     /* 当前用户已关联 */
-    sup_rates.msg_len     = update_sta_user->msg_len;
-    sup_rates.us_offset   = *msg_idx;
-    sup_rates.pus_msg_idx = &us_rate_len;
-    hi_u32 rslt = hmac_ap_up_update_sta_sup_rates(update_sta_user->puc_payload, hmac_user, status_code, &sup_rates);
+    hi_u32 rslt = hmac_ap_up_update_sta_sup_rates(update_sta_user->ie_index, hmac_user, status_code, &us_rate_len);
     if (rslt != HI_SUCCESS) {
         oam_warning_log2(mac_vap->vap_id, OAM_SF_ASSOC,
             "{hmac_ap_up_update_sta_user::AP refuse STA assoc,update rates Err=%d,status_code=%d}", rslt, *status_code);
@@ -1041,8 +1020,7 @@ hi_u32 hmac_sta_several_param_proc(const hmac_vap_stru *hmac_vap, const hmac_upd
     } else {
 #endif
         /* 检查接收到的ASOC REQ消息中的SECURITY参数.如出错,则返回对应的错误码 */
-        hi_u32 ret = hmac_chk_assoc_req_sec_cap_auth(hmac_vap, sta_user->puc_mac_hdr, sta_user->puc_payload,
-            sta_user->msg_len, hmac_user, status_code);
+        hi_u32 ret = hmac_chk_assoc_req_sec_cap_auth(hmac_vap, sta_user->ie_index, hmac_user, status_code);
         if (ret != HI_SUCCESS) {
             oam_warning_log1(hmac_vap->base_vap->vap_id, OAM_SF_ASSOC, "{hmac_ap_up_update_sta_user::Err=%d}", ret);
             return HI_FAIL;
@@ -1078,8 +1056,7 @@ hi_u32 hmac_sta_several_param_proc(const hmac_vap_stru *hmac_vap, const hmac_upd
 
     if (sta_user->msg_len > sta_check->offset) {
         /* 查找RSN信息元素,如果没有RSN信息元素,则按照不支持处理 */
-        ie = mac_find_ie(MAC_EID_RSN, sta_user->puc_payload + sta_check->offset,
-            (sta_user->msg_len - sta_check->offset));
+        ie = mac_ie_index_find(sta_user->ie_index, MAC_IE_IDX_RSN);
         /* 根据RSN信息元素, 判断RSN能力是否匹配 */
         if (hmac_check_rsn_capability(hmac_vap->base_vap, ie, status_code) != HI_SUCCESS) {
             return HI_FAIL;
@@ -1154,6 +1131,49 @@ hi_u32 hmac_sta_protocol_bandwidth_proc(const hmac_vap_stru *hmac_vap, const hma
     return HI_SUCCESS;
 }
 
+/* ****************************************************************************
+ 功能描述  : 获取(重)关联请求帧或Mesh Peering帧帧体中IE区的起始偏移
+**************************************************************************** */
+static hi_u16 hmac_ap_get_asoc_ie_offset(const hi_u8 *puc_mac_hdr, const hi_u8 *puc_payload)
+{
+    hi_u16 offset = MAC_CAP_INFO_LEN + MAC_LISTEN_INT_LEN;
+    hi_u8 sub_type = mac_get_frame_sub_type(puc_mac_hdr);
+
+#ifdef _PRE_WLAN_FEATURE_MESH
+    if (sub_type == WLAN_FC0_SUBTYPE_ACTION) {
+        /* Mesh关联采用Self_protected Action帧，Peering Confirm帧中Cap后为AID */
+        offset = MAC_ACTION_CATEGORY_LEN + MAC_ACTION_CODE_LEN + MAC_CAP_INFO_LEN;
+        if ((mac_get_action_category(puc_payload) == MAC_ACTION_CATEGORY_SELF_PROTECTED) &&
+            (mac_get_action_code(puc_payload) == MAC_SP_ACTION_MESH_PEERING_CONFIRM)) {
+            offset += MAC_AID_LEN;
+        }
+    }
+#else
+    hi_unref_param(puc_payload);
+#endif
+
+    if (sub_type == WLAN_FC0_SUBTYPE_REASSOC_REQ) {
+        /* 重关联比关联请求帧头多了AP的MAC地址  */
+        offset += WLAN_MAC_ADDR_LEN;
+    }
+    return offset;
+}
+
+/* ****************************************************************************
+ 功能描述  : 单次遍历关联请求帧的IE区建立索引，供速率、安全、RSN能力及P2P等解析共用
+**************************************************************************** */
+static hi_void hmac_ap_build_asoc_ie_index(const hi_u8 *puc_mac_hdr, hi_u8 *puc_payload, hi_u32 payload_len,
+    mac_ie_index_stru *ie_index)
+{
+    hi_u16 offset = hmac_ap_get_asoc_ie_offset(puc_mac_hdr, puc_payload);
+
+    if (payload_len > offset) {
+        mac_ie_build_index(ie_index, puc_payload + offset, payload_len - offset);
+    } else {
+        mac_ie_build_index(ie_index, HI_NULL, 0);
+    }
+}
+
 /* ****************************************************************************
  功能描述  : AP侧更新STA信息
   1.日    期   : 2013年7月3日
@@ -1167,7 +1187,7 @@ static hi_u32 hmac_ap_up_update_sta_user(const hmac_vap_stru *hmac_vap, const hm
     hmac_user_stru *hmac_user, mac_status_code_enum_uint16 *status_code)
 {
     hi_u16 msg_idx = 0;
-    hi_u16 offset = MAC_CAP_INFO_LEN + MAC_LISTEN_INT_LEN;
+    hi_u16 offset = hmac_ap_get_asoc_ie_offset(update->puc_mac_hdr, update->puc_payload);
     mac_vap_stru *mac_vap = hmac_vap->base_vap;
 
     *status_code = MAC_SUCCESSFUL_STATUSCODE;
@@ -1175,7 +1195,6 @@ static hi_u32 hmac_ap_up_update_sta_user(const hmac_vap_stru *hmac_vap, const hm
 #ifdef _PRE_WLAN_FEATURE_MESH
     if (mac_get_frame_sub_type(update->puc_mac_hdr) == WLAN_FC0_SUBTYPE_ACTION) {
         /* Mesh关联采用Self_protected Action帧，帧结构不同 */
-        offset = MAC_ACTION_CATEGORY_LEN + MAC_ACTION_CODE_LEN + MAC_CAP_INFO_LEN;
         msg_idx += MAC_ACTION_CATEGORY_LEN + MAC_ACTION_CODE_LEN;
     }
 #endif
@@ -1198,7 +1217,6 @@ static hi_u32 hmac_ap_up_update_sta_user(const hmac_vap_stru *hmac_vap, const hm
         (mac_get_action_code(update->puc_payload) == MAC_SP_ACTION_MESH_PEERING_CONFIRM)) {
         /* Mesh Peering Confirm帧中Cap后为AID */
         msg_idx += MAC_AID_LEN;
-        offset += MAC_AID_LEN;
     }
 #else
     msg_idx += MAC_LIS_INTERVAL_IE_LEN;
@@ -1207,7 +1225,6 @@ static hi_u32 hmac_ap_up_update_sta_user(const hmac_vap_stru *hmac_vap, const hm
     if (mac_get_frame_sub_type(update->puc_mac_hdr) == WLAN_FC0_SUBTYPE_REASSOC_REQ) {
         /* 重关联比关联请求帧头多了AP的MAC地址  */
         msg_idx += WLAN_MAC_ADDR_LEN;
-        offset += WLAN_MAC_ADDR_LEN;
     }
 
     hi_u32 rslt = hmac_sta_ssid_and_sup_rate_proc(update, hmac_user, status_code, mac_vap, &msg_idx);
@@ -1346,14 +1363,10 @@ static hi_u32 hmac_ap_asoc_pmf_process(const hmac_vap_stru *hmac_vap, hmac_user_
 }
 
 #ifdef _PRE_WLAN_FEATURE_P2P
-static hi_void hmac_ap_asoc_p2p_process(const hmac_vap_stru *hmac_vap, hi_u8 mgmt_frm_type, hi_u32 payload_len,
-    hi_u8 *puc_payload, const hmac_user_stru *hmac_user)
+static hi_void hmac_ap_asoc_p2p_process(const hmac_vap_stru *hmac_vap, hi_u32 payload_len,
+    const mac_ie_index_stru *ie_index, const hmac_user_stru *hmac_user)
 {
-        hi_s32 l_len = ((mgmt_frm_type == WLAN_FC0_SUBTYPE_REASSOC_REQ) ? (MAC_CAP_INFO_LEN + MAC_LISTEN_INT_LEN +
-                                               WLAN_MAC_ADDR_LEN) : (MAC_CAP_INFO_LEN + MAC_LISTEN_INT_LEN));
-        if (is_p2p_go(hmac_vap->base_vap) &&
-            (HI_NULL == mac_find_vendor_ie(MAC_WLAN_OUI_WFA, MAC_WLAN_OUI_TYPE_WFA_P2P, puc_payload + l_len,
-                (hi_s32) payload_len - l_len))) {
+        if (is_p2p_go(hmac_vap->base_vap) && (mac_ie_index_find(ie_index, MAC_IE_IDX_P2P) == HI_NULL)) {
             oam_info_log1(hmac_user->base_user->vap_id, OAM_SF_ASSOC,
                           "{hmac_ap_up_rx_asoc_req::GO got assoc request from legacy device, length = [%d]}",
                           payload_len);
@@ -1365,12 +1378,16 @@ static hi_void hmac_ap_asoc_p2p_process(const hmac_vap_stru *hmac_vap, hi_u8 mgm
 static hi_u32 hmac_ap_asoc_req_process(hmac_ap_asoc_req_stru asoc_req, hmac_ap_asoc_info_stru asoc_info)
 {
     hi_u32 rslt;
+    mac_ie_index_stru ie_index;
     hmac_update_sta_user_info_stru update_sta_user_info = {
         .puc_mac_hdr = asoc_req.puc_mac_hdr,
         .puc_payload = asoc_req.puc_payload,
-        .msg_len = asoc_req.payload_len
+        .msg_len = asoc_req.payload_len,
+        .ie_index = &ie_index
     };
 
+    hmac_ap_build_asoc_ie_index(asoc_req.puc_mac_hdr, asoc_req.puc_payload, asoc_req.payload_len, &ie_index);
+
     rslt = hmac_ap_asoc_pmf_process(asoc_req.hmac_vap, asoc_info.hmac_user, asoc_info.status_code);
     if (rslt != HI_SUCCESS) {
         oam_error_log0(0, OAM_SF_ASSOC, "hmac_ap_asoc_pmf_process fail");
@@ -1419,8 +1436,7 @@ static hi_u32 hmac_ap_asoc_req_process(hmac_ap_asoc_req_stru asoc_req, hmac_ap_a
                 MAC_USER_STATE_AUTH_COMPLETE);
         }
 #ifdef _PRE_WLAN_FEATURE_P2P
-        hmac_ap_asoc_p2p_process(asoc_req.hmac_vap, asoc_req.mgmt_frm_type, asoc_req.payload_len,
-            asoc_req.puc_payload, asoc_info.hmac_user);
+        hmac_ap_asoc_p2p_process(asoc_req.hmac_vap, asoc_req.payload_len, &ie_index, asoc_info.hmac_user);
 #endif
     }
 
@@ -2004,6 +2020,7 @@ static hi_u32 hmac_mesh_up_rx_confirm_action(const hmac_vap_stru *hmac_vap, hmac
     hi_u8 *puc_mac_hdr, hi_u8 *puc_payload, hi_u32 payload_len)
 {
     hmac_update_sta_user_info_stru update_sta_user_info;
+    mac_ie_index_stru ie_index;
     hi_u32 rslt;
     mac_user_stru *mac_user = hmac_user->base_user;
 
@@ -2025,6 +2042,8 @@ static hi_u32 hmac_mesh_up_rx_confirm_action(const hmac_vap_stru *hmac_vap, hmac
     update_sta_user_info.puc_mac_hdr = puc_mac_hdr;
     update_sta_user_info.puc_payload = puc_payload;
     update_sta_user_info.msg_len = payload_len;
+    update_sta_user_info.ie_index = &ie_index;
+    hmac_ap_build_asoc_ie_index(puc_mac_hdr, puc_payload, payload_len, &ie_index);
 
     mac_status_code_enum_uint16 status_code = MAC_SUCCESSFUL_STATUSCODE;
     rslt = hmac_ap_up_update_sta_user(hmac_vap, &update_sta_user_info, hmac_user, &status_code);
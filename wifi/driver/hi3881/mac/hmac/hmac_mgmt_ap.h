@@ -38,19 +38,11 @@ extern "C" {
 #define is_wep_cipher(uc_cipher) \
     ((WLAN_80211_CIPHER_SUITE_WEP_40 == (uc_cipher)) || (WLAN_80211_CIPHER_SUITE_WEP_104 == (uc_cipher)))
 
-typedef struct hmac_sup_rates_info_stru {
-    hi_u32 msg_len;
-
-    hi_u16 us_offset;
-    hi_u16 us_rsvd;
-
-    hi_u16 *pus_msg_idx;
-} hmac_sup_rates_info_stru;
-
 typedef struct hmac_update_sta_user_info_stru {
     hi_u8 *puc_mac_hdr;
     hi_u8 *puc_payload;
     hi_u32 msg_len;
+    const mac_ie_index_stru *ie_index;  /* 帧体IE区索引表，各IE解析共用 */
 } hmac_update_sta_user_info_stru;
 
 typedef struct hmac_sta_check_info {
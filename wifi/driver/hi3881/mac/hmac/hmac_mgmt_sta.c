@@ -1294,7 +1294,7 @@ hi_u8 *hmac_sta_find_ie_in_probe_rsp(const mac_vap_stru *mac_vap, hi_u8 eid, hi_
     修改内容   : 新生成函数
 **************************************************************************** */
 hi_void hmac_sta_check_ht_cap_ie(const mac_vap_stru *mac_sta, hi_u8 *puc_payload, mac_user_stru *mac_user_ap,
-    hi_u16 *pus_amsdu_maxsize, hi_u16 us_payload_len)
+    hi_u16 *pus_amsdu_maxsize, const mac_ie_index_stru *ie_index)
 {
     hi_u8 *puc_ie = HI_NULL;
     hi_u8 *puc_payload_for_ht_cap_chk = HI_NULL;
@@ -1305,7 +1305,7 @@ hi_void hmac_sta_check_ht_cap_ie(const mac_vap_stru *mac_sta, hi_u8 *puc_payload
         return;
     }
 
-    puc_ie = mac_find_ie(MAC_EID_HT_CAP, puc_payload, us_payload_len);
+    puc_ie = mac_ie_index_find(ie_index, MAC_IE_IDX_HT_CAP);
     if (puc_ie == HI_NULL || puc_ie[1] < MAC_HT_CAP_LEN) {
         puc_payload_for_ht_cap_chk = hmac_sta_find_ie_in_probe_rsp(mac_sta, MAC_EID_HT_CAP, &us_ht_cap_index);
         if (puc_payload_for_ht_cap_chk == HI_NULL) {
@@ -1348,13 +1348,13 @@ hi_void hmac_sta_check_ht_cap_ie(const mac_vap_stru *mac_sta, hi_u8 *puc_payload
     作    者   : HiSilicon
     修改内容   : 新生成函数
 **************************************************************************** */
-hi_void hmac_sta_check_ext_cap_ie(const mac_vap_stru *mac_sta, hi_u8 *puc_payload, hi_u16 us_rx_len)
+hi_void hmac_sta_check_ext_cap_ie(const mac_vap_stru *mac_sta, hi_u8 *puc_payload, const mac_ie_index_stru *ie_index)
 {
     hi_u8 *puc_ie = HI_NULL;
     hi_u8 *puc_payload_proc = HI_NULL;
     hi_u16 us_index;
 
-    puc_ie = mac_find_ie(MAC_EID_EXT_CAPS, puc_payload, us_rx_len);
+    puc_ie = mac_ie_index_find(ie_index, MAC_IE_IDX_EXT_CAPS);
     if (puc_ie == HI_NULL || puc_ie[1] < MAC_XCAPS_LEN) {
         puc_payload_proc = hmac_sta_find_ie_in_probe_rsp(mac_sta, MAC_EID_EXT_CAPS, &us_index);
         if (puc_payload_proc == HI_NULL) {
@@ -1427,14 +1427,14 @@ hi_void hmac_sta_check_obss_scan_ie(const mac_vap_stru *mac_sta, hi_u8 *puc_payl
     修改内容   : 新生成函数
 **************************************************************************** */
 hi_u32 hmac_sta_check_ht_opern_ie(mac_vap_stru *mac_sta, mac_user_stru *mac_user_ap, hi_u8 *puc_payload,
-    hi_u16 us_rx_len)
+    const mac_ie_index_stru *ie_index)
 {
     hi_u8 *puc_ie = HI_NULL;
     hi_u8 *puc_payload_proc = HI_NULL;
     hi_u16 us_index;
     hi_u32 change = MAC_NO_CHANGE;
 
-    puc_ie = mac_find_ie(MAC_EID_HT_OPERATION, puc_payload, us_rx_len);
+    puc_ie = mac_ie_index_find(ie_index, MAC_IE_IDX_HT_OPERATION);
     if (puc_ie == HI_NULL || puc_ie[1] < MAC_HT_OPERN_LEN) {
         puc_payload_proc = hmac_sta_find_ie_in_probe_rsp(mac_sta, MAC_EID_HT_OPERATION, &us_index);
         if (puc_payload_proc == HI_NULL) {
@@ -1471,7 +1471,7 @@ hi_u32 hmac_ie_check_ht_sta(mac_vap_stru *mac_sta, const hmac_check_ht_sta_info_
 {
     hi_u32 change = MAC_NO_CHANGE;
     hi_u8 *puc_ie_payload_start = HI_NULL;
-    hi_u16 us_ie_payload_len;
+    mac_ie_index_stru ie_index;
 
     if ((mac_sta == HI_NULL) || (check_ht_sta_info->puc_payload == HI_NULL) || (mac_user_ap == HI_NULL)) {
         return change;
@@ -1491,13 +1491,15 @@ hi_u32 hmac_ie_check_ht_sta(mac_vap_stru *mac_sta, const hmac_check_ht_sta_info_
             check_ht_sta_info->us_rx_len, check_ht_sta_info->us_offset);
         return change;
     }
-    us_ie_payload_len = check_ht_sta_info->us_rx_len - check_ht_sta_info->us_offset;
+    /* HT cap/ext cap/HT opern共用一次IE遍历的结果 */
+    mac_ie_build_index(&ie_index, puc_ie_payload_start,
+        (hi_u32)(check_ht_sta_info->us_rx_len - check_ht_sta_info->us_offset));
 
-    hmac_sta_check_ht_cap_ie(mac_sta, puc_ie_payload_start, mac_user_ap, pus_amsdu_maxsize, us_ie_payload_len);
+    hmac_sta_check_ht_cap_ie(mac_sta, puc_ie_payload_start, mac_user_ap, pus_amsdu_maxsize, &ie_index);
 
-    hmac_sta_check_ext_cap_ie(mac_sta, puc_ie_payload_start, us_ie_payload_len);
+    hmac_sta_check_ext_cap_ie(mac_sta, puc_ie_payload_start, &ie_index);
 
-    change = hmac_sta_check_ht_opern_ie(mac_sta, mac_user_ap, puc_ie_payload_start, us_ie_payload_len);
+    change = hmac_sta_check_ht_opern_ie(mac_sta, mac_user_ap, puc_ie_payload_start, &ie_index);
 
     return change;
 }
@@ -1711,6 +1713,7 @@ hi_void hmac_sta_wait_asoc_rx_complete_handle(hmac_vap_stru *hmac_vap, hi_u8 use
     hmac_fsm_change_state(hmac_vap, MAC_VAP_STATE_UP);
     /* 将用户(AP)在本地的状态信息设置为已关联状态 */
     mac_user_set_asoc_state(hmac_user_ap->base_user, MAC_USER_STATE_ASSOC);
+    hmac_user_invalidate_tx_hdr_template(hmac_user_ap);
 
     /* dmac offload架构下，同步STA USR信息到dmac */
     rslt = hmac_config_user_cap_syn(hmac_vap->base_vap, mac_user_ap);
@@ -35,12 +35,16 @@
 #include "hmac_mgmt_bss_comm.h"
 #include "hcc_hmac_if.h"
 #include "wal_cfg80211_apt.h"
+#include "net_adpater.h"
 #ifdef _PRE_WLAN_FEATURE_WAPI
 #include "hmac_wapi.h"
 #endif
 #ifdef _PRE_WLAN_FEATURE_EDCA_OPT_AP
 #include "hmac_edca_opt.h"
 #endif
+#ifdef _PRE_WLAN_FEATURE_M2U
+#include "hmac_m2u.h"
+#endif
 #ifdef _PRE_HDF_LINUX
 #include <linux/netdevice.h>
 #endif
@@ -549,9 +553,14 @@ static hi_void hmac_rx_transmit_msdu_to_lan(const hmac_vap_stru *hmac_vap, hmac_
 
     if (HI_SUCCESS != hmac_11i_ether_type_filter(hmac_vap, mac_addr, ether_hdr->us_ether_type)) {
         /* 接收安全数据过滤 */
+        wal_netdev_stats_rx_drop(hmac_vap->base_vap->vap_id, WAL_NETDEV_DROP_OTHER);
         oal_netbuf_free(netbuf);
         return;
     }
+#endif
+#ifdef _PRE_WLAN_FEATURE_M2U
+    /* 侦听STA发出的IGMP/MLD报文，更新组播转单播成员表 */
+    hmac_m2u_snoop_inspecting(hmac_vap->base_vap, msdu->auc_ta, netbuf);
 #endif
     /* 获取net device hmac创建的时候，需要记录netdevice指针 */
     oal_net_device_stru *netdev = hmac_vap->net_device;
@@ -561,6 +570,7 @@ static hi_void hmac_rx_transmit_msdu_to_lan(const hmac_vap_stru *hmac_vap, hmac_
 
 #ifdef _PRE_WLAN_FEATURE_EDCA_OPT_AP
     if (hmac_rx_transmit_edca_opt_ap(hmac_vap, ether_hdr) != HI_SUCCESS) {
+        wal_netdev_stats_rx_drop(hmac_vap->base_vap->vap_id, WAL_NETDEV_DROP_OTHER);
         oal_netbuf_free(netbuf);
         return;
     }
@@ -583,6 +593,9 @@ static hi_void hmac_rx_transmit_msdu_to_lan(const hmac_vap_stru *hmac_vap, hmac_
     netbuf->dev = (struct net_device *)netdev;
 #endif
 
+    /* 交给协议栈后netbuf不再归本驱动所有，先统计 */
+    wal_netdev_stats_rx(hmac_vap->base_vap->vap_id, wlan_wme_tid_to_ac(msdu->priority), oal_netbuf_len(netbuf));
+
     if (HI_TRUE == hmac_get_rxthread_enable()) {
         hmac_rxdata_netbuf_enqueue(netbuf);
 
@@ -601,6 +614,11 @@ hi_void hmac_rx_msdu_frame_classify(const hmac_vap_stru *hmac_vap, oal_netbuf_st
     hi_u8 *mac_addr = HI_NULL;
     hmac_rx_ctl_stru *rx_ctrl = (hmac_rx_ctl_stru *)oal_netbuf_cb(netbuf);
 
+    /* 去分片/解密前帧头仍有效，记录优先级供统计按AC归类 */
+    if (frame_hdr->frame_control.sub_type == WLAN_QOS_DATA) {
+        msdu->priority = mac_get_tid_value((hi_u8 *)frame_hdr, mac_is_4addr((hi_u8 *)frame_hdr));
+    }
+
 #ifdef _PRE_WLAN_FEATURE_WAPI
     hi_bool pairwise = !ether_is_multicast(frame_hdr->auc_address1);
     hmac_wapi_stru *wapi = hmac_user_get_wapi_ptr(hmac_vap->base_vap, pairwise, hmac_user->base_user->us_assoc_id);
@@ -726,6 +744,7 @@ hi_u32 hmac_rx_copy_netbuff(oal_netbuf_stru **dest_netbuf, const oal_netbuf_stru
     *dest_netbuf = oal_netbuf_alloc(WLAN_LARGE_NETBUF_SIZE, 0, 4); /* align 4 */
     if (oal_unlikely(*dest_netbuf == HI_NULL)) {
         oam_warning_log0(vap_id, OAM_SF_RX, "{hmac_rx_copy_netbuff::pst_netbuf_copy null.}");
+        wal_netdev_stats_rx_drop(vap_id, WAL_NETDEV_DROP_NOMEM);
         return HI_ERR_CODE_ALLOC_MEM_FAIL;
     }
 
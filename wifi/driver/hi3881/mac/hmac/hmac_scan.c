@@ -72,10 +72,24 @@ hmac_scanned_bss_info *hmac_scan_alloc_scanned_bss(hi_u32 mgmt_len)
 
     /* 初始化链表头节点指针 */
     hi_list_init(&(scanned_bss->dlist_head));
+    hi_list_init(&(scanned_bss->hash_dlist));
 
     return scanned_bss;
 }
 
+/* ****************************************************************************
+ 功能描述  : 初始化bss管理结构的时间链表和BSSID散列桶
+**************************************************************************** */
+static hi_void hmac_scan_init_bss_mgmt_list(hmac_bss_mgmt_stru *bss_mgmt)
+{
+    hi_u32 loop;
+
+    hi_list_init(&(bss_mgmt->bss_list_head));
+    for (loop = 0; loop < HMAC_SCAN_BSS_HASH_NUM; loop++) {
+        hi_list_init(&(bss_mgmt->ast_bss_hash[loop]));
+    }
+}
+
 /* ****************************************************************************
  功能描述  : 将扫描到的bss添加到链表
  输入参数  : hmac_scanned_bss_info *pst_scanned_bss,        待添加到链表上的扫描到的bss节点
@@ -95,8 +109,10 @@ hi_void hmac_scan_add_bss_to_list(hmac_scanned_bss_info *scanned_bss, hmac_devic
     /* 对链表写操作前加锁 */
     oal_spin_lock(&(bss_mgmt->st_lock));
 
-    /* 添加扫描结果到链表中，并更新扫描到的bss计数 */
+    /* 添加扫描结果到链表尾和散列桶中，并更新扫描到的bss计数 */
     hi_list_tail_insert_optimize(&(scanned_bss->dlist_head), &(bss_mgmt->bss_list_head));
+    hi_list_tail_insert_optimize(&(scanned_bss->hash_dlist),
+        &(bss_mgmt->ast_bss_hash[hmac_scan_bss_hash_value(scanned_bss->bss_dscr_info.auc_bssid)]));
 
     bss_mgmt->bss_num++;
     /* 解锁 */
@@ -120,6 +136,7 @@ static hi_void hmac_scan_del_bss_from_list_nolock(hmac_scanned_bss_info *scanned
 
     /* 从链表中删除节点，并更新扫描到的bss计数 */
     hi_list_delete_optimize(&(scanned_bss->dlist_head));
+    hi_list_delete_optimize(&(scanned_bss->hash_dlist));
 
     bss_mgmt->bss_num--;
 }
@@ -172,7 +189,7 @@ hi_void hmac_scan_clean_scan_record(hmac_scan_record_stru *scan_record)
 
     /* 3.重新初始化bss管理结果链表和锁 */
     bss_mgmt = &(scan_record->bss_mgmt);
-    hi_list_init(&(bss_mgmt->bss_list_head));
+    hmac_scan_init_bss_mgmt_list(bss_mgmt);
 
     oam_info_log0(0, OAM_SF_SCAN, "{hmac_scan_clean_scan_record::cleaned scan record success.}");
 
@@ -250,13 +267,13 @@ static hi_void hmac_scan_clean_expire_scanned_bss(hmac_scan_record_stru *scan_re
     /* 对链表写操作前加锁 */
     oal_spin_lock(&(bss_mgmt->st_lock));
 
-    /* 遍历链表，删除上一次扫描结果中到期的bss信息 */
+    /* 链表按更新时间排序，从表头遍历到第一个未到期的bss即可结束 */
     hi_list_for_each_safe(entry, entry_tmp, &(bss_mgmt->bss_list_head)) {
         scanned_bss = hi_list_entry(entry, hmac_scanned_bss_info, dlist_head);
         bss_dscr = &(scanned_bss->bss_dscr_info);
         if (clean_flag != HI_TRUE) {
             if (curr_time_stamp - bss_dscr->timestamp < HMAC_SCAN_MAX_SCANNED_BSS_EXPIRE) {
-                continue;
+                break;
             }
         }
         /* 不老化当前正在关联的AP */
@@ -266,6 +283,7 @@ static hi_void hmac_scan_clean_expire_scanned_bss(hmac_scan_record_stru *scan_re
 
         /* 从链表中删除节点，并更新扫描到的bss计数 */
         hi_list_delete_optimize(&(scanned_bss->dlist_head));
+        hi_list_delete_optimize(&(scanned_bss->hash_dlist));
         bss_mgmt->bss_num--;
         /* 释放对应内存 */
         oal_free(scanned_bss);
@@ -343,9 +361,9 @@ hmac_scanned_bss_info *hmac_scan_find_scanned_bss_by_bssid(const hmac_bss_mgmt_s
     hi_list *entry = HI_NULL;
     hmac_scanned_bss_info *scanned_bss = HI_NULL;
 
-    /* 遍历链表，查找链表中是否已经存在相同bssid的bss信息 */
-    hi_list_for_each(entry, &(bss_mgmt->bss_list_head)) {
-        scanned_bss = hi_list_entry(entry, hmac_scanned_bss_info, dlist_head);
+    /* 遍历BSSID所在的散列桶，查找是否已经存在相同bssid的bss信息 */
+    hi_list_for_each(entry, &(bss_mgmt->ast_bss_hash[hmac_scan_bss_hash_value(puc_bssid)])) {
+        scanned_bss = hi_list_entry(entry, hmac_scanned_bss_info, hash_dlist);
         /* 相同的bssid地址 */
         if (0 == oal_compare_mac_addr(scanned_bss->bss_dscr_info.auc_bssid, puc_bssid, WLAN_MAC_ADDR_LEN)) {
             return scanned_bss;
@@ -564,13 +582,10 @@ static hi_u8 hmac_scan_update_bss_list_wpa(mac_bss_dscr_stru *bss_dscr, const hi
 /* ****************************************************************************
  功能描述  : STA 更新从 scan， probe response 帧接收到的AP 安全信息
  输入参数  : [1]bss_dscr
-             [2]puc_frame_body
-             [3]us_frame_len
-             [4]us_offset
+             [2]ie_index 帧体IE索引表
  返 回 值  : 无
 **************************************************************************** */
-static hi_void hmac_scan_update_bss_list_security(mac_bss_dscr_stru *bss_dscr, hi_u8 *puc_frame_body,
-    hi_u16 us_frame_len, hi_u16 us_offset)
+static hi_void hmac_scan_update_bss_list_security(mac_bss_dscr_stru *bss_dscr, const mac_ie_index_stru *ie_index)
 {
     hi_u8 *puc_ie = HI_NULL;
 
@@ -585,18 +600,15 @@ static hi_void hmac_scan_update_bss_list_security(mac_bss_dscr_stru *bss_dscr, h
     bss_dscr->bss_sec_info.auc_rsn_cap[1] = 0;
 
 #if defined(_PRE_WLAN_FEATURE_WPA2)
-    if (us_frame_len > us_offset) {
-        puc_ie = mac_find_ie(MAC_EID_RSN, puc_frame_body + us_offset, (us_frame_len - us_offset));
-        if (puc_ie != HI_NULL) {
-            /* 更新从beacon 中收到的 RSN 安全相关信息到 pst_bss_dscr 中 */
-            hmac_scan_update_bss_list_rsn(bss_dscr, puc_ie);
-        }
+    puc_ie = mac_ie_index_find(ie_index, MAC_IE_IDX_RSN);
+    if (puc_ie != HI_NULL) {
+        /* 更新从beacon 中收到的 RSN 安全相关信息到 pst_bss_dscr 中 */
+        hmac_scan_update_bss_list_rsn(bss_dscr, puc_ie);
     }
 #endif
 
 #if defined(_PRE_WLAN_FEATURE_WPA)
-    puc_ie = mac_find_vendor_ie(MAC_WLAN_OUI_MICROSOFT, MAC_OUITYPE_WPA, puc_frame_body + us_offset,
-        (hi_s32)(us_frame_len - us_offset));
+    puc_ie = mac_ie_index_find(ie_index, MAC_IE_IDX_WPA);
     if (puc_ie != HI_NULL) {
         /* 更新从beacon 中收到的 WPA 安全相关信息到 pst_bss_dscr 中 */
         hmac_scan_update_bss_list_wpa(bss_dscr, puc_ie);
@@ -612,17 +624,14 @@ static hi_void hmac_scan_update_bss_list_security(mac_bss_dscr_stru *bss_dscr, h
     作    者   : HiSilicon
     修改内容   : 新生成函数
 **************************************************************************** */
-static hi_void hmac_scan_update_bss_list_wmm(mac_bss_dscr_stru *bss_dscr, hi_u8 *puc_frame_body, hi_u16 us_frame_len)
+static hi_void hmac_scan_update_bss_list_wmm(mac_bss_dscr_stru *bss_dscr, const mac_ie_index_stru *ie_index)
 {
     hi_u8 *puc_ie = HI_NULL;
-    hi_u8 offset;
-
-    offset = MAC_TIME_STAMP_LEN + MAC_BEACON_INTERVAL_LEN + MAC_CAP_INFO_LEN;
 
     bss_dscr->wmm_cap = HI_FALSE;
     bss_dscr->uapsd_cap = HI_FALSE;
 
-    puc_ie = mac_get_wmm_ie(puc_frame_body, us_frame_len, offset);
+    puc_ie = mac_ie_index_find(ie_index, MAC_IE_IDX_WMM);
     if (puc_ie != HI_NULL) {
         bss_dscr->wmm_cap = HI_TRUE;
 
@@ -630,13 +639,8 @@ static hi_void hmac_scan_update_bss_list_wmm(mac_bss_dscr_stru *bss_dscr, hi_u8
         if (puc_ie[8] & BIT7) { /* wmm ie的第8个字节是QoS info字节 */
             bss_dscr->uapsd_cap = HI_TRUE;
         }
-    } else {
-        if (us_frame_len > offset) {
-            puc_ie = mac_find_ie(MAC_EID_HT_CAP, puc_frame_body + offset, us_frame_len - offset);
-            if (puc_ie != HI_NULL) {
-                bss_dscr->wmm_cap = HI_TRUE;
-            }
-        }
+    } else if (mac_ie_index_find(ie_index, MAC_IE_IDX_HT_CAP) != HI_NULL) {
+        bss_dscr->wmm_cap = HI_TRUE;
     }
 }
 
@@ -648,25 +652,20 @@ static hi_void hmac_scan_update_bss_list_wmm(mac_bss_dscr_stru *bss_dscr, hi_u8
     作    者   : HiSilicon
     修改内容   : 新生成函数
 **************************************************************************** */
-static hi_void hmac_scan_update_bss_list_country(mac_bss_dscr_stru *bss_dscr, hi_u8 *puc_frame_body,
-    hi_u16 us_frame_len)
+static hi_void hmac_scan_update_bss_list_country(mac_bss_dscr_stru *bss_dscr, const mac_ie_index_stru *ie_index)
 {
     hi_u8 *puc_ie = HI_NULL;
-    hi_u8 offset;
 
-    offset = MAC_TIME_STAMP_LEN + MAC_BEACON_INTERVAL_LEN + MAC_CAP_INFO_LEN;
     /* 国家码默认标记为0 */
     bss_dscr->ac_country[0] = 0;
     bss_dscr->ac_country[1] = 0;
     bss_dscr->ac_country[2] = 0; /* 第2个字节 */
 
-    if (us_frame_len > offset) {
-        puc_ie = mac_find_ie(MAC_EID_COUNTRY, puc_frame_body + offset, us_frame_len - offset);
-        if (puc_ie != HI_NULL) {
-            bss_dscr->ac_country[0] = (hi_s8)puc_ie[MAC_IE_HDR_LEN];
-            bss_dscr->ac_country[1] = (hi_s8)puc_ie[MAC_IE_HDR_LEN + 1];
-            bss_dscr->ac_country[2] = 0; /* 第2个字节 */
-        }
+    puc_ie = mac_ie_index_find(ie_index, MAC_IE_IDX_COUNTRY);
+    if (puc_ie != HI_NULL) {
+        bss_dscr->ac_country[0] = (hi_s8)puc_ie[MAC_IE_HDR_LEN];
+        bss_dscr->ac_country[1] = (hi_s8)puc_ie[MAC_IE_HDR_LEN + 1];
+        bss_dscr->ac_country[2] = 0; /* 第2个字节 */
     }
 }
 #endif
@@ -678,8 +677,7 @@ static hi_void hmac_scan_update_bss_list_country(mac_bss_dscr_stru *bss_dscr, hi
     作    者   : HiSilicon
     修改内容   : 新生成函数
 **************************************************************************** */
-static hi_void hmac_scan_update_bss_list_11n(mac_bss_dscr_stru *bss_dscr, hi_u8 *puc_frame_body, hi_u16 us_frame_len,
-    hi_u16 us_offset)
+static hi_void hmac_scan_update_bss_list_11n(mac_bss_dscr_stru *bss_dscr, const mac_ie_index_stru *ie_index)
 {
     hi_u8 *puc_ie = HI_NULL;
     mac_ht_opern_stru *ht_op = HI_NULL;
@@ -688,23 +686,19 @@ static hi_void hmac_scan_update_bss_list_11n(mac_bss_dscr_stru *bss_dscr, hi_u8
     wlan_bw_cap_enum_uint8 ht_op_bw = WLAN_BW_CAP_20M;
 
     /* 11n */
-    if (us_frame_len > us_offset) {
-        puc_ie = mac_find_ie(MAC_EID_HT_CAP, puc_frame_body + us_offset, us_frame_len - us_offset);
-        if ((puc_ie != HI_NULL) && (puc_ie[1] >= 2)) { /* 增加ie长度异常检查 2: 与2比较 */
-            /* puc_ie[2]是HT Capabilities Info的第1个字节 */
-            bss_dscr->ht_capable = HI_TRUE;                /* 支持ht */
-            bss_dscr->ht_ldpc = (puc_ie[2] & BIT0);        /* 支持ldpc 2: 数组下标 */
-            ht_cap_bw = ((puc_ie[2] & BIT1) >> 1);         /* 取出支持的带宽 2: 数组下标 */
-            bss_dscr->ht_stbc = ((puc_ie[2] & BIT7) >> 7); /* 支持stbc 2: 数组下标,右移7位 */
-        }
+    puc_ie = mac_ie_index_find(ie_index, MAC_IE_IDX_HT_CAP);
+    if ((puc_ie != HI_NULL) && (puc_ie[1] >= 2)) { /* 增加ie长度异常检查 2: 与2比较 */
+        /* puc_ie[2]是HT Capabilities Info的第1个字节 */
+        bss_dscr->ht_capable = HI_TRUE;                /* 支持ht */
+        bss_dscr->ht_ldpc = (puc_ie[2] & BIT0);        /* 支持ldpc 2: 数组下标 */
+        ht_cap_bw = ((puc_ie[2] & BIT1) >> 1);         /* 取出支持的带宽 2: 数组下标 */
+        bss_dscr->ht_stbc = ((puc_ie[2] & BIT7) >> 7); /* 支持stbc 2: 数组下标,右移7位 */
     }
 
     /* 默认20M,如果帧内容未携带HT_OPERATION则可以直接采用默认值 */
     bss_dscr->channel_bandwidth = WLAN_BAND_WIDTH_20M;
 
-    if (us_frame_len > us_offset) {
-        puc_ie = mac_find_ie(MAC_EID_HT_OPERATION, puc_frame_body + us_offset, us_frame_len - us_offset);
-    }
+    puc_ie = mac_ie_index_find(ie_index, MAC_IE_IDX_HT_OPERATION);
     if ((puc_ie != HI_NULL) && (puc_ie[1] >= 2)) { /* 增加ie长度异常检查 2: 与2比较 */
         ht_op = (mac_ht_opern_stru *)(puc_ie + MAC_IE_HDR_LEN);
 
@@ -727,12 +721,10 @@ static hi_void hmac_scan_update_bss_list_11n(mac_bss_dscr_stru *bss_dscr, hi_u8
     /* 将AP带宽能力取声明能力的最小值，防止AP异常发送超过带宽能力数据，造成数据不通 */
     bss_dscr->bw_cap = oal_min(ht_cap_bw, ht_op_bw);
 
-    if (us_frame_len > us_offset) {
-        puc_ie = mac_find_ie(MAC_EID_EXT_CAPS, puc_frame_body + us_offset, us_frame_len - us_offset);
-        if ((puc_ie != HI_NULL) && (puc_ie[1] >= 1)) {
-            /* Extract 20/40 BSS Coexistence Management Support */
-            bss_dscr->coex_mgmt_supp = (puc_ie[2] & BIT0);
-        }
+    puc_ie = mac_ie_index_find(ie_index, MAC_IE_IDX_EXT_CAPS);
+    if ((puc_ie != HI_NULL) && (puc_ie[1] >= 1)) {
+        /* Extract 20/40 BSS Coexistence Management Support */
+        bss_dscr->coex_mgmt_supp = (puc_ie[2] & BIT0);
     }
 }
 
@@ -746,11 +738,8 @@ static hi_void hmac_scan_update_bss_list_11n(mac_bss_dscr_stru *bss_dscr, hi_u8
     作    者   : HiSilicon
     修改内容   : 补充11i 加密信息
 **************************************************************************** */
-static hi_void hmac_scan_update_bss_list_protocol(mac_bss_dscr_stru *bss_dscr, hi_u8 *puc_frame_body,
-    hi_u16 us_frame_len)
+static hi_void hmac_scan_update_bss_list_protocol(mac_bss_dscr_stru *bss_dscr, const mac_ie_index_stru *ie_index)
 {
-    hi_u16 us_offset = MAC_TIME_STAMP_LEN + MAC_BEACON_INTERVAL_LEN + MAC_CAP_INFO_LEN;
-
     /* *********************************************************************** */
     /*                       Beacon Frame - Frame Body                       */
     /* ---------------------------------------------------------------------- */
@@ -771,18 +760,18 @@ static hi_void hmac_scan_update_bss_list_protocol(mac_bss_dscr_stru *bss_dscr, h
     /* |3-8                   |                                              */
     /* *********************************************************************** */
     /* wmm */
-    hmac_scan_update_bss_list_wmm(bss_dscr, puc_frame_body, us_frame_len);
+    hmac_scan_update_bss_list_wmm(bss_dscr, ie_index);
 
 #if defined(_PRE_WLAN_FEATURE_WPA) || defined(_PRE_WLAN_FEATURE_WPA2)
     /* 11i */
-    hmac_scan_update_bss_list_security(bss_dscr, puc_frame_body, us_frame_len, us_offset);
+    hmac_scan_update_bss_list_security(bss_dscr, ie_index);
 #endif
 #ifdef _PRE_WLAN_FEATURE_11D
     /* 11d */
-    hmac_scan_update_bss_list_country(bss_dscr, puc_frame_body, us_frame_len);
+    hmac_scan_update_bss_list_country(bss_dscr, ie_index);
 #endif
     /* 11n */
-    hmac_scan_update_bss_list_11n(bss_dscr, puc_frame_body, us_frame_len, us_offset);
+    hmac_scan_update_bss_list_11n(bss_dscr, ie_index);
 }
 
 /* ****************************************************************************
@@ -825,23 +814,20 @@ hi_u8 hmac_scan_check_bss_supp_rates(mac_device_stru *mac_dev, const hi_u8 *puc_
     作    者   : HiSilicon
     修改内容   : 新生成函数
 **************************************************************************** */
-static hi_u32 hmac_scan_update_bss_list_rates(mac_bss_dscr_stru *bss_dscr, hi_u8 *puc_frame_body, hi_u16 us_frame_len,
-    mac_device_stru *mac_dev)
+static hi_u32 hmac_scan_update_bss_list_rates(mac_bss_dscr_stru *bss_dscr, const mac_ie_index_stru *ie_index,
+    hi_u16 us_frame_len, mac_device_stru *mac_dev)
 {
     hi_u8 *puc_ie = HI_NULL;
     hi_u8 num_rates = 0;
     hi_u8 num_ex_rates;
-    hi_u8 us_offset;
     hi_u8 auc_rates[MAC_DATARATES_PHY_80211G_NUM] = {0};
 
-    /* 设置Beacon帧的field偏移量 */
-    us_offset = MAC_TIME_STAMP_LEN + MAC_BEACON_INTERVAL_LEN + MAC_CAP_INFO_LEN;
-    if (us_frame_len <= us_offset) {
+    if (us_frame_len <= MAC_SSID_OFFSET) {
         oam_warning_log1(0, OAM_SF_SCAN, "{hmac_scan_update_bss_list_rates::frame_len[%d].}", us_frame_len);
         return HI_FAIL;
     }
 
-    puc_ie = mac_find_ie(MAC_EID_RATES, puc_frame_body + us_offset, us_frame_len - us_offset);
+    puc_ie = mac_ie_index_find(ie_index, MAC_IE_IDX_RATES);
     if (puc_ie != HI_NULL) {
         num_rates = hmac_scan_check_bss_supp_rates(mac_dev, puc_ie + MAC_IE_HDR_LEN, puc_ie[1], auc_rates,
             MAC_DATARATES_PHY_80211G_NUM);
@@ -857,7 +843,7 @@ static hi_u32 hmac_scan_update_bss_list_rates(mac_bss_dscr_stru *bss_dscr, hi_u8
 
         bss_dscr->num_supp_rates = num_rates;
     }
-    puc_ie = mac_find_ie(MAC_EID_XRATES, puc_frame_body + us_offset, us_frame_len - us_offset);
+    puc_ie = mac_ie_index_find(ie_index, MAC_IE_IDX_XRATES);
     if (puc_ie != HI_NULL) {
         num_ex_rates = hmac_scan_check_bss_supp_rates(mac_dev, puc_ie + MAC_IE_HDR_LEN, puc_ie[1], auc_rates,
             MAC_DATARATES_PHY_80211G_NUM);
@@ -883,12 +869,17 @@ static hi_u32 hmac_scan_update_bss_list_rates(mac_bss_dscr_stru *bss_dscr, hi_u8
 }
 
 static hi_u32 hmac_scan_update_bss_ssid(mac_bss_dscr_stru *bss_dscr, hmac_scanned_bss_info *scanned_bss,
-    hi_u8 *puc_frame_body, hi_u16 us_frame_body_len)
+    const mac_ie_index_stru *ie_index)
 {
     hi_unref_param(scanned_bss);
-    hi_u8 ssid_len;
+    hi_u8 ssid_len = 0;
+    hi_u8 *puc_ssid = HI_NULL;
     /* 解析并保存ssid */
-    hi_u8 *puc_ssid = mac_get_ssid(puc_frame_body, (hi_s32)us_frame_body_len, &ssid_len);
+    hi_u8 *puc_ssid_ie = mac_ie_index_find(ie_index, MAC_IE_IDX_SSID);
+    if ((puc_ssid_ie != HI_NULL) && (puc_ssid_ie[1] < WLAN_SSID_MAX_LEN)) {
+        ssid_len = puc_ssid_ie[1];
+        puc_ssid = puc_ssid_ie + MAC_IE_HDR_LEN;
+    }
     if ((puc_ssid != HI_NULL) && (ssid_len != 0)) {
         /* 将查找到的ssid保存到bss描述结构体中 */
         if (memcpy_s(bss_dscr->ac_ssid, WLAN_SSID_MAX_LEN, puc_ssid, ssid_len) != EOK) {
@@ -899,8 +890,12 @@ static hi_u32 hmac_scan_update_bss_ssid(mac_bss_dscr_stru *bss_dscr, hmac_scanne
 #ifdef _PRE_WLAN_FEATURE_MESH
     } else {
         /* 同WPA，Mesh的beacon和probe rsp会将ssid回复在私有meshid字段中，获取出来将meshid更新填充到ssid中 */
-        /* mac_get_meshid()函数返回值类型就是hi_u8*,误报lin_t64告警，申请屏蔽 */
-        puc_ssid = mac_get_meshid(puc_frame_body, (hi_s32)us_frame_body_len, &ssid_len);
+        hi_u8 *puc_meshid_ie = mac_ie_index_find(ie_index, MAC_IE_IDX_MESH_ID);
+        puc_ssid = HI_NULL;
+        if ((puc_meshid_ie != HI_NULL) && (puc_meshid_ie[MAC_MESH_MESHID_LEN_POS] < WLAN_MESHID_MAX_LEN)) {
+            ssid_len = puc_meshid_ie[MAC_MESH_MESHID_LEN_POS];
+            puc_ssid = puc_meshid_ie + MAC_MESH_MESHID_OFFSET;
+        }
         /* 将查找到的ssid保存到bss描述结构体中 */
         if (puc_ssid != HI_NULL) {
             if (memcpy_s(bss_dscr->ac_ssid, WLAN_SSID_MAX_LEN, puc_ssid, ssid_len) != EOK) {
@@ -935,7 +930,7 @@ static hi_u32 hmac_scan_update_bss_bssid(mac_bss_dscr_stru *bss_dscr, const mac_
 }
 
 static hi_void hmac_scan_update_bss_base(hmac_vap_stru *hmac_vap, const dmac_tx_event_stru *dtx_event,
-    mac_bss_dscr_stru *bss_dscr, hi_u8 frame_channel)
+    mac_bss_dscr_stru *bss_dscr, hi_u8 frame_channel, const mac_ie_index_stru *ie_index)
 {
     hi_unref_param(hmac_vap);
 
@@ -965,8 +960,10 @@ static hi_void hmac_scan_update_bss_base(hmac_vap_stru *hmac_vap, const dmac_tx_
 
     /* 解析 TIM 周期，仅 Beacon 帧有该元素 */
     if (frame_header->frame_control.sub_type == WLAN_BEACON) {
-        bss_dscr->dtim_period = mac_get_dtim_period(puc_frame_body, us_frame_body_len);
-        bss_dscr->dtim_cnt = mac_get_dtim_cnt(puc_frame_body, us_frame_body_len);
+        hi_u8 *puc_tim_ie = mac_ie_index_find(ie_index, MAC_IE_IDX_TIM);
+        hi_u8 tim_valid = ((puc_tim_ie != HI_NULL) && (puc_tim_ie[1] >= MAC_MIN_TIM_LEN)) ? HI_TRUE : HI_FALSE;
+        bss_dscr->dtim_period = tim_valid ? puc_tim_ie[3] : 0; /* byte 3 为dtim period值 */
+        bss_dscr->dtim_cnt = tim_valid ? puc_tim_ie[2] : 0;    /* byte 2 为dtim cnt值 */
     }
 
     /* 信道 */
@@ -974,12 +971,12 @@ static hi_void hmac_scan_update_bss_base(hmac_vap_stru *hmac_vap, const dmac_tx_
     bss_dscr->channel.band = mac_get_band_by_channel_num(frame_channel);
 
     /* 记录速率集 */
-    if (hmac_scan_update_bss_list_rates(bss_dscr, puc_frame_body, us_frame_body_len, mac_dev) != HI_SUCCESS) {
+    if (hmac_scan_update_bss_list_rates(bss_dscr, ie_index, us_frame_body_len, mac_dev) != HI_SUCCESS) {
         oam_warning_log0(0, OAM_SF_SCAN, "hmac_scan_update_bss_list_rates return NON SUCCESS. ");
     }
 
     /* 协议类相关信息元素的获取 */
-    hmac_scan_update_bss_list_protocol(bss_dscr, puc_frame_body, us_frame_body_len);
+    hmac_scan_update_bss_list_protocol(bss_dscr, ie_index);
 
 #ifdef _PRE_WLAN_FEATURE_MESH
     /* Probe Rsp和Beacon帧中前面为Timestamp,beacon interval,capability字段，非tlv结构，不能直接用于mac_find_ie函数，
@@ -989,8 +986,8 @@ static hi_void hmac_scan_update_bss_base(hmac_vap_stru *hmac_vap, const dmac_tx_
     if (hmac_vap->base_vap->vap_mode == WLAN_VAP_MODE_MESH) {
         /* 新增Mesh Configuration Element解析获取Accepting Peer字段值 */
         if (us_frame_body_len > MAC_SSID_OFFSET) {
-            mac_mesh_conf_ie_stru *puc_mesh_conf_ie = (mac_mesh_conf_ie_stru *)mac_find_ie(MAC_EID_MESH_CONF,
-                puc_frame_ie_body, us_frame_body_len - MAC_SSID_OFFSET);
+            mac_mesh_conf_ie_stru *puc_mesh_conf_ie =
+                (mac_mesh_conf_ie_stru *)mac_ie_index_find(ie_index, MAC_IE_IDX_MESH_CONF);
             if (puc_mesh_conf_ie != HI_NULL) {
                 bss_dscr->is_mesh_accepting_peer =
                     (puc_mesh_conf_ie->mesh_capa.accepting_add_mesh_peerings == 1) ? HI_TRUE : HI_FALSE;
@@ -1009,15 +1006,11 @@ static hi_void hmac_scan_update_bss_base(hmac_vap_stru *hmac_vap, const dmac_tx_
 #endif
 }
 
-static hi_void hmac_scan_update_bss_any(mac_bss_dscr_stru *bss_dscr, hi_u8 *puc_frame_body, hi_u16 us_frame_body_len)
+static hi_void hmac_scan_update_bss_any(mac_bss_dscr_stru *bss_dscr, const mac_ie_index_stru *ie_index)
 {
 #ifdef _PRE_WLAN_FEATURE_ANY
-    /* Probe Rsp和Beacon帧中前面为Timestamp,beacon interval,capability字段，非tlv结构，不能直接用于mac_find_ie函数，
-    此处加上偏移，以Element ID为0的SSID做为起始地址查找指定IE */
-    hi_u8 *puc_frame_ie_start = puc_frame_body + MAC_TIME_STAMP_LEN + MAC_BEACON_INTERVAL_LEN + MAC_CAP_INFO_LEN;
     /* 查找对应的ANY IE */
-    hi_u8 *puc_any_ie = mac_find_vendor_ie(MAC_WLAN_OUI_VENDOR, MAC_OUITYPE_ANY, puc_frame_ie_start,
-        us_frame_body_len - MAC_SSID_OFFSET);
+    hi_u8 *puc_any_ie = mac_ie_index_find(ie_index, MAC_IE_IDX_ANY);
     if ((puc_any_ie != HI_NULL) && ((puc_any_ie[6] == MAC_ANY_STA_TYPE) || /* 6元素索引 */
         (puc_any_ie[6] == MAC_ANY_AP_TYPE))) {                             /* 6元素索引 */
         bss_dscr->supp_any = HI_TRUE;
@@ -1028,8 +1021,7 @@ static hi_void hmac_scan_update_bss_any(mac_bss_dscr_stru *bss_dscr, hi_u8 *puc_
     }
 #else
     hi_unref_param(bss_dscr);
-    hi_unref_param(puc_frame_body);
-    hi_unref_param(us_frame_body_len);
+    hi_unref_param(ie_index);
 #endif
     return;
 }
@@ -1049,7 +1041,7 @@ hi_u32 hmac_scan_update_bss_dscr(hmac_scanned_bss_info *scanned_bss, const dmac_
     oal_netbuf_stru *netbuf = dtx_event->netbuf;
     mac_scanned_result_extend_info_stru *scan_result_extend_info = HI_NULL;
     hi_u16 us_netbuf_len = (hi_u16)(dtx_event->us_frame_len + MAC_80211_FRAME_LEN);
-    hi_u16 us_offset = MAC_TIME_STAMP_LEN + MAC_BEACON_INTERVAL_LEN + MAC_CAP_INFO_LEN;
+    mac_ie_index_stru ie_index;
 
     /* 获取hmac vap */
     hmac_vap_stru *hmac_vap = hmac_vap_get_vap_stru(vap_id);
@@ -1073,8 +1065,15 @@ hi_u32 hmac_scan_update_bss_dscr(hmac_scanned_bss_info *scanned_bss, const dmac_
     hi_u8 *puc_frame_body = (hi_u8 *)(puc_mgmt_frame + MAC_80211_FRAME_LEN);
     hi_u16 us_frame_body_len = us_frame_len - MAC_80211_FRAME_LEN;
 
+    /* 单次遍历帧体IE建立索引，后续各项解析直接查表，不再对同一帧反复mac_find_ie */
+    if (us_frame_body_len > MAC_SSID_OFFSET) {
+        mac_ie_build_index(&ie_index, puc_frame_body + MAC_SSID_OFFSET, us_frame_body_len - MAC_SSID_OFFSET);
+    } else {
+        mac_ie_build_index(&ie_index, HI_NULL, 0);
+    }
+
     /* 获取管理帧中的信道 */
-    hi_u8 frame_channel = mac_ie_get_chan_num(puc_frame_body, us_frame_body_len, us_offset, 0);
+    hi_u8 frame_channel = mac_ie_get_chan_num(&ie_index, 0);
     /* 如果信道非法，直接返回 */
     if (frame_channel == 0) {
         oam_info_log0(0, OAM_SF_SCAN, "hmac_scan_update_bss_dscr:: Received a frame from unregulated domain.");
@@ -1096,19 +1095,19 @@ hi_u32 hmac_scan_update_bss_dscr(hmac_scanned_bss_info *scanned_bss, const dmac_
         解析beacon/probe rsp帧，记录到pst_bss_dscr
     **************************************************************************** */
     /* 解析并保存ssid 和 bssid */
-    if ((hmac_scan_update_bss_ssid(bss_dscr, scanned_bss, puc_frame_body, us_frame_body_len) != HI_SUCCESS) ||
+    if ((hmac_scan_update_bss_ssid(bss_dscr, scanned_bss, &ie_index) != HI_SUCCESS) ||
         (hmac_scan_update_bss_bssid(bss_dscr, frame_header) != HI_SUCCESS)) {
         return HI_FAIL;
     }
 
     /* bss基本信息 */
-    hmac_scan_update_bss_base(hmac_vap, dtx_event, bss_dscr, frame_channel);
+    hmac_scan_update_bss_base(hmac_vap, dtx_event, bss_dscr, frame_channel, &ie_index);
 
     /* 更新时间戳 */
     bss_dscr->timestamp = (hi_u32)hi_get_milli_seconds();
     bss_dscr->mgmt_len = us_frame_len;
     /* 更新any相关信息 */
-    hmac_scan_update_bss_any(bss_dscr, puc_frame_body, us_frame_body_len);
+    hmac_scan_update_bss_any(bss_dscr, &ie_index);
 
     /* 拷贝管理帧内容 */
     if (memcpy_s((hi_u8 *)scanned_bss->bss_dscr_info.auc_mgmt_buff, (hi_u32)us_frame_len, puc_mgmt_frame,
@@ -1120,6 +1119,143 @@ hi_u32 hmac_scan_update_bss_dscr(hmac_scanned_bss_info *scanned_bss, const dmac_
     return HI_SUCCESS;
 }
 
+/* ****************************************************************************
+ 功能描述  : FNV-1a累加一段数据到指纹
+**************************************************************************** */
+static hi_u32 hmac_scan_beacon_fp_update(hi_u32 fp, const hi_u8 *puc_data, hi_u32 len)
+{
+    hi_u32 loop;
+
+    for (loop = 0; loop < len; loop++) {
+        fp = (fp ^ puc_data[loop]) * HMAC_SCAN_BEACON_FP_PRIME;
+    }
+    return fp;
+}
+
+/* ****************************************************************************
+ 功能描述  : 计算beacon帧体指纹，时间戳和TIM IE每帧都会变化，不参与计算
+ 输入参数  : [1]puc_frame_body 帧体
+             [2]us_frame_body_len 帧体长度
+ 返 回 值  : 指纹，帧体过短时返回HMAC_SCAN_BEACON_FP_NONE
+**************************************************************************** */
+static hi_u32 hmac_scan_calc_beacon_fp(const hi_u8 *puc_frame_body, hi_u16 us_frame_body_len)
+{
+    const hi_u8 *puc_ie = puc_frame_body + MAC_SSID_OFFSET;
+    hi_u32 remain;
+    hi_u32 fp;
+
+    if (us_frame_body_len <= MAC_SSID_OFFSET) {
+        return HMAC_SCAN_BEACON_FP_NONE;
+    }
+
+    /* beacon interval和capability */
+    fp = hmac_scan_beacon_fp_update(HMAC_SCAN_BEACON_FP_BASIS, puc_frame_body + MAC_TIME_STAMP_LEN,
+        MAC_BEACON_INTERVAL_LEN + MAC_CAP_INFO_LEN);
+    remain = us_frame_body_len - MAC_SSID_OFFSET;
+    while ((remain >= MAC_IE_HDR_LEN) && (remain >= (hi_u32)(MAC_IE_HDR_LEN + puc_ie[1]))) {
+        if (puc_ie[0] != MAC_EID_TIM) {
+            fp = hmac_scan_beacon_fp_update(fp, puc_ie, MAC_IE_HDR_LEN + puc_ie[1]);
+        }
+        remain -= (hi_u32)(MAC_IE_HDR_LEN + puc_ie[1]);
+        puc_ie += MAC_IE_HDR_LEN + puc_ie[1];
+    }
+    /* 不完整的尾部IE同样计入 */
+    fp = hmac_scan_beacon_fp_update(fp, puc_ie, remain);
+
+    return (fp == HMAC_SCAN_BEACON_FP_NONE) ? (fp + 1) : fp;
+}
+
+/* ****************************************************************************
+ 功能描述  : 计算上报帧的beacon指纹，非beacon帧或不适用快速路径的场景返回HMAC_SCAN_BEACON_FP_NONE
+**************************************************************************** */
+static hi_u32 hmac_scan_get_beacon_fp(const hmac_vap_stru *hmac_vap, const hmac_scan_stru *scan_mgmt,
+    const dmac_tx_event_stru *dtx_event)
+{
+    hi_u8 *puc_mgmt_frame = (hi_u8 *)oal_netbuf_data(dtx_event->netbuf);
+    hi_u16 us_frame_len = (hi_u16)(dtx_event->us_frame_len + MAC_80211_FRAME_LEN -
+        sizeof(mac_scanned_result_extend_info_stru));
+
+    if ((puc_mgmt_frame == HI_NULL) || (us_frame_len <= MAC_80211_FRAME_LEN) ||
+        (((mac_ieee80211_frame_stru *)puc_mgmt_frame)->frame_control.sub_type != WLAN_BEACON)) {
+        return HMAC_SCAN_BEACON_FP_NONE;
+    }
+    /* MESH过滤规则依赖VAP模式，始终走完整解析 */
+    if (hmac_vap->base_vap->vap_mode == WLAN_VAP_MODE_MESH) {
+        return HMAC_SCAN_BEACON_FP_NONE;
+    }
+#ifdef _PRE_WLAN_FEATURE_SCAN_BY_SSID
+    /* 指定ssid扫描需要逐帧做ssid过滤 */
+    if ((scan_mgmt->request != HI_NULL) && (scan_mgmt->request->n_ssids != 0)) {
+        return HMAC_SCAN_BEACON_FP_NONE;
+    }
+#else
+    hi_unref_param(scan_mgmt);
+#endif
+    return hmac_scan_calc_beacon_fp(puc_mgmt_frame + MAC_80211_FRAME_LEN, us_frame_len - MAC_80211_FRAME_LEN);
+}
+
+/* ****************************************************************************
+ 功能描述  : beacon去重快速路径: 帧体指纹与已保存的bss一致时，只刷新rssi、时间戳、TIM信息和保存的帧，
+             不再走IE解析流程
+ 返 回 值  : HI_TRUE表示已命中并完成刷新，调用者直接释放netbuf
+**************************************************************************** */
+static hi_u8 hmac_scan_proc_beacon_dedup(hmac_device_stru *hmac_dev, const dmac_tx_event_stru *dtx_event,
+    hi_u32 beacon_fp)
+{
+    hmac_scan_stru *scan_mgmt = &(hmac_dev->scan_mgmt);
+    hmac_bss_mgmt_stru *bss_mgmt = &(scan_mgmt->scan_record_mgmt.bss_mgmt);
+    hi_u8 *puc_mgmt_frame = (hi_u8 *)oal_netbuf_data(dtx_event->netbuf);
+    hi_u16 us_frame_len = (hi_u16)(dtx_event->us_frame_len + MAC_80211_FRAME_LEN -
+        sizeof(mac_scanned_result_extend_info_stru));
+    mac_ieee80211_frame_stru *frame_header = (mac_ieee80211_frame_stru *)puc_mgmt_frame;
+    mac_scanned_result_extend_info_stru *extend_info =
+        (mac_scanned_result_extend_info_stru *)(puc_mgmt_frame + us_frame_len);
+    hi_u8 *puc_tim_ie = HI_NULL;
+
+    if (beacon_fp == HMAC_SCAN_BEACON_FP_NONE) {
+        return HI_FALSE;
+    }
+
+    oal_spin_lock(&(bss_mgmt->st_lock));
+    hmac_scanned_bss_info *old_scanned_bss = hmac_scan_find_scanned_bss_by_bssid(bss_mgmt,
+        frame_header->auc_address3);
+    /* 帧长不变才能原地覆盖保存的帧；帧信道与扫描信道一致时不存在need_drop过滤 */
+    if ((old_scanned_bss == HI_NULL) || (old_scanned_bss->beacon_fp != beacon_fp) ||
+        (old_scanned_bss->bss_dscr_info.mgmt_len != us_frame_len) ||
+        (old_scanned_bss->bss_dscr_info.channel.chan_number != extend_info->channel) ||
+        (memcmp(old_scanned_bss->bss_dscr_info.auc_mac_addr, frame_header->auc_address2, WLAN_MAC_ADDR_LEN) != 0)) {
+        oal_spin_unlock(&(bss_mgmt->st_lock));
+        scan_mgmt->beacon_dedup_miss++;
+        return HI_FALSE;
+    }
+
+    mac_bss_dscr_stru *bss_dscr = &(old_scanned_bss->bss_dscr_info);
+    /* 与完整解析路径一致: 1s内保留更强的rssi */
+    if ((bss_dscr->rssi <= (hi_s8)extend_info->l_rssi) ||
+        ((hi_get_milli_seconds() - bss_dscr->timestamp) >= HMAC_SCAN_MAX_SCANNED_RSSI_EXPIRE)) {
+        bss_dscr->rssi = (hi_s8)extend_info->l_rssi;
+    }
+    puc_tim_ie = mac_find_ie(MAC_EID_TIM, puc_mgmt_frame + MAC_80211_FRAME_LEN + MAC_SSID_OFFSET,
+        us_frame_len - MAC_80211_FRAME_LEN - MAC_SSID_OFFSET);
+    if ((puc_tim_ie != HI_NULL) && (puc_tim_ie[1] >= MAC_MIN_TIM_LEN)) {
+        bss_dscr->dtim_period = puc_tim_ie[3]; /* byte 3 为dtim period值 */
+        bss_dscr->dtim_cnt = puc_tim_ie[2];    /* byte 2 为dtim cnt值 */
+    }
+    /* 帧长相同，直接覆盖保存的帧，使上报内核的时间戳和TIM保持最新 */
+    if (memcpy_s(bss_dscr->auc_mgmt_buff, bss_dscr->mgmt_len, puc_mgmt_frame, us_frame_len) != EOK) {
+        oam_error_log0(0, OAM_SF_SCAN, "{hmac_scan_proc_beacon_dedup::memcpy_s fail.}");
+    }
+    bss_dscr->timestamp = (hi_u32)hi_get_milli_seconds();
+    bss_dscr->new_scan_bss = HI_TRUE;
+    /* 时间戳已刷新，移到链表尾保持按更新时间排序 */
+    hi_list_delete_optimize(&(old_scanned_bss->dlist_head));
+    hi_list_tail_insert_optimize(&(old_scanned_bss->dlist_head), &(bss_mgmt->bss_list_head));
+    oal_spin_unlock(&(bss_mgmt->st_lock));
+
+    scan_mgmt->beacon_dedup_hit++;
+    return HI_TRUE;
+}
+
 static hi_u32 hmac_scan_proc_scanned_bss_mgmt(hmac_device_stru *hmac_dev, hmac_scanned_bss_info *new_scanned_bss,
     oal_netbuf_stru *bss_mgmt_netbuf)
 {
@@ -1154,6 +1290,9 @@ static hi_u32 hmac_scan_proc_scanned_bss_mgmt(hmac_device_stru *hmac_dev, hmac_s
 
         old_scanned_bss->bss_dscr_info.timestamp = (hi_u32)hi_get_milli_seconds();
         old_scanned_bss->bss_dscr_info.rssi = new_scanned_bss->bss_dscr_info.rssi;
+        /* 时间戳已刷新，移到链表尾保持按更新时间排序 */
+        hi_list_delete_optimize(&(old_scanned_bss->dlist_head));
+        hi_list_tail_insert_optimize(&(old_scanned_bss->dlist_head), &(bss_mgmt->bss_list_head));
 
         /* 解锁 */
         oal_spin_unlock(&(bss_mgmt->st_lock));
@@ -1243,6 +1382,13 @@ hi_u32 hmac_scan_proc_scanned_bss(frw_event_mem_stru *event_mem)
     /* ------------------------------------------------------------------------------------------  */
     /*                                                                                             */
     /* ********************************************************************************************* */
+    /* 与已保存beacon指纹一致时只刷新动态信息，不再重复解析 */
+    hi_u32 beacon_fp = hmac_scan_get_beacon_fp(hmac_vap, &(hmac_dev->scan_mgmt), dtx_event);
+    if (hmac_scan_proc_beacon_dedup(hmac_dev, dtx_event, beacon_fp) == HI_TRUE) {
+        oal_netbuf_free(bss_mgmt_netbuf);
+        return HI_SUCCESS;
+    }
+
     /* 管理帧的长度等于上报的netbuf的长度减去上报的扫描结果的扩展字段的长度 */
     hi_u16 us_mgmt_len =
         (hi_u16)(dtx_event->us_frame_len + MAC_80211_FRAME_LEN - sizeof(mac_scanned_result_extend_info_stru));
@@ -1268,6 +1414,7 @@ hi_u32 hmac_scan_proc_scanned_bss(frw_event_mem_stru *event_mem)
         oal_free(new_scanned_bss);
         return HI_FAIL;
     }
+    new_scanned_bss->beacon_fp = beacon_fp;
 
 #ifdef _PRE_WLAN_FEATURE_MESH
     /* MESH VAP过滤非MESH VAP发出的Beacon/Probe Rsp
@@ -1387,6 +1534,9 @@ hi_u32 hmac_scan_proc_scan_comp_event(frw_event_mem_stru *event_mem)
     scan_mgmt->scan_record_mgmt.scan_rsp_status = d2h_scan_rsp_info->scan_rsp_status;
     scan_mgmt->scan_record_mgmt.ull_cookie = d2h_scan_rsp_info->ull_cookie;
 
+    oam_info_log2(event_hdr->vap_id, OAM_SF_SCAN, "{hmac_scan_proc_scan_comp_event::beacon dedup hit[%u] miss[%u]}",
+        scan_mgmt->beacon_dedup_hit, scan_mgmt->beacon_dedup_miss);
+
     /* 上报扫描结果前，清除下到期的扫描bss，防止上报过多到期的bss */
     hmac_scan_clean_expire_scanned_bss(&(scan_mgmt->scan_record_mgmt), HI_FALSE);
     /* 如果扫描回调函数不为空，则调用回调函数 */
@@ -1901,9 +2051,11 @@ hi_void hmac_scan_init(hmac_device_stru *hmac_dev)
     scan_mgmt->scan_record_mgmt.vap_last_state = MAC_VAP_STATE_BUTT;
     scan_mgmt->is_random_mac_addr_scan = HI_FALSE; /* 随机mac 扫描开关，默认关闭 */
     scan_mgmt->scan_record_mgmt.is_any_scan = HI_FALSE;
+    scan_mgmt->beacon_dedup_hit = 0;
+    scan_mgmt->beacon_dedup_miss = 0;
     /* 初始化bss管理结果链表和锁 */
     bss_mgmt = &(scan_mgmt->scan_record_mgmt.bss_mgmt);
-    hi_list_init(&(bss_mgmt->bss_list_head));
+    hmac_scan_init_bss_mgmt_list(bss_mgmt);
     oal_spin_lock_init(&bss_mgmt->st_lock);
 
     /* 初始化内核下发扫描request资源锁 */
@@ -42,6 +42,10 @@ extern "C" {
 #define HMAC_SCAN_MAX_SCANNED_RSSI_EXPIRE 1000 /* 1000 milliseconds */
 /* 前景扫描每个信道扫描次数 */
 #define FGSCAN_SCAN_CNT_PER_CHANNEL 2
+/* beacon指纹(FNV-1a)参数，指纹0保留表示未记录 */
+#define HMAC_SCAN_BEACON_FP_BASIS   0x811C9DC5
+#define HMAC_SCAN_BEACON_FP_PRIME   0x01000193
+#define HMAC_SCAN_BEACON_FP_NONE    0
 
 /* ****************************************************************************
   3 函数声明
@@ -38,7 +38,9 @@ extern "C" {
 #define RTP_CSRC_LEN_BYTE           4           /* 每个CSRC标识符占32位，一共4字节 */
 #define RTP_HDR_LEN_BYTE            12          /* RTP帧头固定字节数(不包含CSRC字段) */
 #define TCP_HTTP_VI_LEN_THR         1000        /* HTTP视频流报文长度阈值 */
-#define JUDGE_CACHE_LIFETIME        1           /* 待识别队列失效时间: 1s */
+#define JUDGE_CACHE_LIFETIME        1           /* 流表项单轮采样时间窗: 1s */
+#define TX_FLOW_AGING_TIME          10          /* 流表项老化时间: 10s无来包则释放 */
+#define TX_FLOW_JUDGE_PKT_NUM       10          /* 采样到该报文数后进行识别 */
 #define IP_FRAGMENT_MASK            0x1FFF      /* IP分片Fragment Offset字段 */
 /* RTP Payload_Type 编号:RFC3551 */
 #define RTP_PT_VO_G729              18          /* RTP载荷类型:18-Audio-G729 */
@@ -57,252 +59,187 @@ extern "C" {
   3 函数实现
 **************************************************************************** */
 /* ****************************************************************************
- 函 数 名  : hmac_tx_add_cfm_traffic
- 功能描述  : 将用户已识别业务加入已识别记录表
- 输入参数  : hmac用户结构体指针，TID指针，hmac_tx_major_flow_stru结构体指针
- 输出参数  :
- 返 回 值  : 成功返回HI_SUCCESS,失败返回HI_FAIL
- 调用函数  :
- 被调函数  :
+ 功能描述  : 根据五元组计算流表哈希起始位置
+**************************************************************************** */
+static inline hi_u8 hmac_tx_flow_hash(const hmac_tx_flow_info_stru *flow_info)
+{
+    hi_u32 hash = flow_info->sip ^ flow_info->dip ^ flow_info->proto ^
+        (((hi_u32)flow_info->us_sport << 16) | flow_info->us_dport); /* 16: 源端口放在高16位 */
 
- 修改历史      :
-  1.日期: 2015.09.16
-    修改内容: 生成新函数
+    hash ^= (hash >> 16); /* 16: 高位折叠到低位 */
+    hash ^= (hash >> 8);  /* 8: 高位折叠到低位 */
+    return (hi_u8)(hash & (HMAC_TX_FLOW_TABLE_SIZE - 1));
+}
+
+/* ****************************************************************************
+ 功能描述  : 流表项是否已老化
 **************************************************************************** */
-static hi_u32 hmac_tx_add_cfm_traffic(hmac_user_stru *hmac_user, hi_u8 tid, const hmac_tx_major_flow_stru *max)
+static inline hi_bool hmac_tx_flow_is_aged(const hmac_tx_flow_entry_stru *flow, hi_u32 now)
 {
-    hi_u32  time_stamp;
-    hi_u8   mark         = 0;
-    hi_u8   traffic_idx  = 0;
+    /* 强制转换为有符号数防止jiffies溢出 */
+    return ((hi_s32)(now - flow->last_jiffies) > (hi_s32)(TX_FLOW_AGING_TIME * HZ)) ? HI_TRUE : HI_FALSE;
+}
 
-    hmac_tx_cfm_flow_stru *cfm_info = HI_NULL;
+/* ****************************************************************************
+ 功能描述  : 在用户流表中查找业务流，找不到时分配表项(优先空闲或已老化表项，否则替换最久未来包的表项)
+ 返 回 值  : 流表项指针，is_new指示是否为新分配表项
+**************************************************************************** */
+static hmac_tx_flow_entry_stru *hmac_tx_flow_lookup(hmac_user_stru *hmac_user,
+    const hmac_tx_flow_info_stru *flow_info, hi_u32 now, hi_u8 *is_new)
+{
+    hmac_tx_flow_entry_stru *victim = HI_NULL;
+    hi_u8 start = hmac_tx_flow_hash(flow_info);
 
-    if (hmac_user->cfm_num == MAX_CONFIRMED_FLOW_NUM) {
-        /* 已识别列表已满，将列表中最长时间没有来包的业务进行替换 */
-        time_stamp = hmac_user->ast_cfm_flow_list[traffic_idx].last_jiffies;
+    /* 表项数很少，线性探测整张表即可保证单包开销有界；命中通常发生在哈希起始位置 */
+    for (hi_u8 loop = 0; loop < HMAC_TX_FLOW_TABLE_SIZE; loop++) {
+        hmac_tx_flow_entry_stru *flow =
+            &hmac_user->ast_tx_flow_table[(start + loop) & (HMAC_TX_FLOW_TABLE_SIZE - 1)];
 
-        for (traffic_idx = 1; traffic_idx < MAX_CONFIRMED_FLOW_NUM; traffic_idx++) {
-            cfm_info = (hmac_user->ast_cfm_flow_list + traffic_idx);
-            if (time_stamp > cfm_info->last_jiffies) {
-                time_stamp = cfm_info->last_jiffies;
-                mark = traffic_idx;
-            }
+        if (flow->state == HMAC_TX_FLOW_STATE_FREE) {
+            victim = (victim == HI_NULL || victim->state != HMAC_TX_FLOW_STATE_FREE) ? flow : victim;
+            continue;
         }
-    } else {
-        /* 已识别列表不满，找到可记录的index */
-        for (traffic_idx = 0; traffic_idx < MAX_CONFIRMED_FLOW_NUM; traffic_idx++) {
-            cfm_info = (hmac_user->ast_cfm_flow_list + traffic_idx);
-            if (cfm_info->us_cfm_flag == HI_FALSE) {
-                mark = traffic_idx;
-                hmac_user->cfm_num++;
-                cfm_info->us_cfm_flag = HI_TRUE;
-                break;
+        if (memcmp(&flow->flow_info, flow_info, sizeof(hmac_tx_flow_info_stru)) == 0) {
+            if (hmac_tx_flow_is_aged(flow, now) == HI_FALSE) {
+                *is_new = HI_FALSE;
+                return flow;
             }
+            victim = flow; /* 同一流已老化，原地重新识别 */
+            break;
+        }
+        if ((victim == HI_NULL) || ((victim->state != HMAC_TX_FLOW_STATE_FREE) &&
+            ((hi_s32)(flow->last_jiffies - victim->last_jiffies) < 0))) {
+            victim = flow;
         }
     }
 
-    /* 更新列表 */
-    cfm_info = (hmac_user->ast_cfm_flow_list + mark);
-
-    if (memcpy_s(&cfm_info->cfm_flow_info, sizeof(hmac_tx_flow_info_stru), &max->flow_info,
-        sizeof(hmac_tx_flow_info_stru)) != EOK) {
-        oam_error_log0(0, OAM_SF_CFG, "hmac_tx_add_cfm_traffic:: st_flow_info memcpy_s fail.");
-        return HI_FALSE;
+    if (memset_s(victim, sizeof(hmac_tx_flow_entry_stru), 0, sizeof(hmac_tx_flow_entry_stru)) != EOK) {
+        return HI_NULL;
     }
-
-    cfm_info->us_cfm_tid   = tid;
-    cfm_info->last_jiffies = hi_get_tick();
-
-    return HI_SUCCESS;
+    victim->flow_info = *flow_info;
+    *is_new = HI_TRUE;
+    return victim;
 }
 
 /* ****************************************************************************
- 函 数 名  : hmac_tx_traffic_judge
- 功能描述  : 对主要业务进行业务识别处理
- 输入参数  : hmac用户结构体指针，主要业务结构体指针，TID指针
- 输出参数  : TID
- 返 回 值  :
- 调用函数  :
- 被调函数  :
+ 功能描述  : 以当前报文作为参考，开始新一轮RTP采样
+**************************************************************************** */
+static hi_void hmac_tx_flow_learn_start(hmac_tx_flow_entry_stru *flow, const hmac_tx_rtp_hdr *rtp_hdr,
+    hi_u32 payload_len, hi_u32 now)
+{
+    flow->state         = HMAC_TX_FLOW_STATE_LEARNING;
+    flow->first_jiffies = now;
+    flow->us_pkt_num    = 1;
+    flow->len_sum       = payload_len;
+    flow->rtpver        = rtp_hdr->version_and_csrc;
+    flow->payload_type  = rtp_hdr->payload_type;
+    /* pst_rtp_hdr:为2字节对齐地址，4字节变量需拷贝读取 */
+    if (memcpy_s(&flow->rtpssrc, sizeof(hi_u32), &rtp_hdr->ssrc, sizeof(hi_u32)) != EOK) {
+        flow->state = HMAC_TX_FLOW_STATE_BULK;
+    }
+}
 
- 修改历史      :
-  1.日期: 2015.11.26
-    修改内容: 生成新函数
-  2.日期: 2015.12.26
-    修改内容: TCP识别功能裁剪
+/* ****************************************************************************
+ 功能描述  : 采样完成后依据RTP载荷类型识别业务流
 **************************************************************************** */
-static hi_u32 hmac_tx_traffic_judge(hmac_user_stru *hmac_user, const hmac_tx_major_flow_stru *major_flow, hi_u8 *puc_tid)
+static hi_void hmac_tx_flow_judge(hmac_tx_flow_entry_stru *flow)
 {
-    hi_u32 ret = HI_FAIL;
-    hi_u8  cache_idx;
-    hi_u32 pt;
-
-    hmac_tx_judge_list_stru *judge_list = &(hmac_user->judge_list);
-    hmac_tx_judge_info_stru *judge_info = HI_NULL;
-
-    /* 主要业务帧为UDP帧，进行RTP帧检测 */
-    for (cache_idx = 0; cache_idx < MAX_JUDGE_CACHE_LENGTH; cache_idx++) {
-        judge_info = (hmac_tx_judge_info_stru *)(judge_list->ast_judge_cache + cache_idx);
-
-        if (!memcmp(&judge_info->flow_info, &major_flow->flow_info, sizeof(hmac_tx_flow_info_stru))) {
-            /* RTP帧判断标准:version位保持为2，SSRC、PT保持不变，且帧长度大于RTP包头长度 */
-            if (((judge_info->rtpver >> RTP_VER_SHIFT) != RTP_VERSION) ||
-                (major_flow->rtpssrc      != judge_info->rtpssrc) ||
-                (major_flow->payload_type != judge_info->payload_type) ||
-                (major_flow->average_len <
-                (hi_u32)(judge_info->rtpver & RTP_CSRC_MASK) * RTP_CSRC_LEN_BYTE + RTP_HDR_LEN_BYTE)) {
-                hmac_user->judge_list.to_judge_num = 0; /* 识别失败，清空队列 */
-                return HI_FAIL;
-            }
-        }
+    hi_u32 average_len = flow->len_sum / flow->us_pkt_num;
+    hi_u32 pt = (flow->payload_type & (~BIT7));
+
+    /* 帧平均长度需大于RTP包头长度 */
+    if (((flow->rtpver >> RTP_VER_SHIFT) != RTP_VERSION) ||
+        (average_len < (hi_u32)(flow->rtpver & RTP_CSRC_MASK) * RTP_CSRC_LEN_BYTE + RTP_HDR_LEN_BYTE)) {
+        flow->state = HMAC_TX_FLOW_STATE_BULK;
+        return;
     }
 
-    pt = (major_flow->payload_type & (~BIT7));
+    flow->state = HMAC_TX_FLOW_STATE_RTP;
     if (pt <= RTP_PT_VO_G729) { /* 依据PayloadType判断RTP载荷类型 */
-        *puc_tid = WLAN_TIDNO_VOICE;
+        flow->tid = WLAN_TIDNO_VOICE;
     } else if ((pt == RTP_PT_VI_CELB) || (pt == RTP_PT_VI_JPEG) || (pt == RTP_PT_VI_NV) ||
         ((pt >= RTP_PT_VI_H261) && (pt <= RTP_PT_VI_H263))) {
-        *puc_tid = WLAN_TIDNO_VIDEO;
-    }
-
-    /* 识别成功，更新用户已识别流列表 */
-    if ((*puc_tid == WLAN_TIDNO_VOICE) || (*puc_tid == WLAN_TIDNO_VIDEO)) {
-        ret = hmac_tx_add_cfm_traffic(hmac_user, *puc_tid, major_flow);
+        flow->tid = WLAN_TIDNO_VIDEO;
+    } else {
+        flow->state = HMAC_TX_FLOW_STATE_BULK;
     }
-    hmac_user->judge_list.to_judge_num = 0; /* 识别完成，清空队列 */
-
-    return ret;
 }
 
 /* ****************************************************************************
- 函 数 名  : hmac_tx_find_major_traffic
- 功能描述  : 找到待识别队列中主要业务
- 输入参数  : hmac用户结构体指针，TID指针
- 输出参数  :
- 返 回 值  : 成功返回HI_SUCCESS，失败返回HI_FAIL
- 调用函数  :
- 被调函数  :
-
- 修改历史      :
-  1.日期: 2015.11.26
-    修改内容: 生成新函数
+ 功能描述  : 采样阶段的增量处理: RTP头一致则累加统计，达到采样数后识别；不一致则判为普通流
 **************************************************************************** */
-static hi_u32 hmac_tx_find_major_traffic(hmac_user_stru *hmac_user, hi_u8 *puc_tid)
+static hi_void hmac_tx_flow_learn(hmac_tx_flow_entry_stru *flow, const hmac_tx_rtp_hdr *rtp_hdr,
+    hi_u32 payload_len, hi_u32 now)
 {
-    hmac_tx_major_flow_stru mark = { 0 };
-    hmac_tx_major_flow_stru max = { 0 };
-    hmac_tx_judge_list_stru *judge_list = &(hmac_user->judge_list);
-    hmac_tx_judge_info_stru *judge_info = HI_NULL;
-
-    /* 队列超时，清空队列记录 */
-    if (((hi_s32)judge_list->jiffies_end - (hi_s32)judge_list->jiffies_st) > (hi_s32)(JUDGE_CACHE_LIFETIME * HZ)) {
-        /* 强制转换为long防止jiffies溢出 */
-        hmac_user->judge_list.to_judge_num = 0; /* 清空队列 */
-        return HI_FAIL;
-    }
-
-    /* 队列已满且未超时 */
-    for (hi_u8 cache_idx_i = 0; cache_idx_i < (MAX_JUDGE_CACHE_LENGTH >> 1); cache_idx_i++) {
-        judge_info = (hmac_tx_judge_info_stru *)(judge_list->ast_judge_cache + cache_idx_i);
+    hi_u32 ssrc;
 
-        if (judge_info->flag == HI_FALSE) {
-            continue;
-        }
-
-        judge_info->flag = HI_FALSE;
-        if (memcpy_s(&mark, sizeof(hmac_tx_judge_info_stru), judge_info, sizeof(hmac_tx_judge_info_stru)) != EOK) {
-            oam_error_log0(0, OAM_SF_CFG, "hmac_tx_find_major_traffic:: pst_judge_info memcpy_s fail.");
-            continue;
-        }
-        mark.wait_check_num = 1;
-
-        for (hi_u8 cache_idx_j = 0; cache_idx_j < MAX_JUDGE_CACHE_LENGTH; cache_idx_j++) {
-            judge_info = (hmac_tx_judge_info_stru *)(judge_list->ast_judge_cache + cache_idx_j);
-
-            if ((judge_info->flag == HI_TRUE) &&
-                !memcmp(&judge_info->flow_info, &mark.flow_info, sizeof(hmac_tx_flow_info_stru))) {
-                judge_info->flag    = HI_FALSE;
-                mark.average_len    += judge_info->len;
-                mark.wait_check_num += 1;
-            }
-
-            if (mark.wait_check_num <= max.wait_check_num) {
-                continue;
-            }
-            if (memcpy_s(&max, sizeof(hmac_tx_major_flow_stru), &mark, sizeof(hmac_tx_major_flow_stru)) != EOK) {
-                oam_error_log0(0, OAM_SF_CFG, "hmac_tx_find_major_traffic:: st_mark memcpy_s fail.");
-                continue;
-            }
-            if (max.wait_check_num >= (MAX_JUDGE_CACHE_LENGTH >> 1)) {
-                /* 已找到主要业务流，不必继续搜索 */
-                max.average_len = max.average_len / max.wait_check_num;
-                return hmac_tx_traffic_judge(hmac_user, &max, puc_tid);
-            }
-        }
+    /* 采样时间窗超时仍未采满，说明来包稀疏，以当前报文重新开始采样 */
+    if ((hi_s32)(now - flow->first_jiffies) > (hi_s32)(JUDGE_CACHE_LIFETIME * HZ)) {
+        hmac_tx_flow_learn_start(flow, rtp_hdr, payload_len, now);
+        return;
     }
 
-    if (max.wait_check_num < (MAX_JUDGE_CACHE_LENGTH >> 2)) { /* 2:右移2位 */
-        /* 认为没有主要业务流 */
-        hmac_user->judge_list.to_judge_num = 0; /* 清空队列 */
-        return HI_FAIL;
+    if (memcpy_s(&ssrc, sizeof(hi_u32), &rtp_hdr->ssrc, sizeof(hi_u32)) != EOK) {
+        return;
+    }
+    /* RTP帧判断标准:version位、SSRC、PT保持不变 */
+    if ((rtp_hdr->version_and_csrc != flow->rtpver) || (rtp_hdr->payload_type != flow->payload_type) ||
+        (ssrc != flow->rtpssrc)) {
+        flow->state = HMAC_TX_FLOW_STATE_BULK;
+        return;
     }
 
-    max.average_len = max.average_len / max.wait_check_num;
-    return hmac_tx_traffic_judge(hmac_user, &max, puc_tid);
+    flow->us_pkt_num++;
+    flow->len_sum += payload_len;
+    if (flow->us_pkt_num >= TX_FLOW_JUDGE_PKT_NUM) {
+        hmac_tx_flow_judge(flow);
+        oam_info_log2(0, OAM_SF_TX, "{hmac_tx_flow_learn::flow judged, state[%d] tid[%d].}",
+            flow->state, flow->tid);
+    }
 }
 
-hi_void hmac_tx_traffic_classify_list_proc(const mac_ip_header_stru *ip, hi_u8 *puc_tid,
-    const hmac_tx_flow_info_stru *flow_info, hmac_user_stru *hmac_user, udp_hdr_stru *udp_hdr)
+/* ****************************************************************************
+ 功能描述  : 查找来包所属流表项并在线识别: 已识别为RTP流直接返回TID，普通流不修改TID
+**************************************************************************** */
+static hi_void hmac_tx_flow_classify(hmac_user_stru *hmac_user, const hmac_tx_flow_info_stru *flow_info,
+    const mac_ip_header_stru *ip, hi_u8 *puc_tid)
 {
-    /* 来包尚未识别，存入用户待识别队列 */
-    hmac_tx_judge_list_stru *judge_list = &(hmac_user->judge_list);
-    hmac_tx_judge_info_stru *judge_info = (hmac_tx_judge_info_stru *)(judge_list->ast_judge_cache +
-        judge_list->to_judge_num);
-
-    if (judge_list->to_judge_num >= MAX_JUDGE_CACHE_LENGTH) { /* 队列已满，识别过程中的来包不作记录 */
+    hi_u8 is_new = HI_FALSE;
+    hi_u32 now = hi_get_tick();
+    hmac_tx_flow_entry_stru *flow = hmac_tx_flow_lookup(hmac_user, flow_info, now, &is_new);
+    if (flow == HI_NULL) {
         return;
     }
+    flow->last_jiffies = now; /* 更新业务最新来包时间 */
 
-    judge_list->jiffies_end = hi_get_tick();    /* 更新最新来包时间 */
-    if (judge_list->to_judge_num == 0) {        /* 若队列为空 */
-        judge_list->jiffies_st = hi_get_tick(); /* 更新队列产生时间 */
-    }
-    judge_list->to_judge_num += 1; /* 更新队列长度 */
-
-    if (memset_s(judge_info, sizeof(hmac_tx_judge_info_stru), 0, sizeof(hmac_tx_judge_info_stru)) != EOK) {
+    if (flow->state == HMAC_TX_FLOW_STATE_RTP) {
+        *puc_tid = flow->tid;
         return;
     }
-    if (memcpy_s(&(judge_info->flow_info), sizeof(hmac_tx_flow_info_stru), flow_info,
-                 sizeof(hmac_tx_flow_info_stru)) != EOK) {
-        oam_error_log0(0, OAM_SF_CFG, "hmac_tx_traffic_classify:: st_flow_info memcpy_s fail.");
+    if (flow->state == HMAC_TX_FLOW_STATE_BULK) {
         return;
     }
 
-    hmac_tx_rtp_hdr *rtp_hdr = (hmac_tx_rtp_hdr *)(udp_hdr + 1);                 /* 偏移一个UDP头，取RTP头 */
+    /* 偏移IP头与UDP头，取RTP头 */
+    const hmac_tx_rtp_hdr *rtp_hdr = (const hmac_tx_rtp_hdr *)((const udp_hdr_stru *)(ip + 1) + 1);
+    hi_u16 us_tot_len = oal_net2host_short(ip->us_tot_len);
+    hi_u32 payload_len = (us_tot_len > sizeof(mac_ip_header_stru) + sizeof(udp_hdr_stru)) ?
+        (us_tot_len - sizeof(mac_ip_header_stru) - sizeof(udp_hdr_stru)) : 0;
 
-    judge_info->flag         = HI_TRUE;
-    judge_info->len          = oal_net2host_short(ip->us_tot_len) - sizeof(mac_ip_header_stru) - sizeof(udp_hdr_stru);
-    judge_info->rtpver       = rtp_hdr->version_and_csrc;
-    judge_info->payload_type = (hi_u32)(rtp_hdr->payload_type);
-
-    /* 此处由于2字节对齐指针引用4字节对齐变量，在liteos上会崩溃，故用linux的宏括起来 */
-    /* pst_rtp_hdr:为2字节对齐地址 */
-    if (memcpy_s(&(judge_info->rtpssrc), sizeof(hi_u32), &(rtp_hdr->ssrc), sizeof(hi_u32)) != EOK) {
-        oam_error_log0(0, OAM_SF_CFG, "hmac_tx_traffic_classify:: ul_SSRC memcpy_s fail.");
-        return;
+    if (is_new == HI_TRUE) {
+        hmac_tx_flow_learn_start(flow, rtp_hdr, payload_len, now);
+    } else {
+        hmac_tx_flow_learn(flow, rtp_hdr, payload_len, now);
     }
-
-    /* 若待识别队列已满，尝试提取队列主要业务并进行业务识别 */ /* "<=":防止进程并发使此值大于待识别队列长度而踩内存 */
-    if ((judge_list->to_judge_num >= MAX_JUDGE_CACHE_LENGTH) &&
-        (hmac_tx_find_major_traffic(hmac_user, puc_tid) != HI_SUCCESS)) {
-        oam_info_log0(0, OAM_SF_TX, "hmac_tx_traffic_classify::the classify process failed.");
+    if (flow->state == HMAC_TX_FLOW_STATE_RTP) {
+        *puc_tid = flow->tid;
     }
 }
 
 /* ****************************************************************************
  函 数 名  : hmac_tx_traffic_classify
  功能描述  : 对下行数据包进行处理:
-                若业务已被识别，直接返回TID, 若否，提取包头信息并进入待检测队列
+                提取五元组查找用户流表，已识别业务直接返回TID，未识别业务增量采样识别
  输入参数  : netbuff CB字段指针，ip头指针，TID指针
  输出参数  :
  返 回 值  :
@@ -353,17 +290,7 @@ hi_void hmac_tx_traffic_classify(const hmac_tx_ctl_stru *tx_ctl, mac_ip_header_s
     flow_info.sip      = ip->saddr;
     flow_info.proto    = (hi_u32)(ip->protocol);
 
-    /* 若来包属于用户已识别业务，直接返回TID */
-    for (hi_u8 loop = 0; loop < hmac_user->cfm_num; loop++) {
-        hmac_tx_cfm_flow_stru *cfm_info = (hmac_tx_cfm_flow_stru *)(hmac_user->ast_cfm_flow_list + loop);
-        if (!memcmp(&cfm_info->cfm_flow_info, &flow_info, sizeof(hmac_tx_flow_info_stru))) {
-            *puc_tid = (hi_u8)(cfm_info->us_cfm_tid);
-            cfm_info->last_jiffies = hi_get_tick(); /* 更新业务最新来包时间 */
-            return;
-        }
-    }
-
-    hmac_tx_traffic_classify_list_proc(ip, puc_tid, &flow_info, hmac_user, udp_hdr);
+    hmac_tx_flow_classify(hmac_user, &flow_info, ip, puc_tid);
 }
 
 #ifdef __cplusplus
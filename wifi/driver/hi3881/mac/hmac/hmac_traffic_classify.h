@@ -43,7 +43,7 @@ extern "C" {
   3结构体
 **************************************************************************** */
 /* ****************************************************************************
-    用户结构体: 包含了已识别业务、待识别业务序列
+    用户结构体: 包含了按五元组哈希的业务识别流表
     这里借助hmac_user_stru，在hmac_user_stru结构体中添加宏定义字段:
     _PRE_WLAN_FEATURE_TX_CLASSIFY_LAN_TO_WLAN
 **************************************************************************** */
@@ -38,6 +38,9 @@
 #ifdef _PRE_WLAN_FEATURE_EDCA_OPT_AP
 #include "hmac_edca_opt.h"
 #endif
+#ifdef _PRE_WLAN_FEATURE_M2U
+#include "hmac_m2u.h"
+#endif
 #ifdef __cplusplus
 #if __cplusplus
 extern "C" {
@@ -769,6 +772,36 @@ static hi_u8 hmac_tx_is_need_frag(const hmac_vap_stru *hmac_vap, const hmac_user
         (HI_FALSE == hmac_vap_ba_is_setup(hmac_user, tx_ctl->tid)));
 }
 
+/* ****************************************************************************
+ 功能描述  : 设置QOS控制字段
+**************************************************************************** */
+static hi_void hmac_tx_set_qos_ctrl(const hmac_tx_ctl_stru *tx_ctl, mac_ieee80211_qos_frame_addr4_stru *hdr_addr4)
+{
+    mac_ieee80211_qos_frame_stru *hdr = HI_NULL;
+    hi_u8 is_amsdu;
+
+    if (tx_ctl->netbuf_num == 1) {
+        is_amsdu = HI_FALSE;
+    } else {
+        is_amsdu = tx_ctl->is_amsdu;
+    }
+
+    if (tx_ctl->use_4_addr == HI_FALSE) {
+        hdr = (mac_ieee80211_qos_frame_stru *)hdr_addr4;
+        hdr->qc_tid        = tx_ctl->tid;
+        hdr->qc_eosp       = 0;
+        hdr->qc_ack_polocy = tx_ctl->ack_policy;
+        hdr->qc_amsdu      = is_amsdu;
+        hdr->qos_control.qc_txop_limit = 0;
+    } else {
+        hdr_addr4->qc_tid        = tx_ctl->tid;
+        hdr_addr4->qc_eosp       = 0;
+        hdr_addr4->qc_ack_polocy = tx_ctl->ack_policy;
+        hdr_addr4->qc_amsdu      = is_amsdu;
+        hdr_addr4->qos_control.qc_txop_limit = 0;
+    }
+}
+
 /* ****************************************************************************
  函 数 名  : hmac_tx_set_frame_ctrl
  功能描述  : 设置帧控制
@@ -787,43 +820,63 @@ static hi_u8 hmac_tx_is_need_frag(const hmac_vap_stru *hmac_vap, const hmac_user
 static hi_void hmac_tx_set_frame_ctrl(hi_u32 qos, const hmac_tx_ctl_stru *tx_ctl,
     mac_ieee80211_qos_frame_addr4_stru *hdr_addr4)
 {
-    mac_ieee80211_qos_frame_stru *hdr = HI_NULL;
-    hi_u8 is_amsdu;
     if (qos == HMAC_TX_BSS_QOS) {
-        if (tx_ctl->netbuf_num == 1) {
-            is_amsdu = HI_FALSE;
-        } else {
-            is_amsdu = tx_ctl->is_amsdu;
-        }
-
         /* 设置帧控制字段 */
         mac_hdr_set_frame_control((hi_u8 *)hdr_addr4, (WLAN_FC0_SUBTYPE_QOS | WLAN_FC0_TYPE_DATA));
 
-        /* 更新帧头长度 */
-        if (tx_ctl->use_4_addr == HI_FALSE) {
-            hdr = (mac_ieee80211_qos_frame_stru *)hdr_addr4;
-            /* 设置QOS控制字段 */
-            hdr->qc_tid        = tx_ctl->tid;
-            hdr->qc_eosp       = 0;
-            hdr->qc_ack_polocy = tx_ctl->ack_policy;
-            hdr->qc_amsdu      = is_amsdu;
-            hdr->qos_control.qc_txop_limit = 0;
-        } else {
-            /* 设置QOS控制字段 */
-            hdr_addr4->qc_tid        = tx_ctl->tid;
-            hdr_addr4->qc_eosp       = 0;
-            hdr_addr4->qc_ack_polocy = tx_ctl->ack_policy;
-            hdr_addr4->qc_amsdu      = is_amsdu;
-            hdr_addr4->qos_control.qc_txop_limit = 0;
-        }
-
-        /* 由DMAC考虑是否需要HTC */
+        /* 设置QOS控制字段，由DMAC考虑是否需要HTC */
+        hmac_tx_set_qos_ctrl(tx_ctl, hdr_addr4);
     } else {
         /* 设置帧控制字段 */
         mac_hdr_set_frame_control((hi_u8 *)hdr_addr4, WLAN_FC0_TYPE_DATA | WLAN_FC0_SUBTYPE_DATA);
     }
 }
 
+/* ****************************************************************************
+ 功能描述  : 判断当前帧能否使用用户的802.11头模板
+             仅单播、非AMSDU的3地址帧使用模板，组播、AMSDU、WDS及STA模式LLTD帧走逐字段封装流程
+**************************************************************************** */
+static hi_bool hmac_tx_hdr_template_eligible(const hmac_vap_stru *hmac_vap, const hmac_tx_ctl_stru *tx_ctl,
+    hi_u16 us_ether_type)
+{
+    if ((tx_ctl->ismcast == HI_TRUE) || (tx_ctl->is_amsdu == HI_TRUE) || (tx_ctl->use_4_addr == HI_TRUE)) {
+        return HI_FALSE;
+    }
+
+    if (hmac_vap->base_vap->vap_mode == WLAN_VAP_MODE_BSS_STA) {
+        return (hi_bool)(us_ether_type != hi_swap_byteorder_16(ETHER_LLTD_TYPE));
+    }
+
+    return (hi_bool)((hmac_vap->base_vap->vap_mode == WLAN_VAP_MODE_BSS_AP)
+#ifdef _PRE_WLAN_FEATURE_MESH
+        || (hmac_vap->base_vap->vap_mode == WLAN_VAP_MODE_MESH)
+#endif
+    );
+}
+
+/* ****************************************************************************
+ 功能描述  : 获取模板中随帧变化的地址位置及来源，与hmac_tx_set_addresses中3地址的填写规则一致
+             AP: 地址3为源地址; STA: 地址3为目的地址; Mesh用户: 地址2为源地址
+**************************************************************************** */
+static hi_u8 hmac_tx_hdr_template_var_addr(const hmac_vap_stru *hmac_vap, const hmac_user_stru *hmac_user,
+    hi_u8 *var_addr_is_sa)
+{
+    if (hmac_vap->base_vap->vap_mode == WLAN_VAP_MODE_BSS_STA) {
+        *var_addr_is_sa = HI_FALSE;
+        return WLAN_HDR_ADDR3_OFFSET;
+    }
+#ifdef _PRE_WLAN_FEATURE_MESH
+    if ((hmac_vap->base_vap->vap_mode == WLAN_VAP_MODE_MESH) && (hmac_user->base_user->is_mesh_user == HI_TRUE)) {
+        *var_addr_is_sa = HI_TRUE;
+        return WLAN_HDR_ADDR2_OFFSET;
+    }
+#else
+    hi_unref_param(hmac_user);
+#endif
+    *var_addr_is_sa = HI_TRUE;
+    return WLAN_HDR_ADDR3_OFFSET;
+}
+
 /* ****************************************************************************
  功能描述  : 3地址ap模式设置MAC头地址
 **************************************************************************** */
@@ -1038,6 +1091,52 @@ static hi_u32 hmac_tx_set_addresses(const hmac_vap_stru *hmac_vap, const hmac_us
     }
 }
 
+/* ****************************************************************************
+ 功能描述  : 使用用户的802.11头模板设置帧控制及地址
+             模板无效时按逐字段流程封装并保存为模板；模板有效时整体拷贝后只填写随帧变化的地址和QOS控制字段
+**************************************************************************** */
+static hi_u32 hmac_tx_encap_by_template(const hmac_vap_stru *hmac_vap, hmac_user_stru *hmac_user,
+    const hmac_tx_ctl_stru *tx_ctl, mac_ieee80211_qos_frame_addr4_stru *hdr,
+    const hmac_set_addresses_info_stru *set_addresses_info, hi_u32 qos)
+{
+    hmac_tx_hdr_template_stru *hdr_template = &hmac_user->tx_hdr_template;
+
+    if ((hdr_template->valid == HI_FALSE) || (hdr_template->qos != (hi_u8)qos) ||
+        (hdr_template->vap_mode != hmac_vap->base_vap->vap_mode)) {
+        hmac_tx_set_frame_ctrl(qos, tx_ctl, hdr);
+        hi_u32 ret = hmac_tx_set_addresses(hmac_vap, hmac_user, tx_ctl, (mac_ieee80211_frame_addr4_stru *)hdr,
+            set_addresses_info);
+        if (ret != HI_SUCCESS) {
+            return ret;
+        }
+
+        if (memcpy_s(hdr_template->auc_hdr, sizeof(hdr_template->auc_hdr), hdr, MAC_80211_FRAME_LEN) != EOK) {
+            return HI_SUCCESS; /* 帧头已封装完成，仅本次不保存模板 */
+        }
+        mac_hdr_set_duration(hdr_template->auc_hdr, WLAN_FC0_TYPE_DATA, 0);
+        hdr_template->var_addr_offset = hmac_tx_hdr_template_var_addr(hmac_vap, hmac_user,
+            &hdr_template->var_addr_is_sa);
+        hdr_template->qos      = (hi_u8)qos;
+        hdr_template->vap_mode = hmac_vap->base_vap->vap_mode;
+        hdr_template->valid    = HI_TRUE;
+        return HI_SUCCESS;
+    }
+
+    const hi_u8 *var_addr = (hdr_template->var_addr_is_sa == HI_TRUE) ?
+        set_addresses_info->puc_saddr : set_addresses_info->puc_daddr;
+    if ((memcpy_s(hdr, MAC_80211_FRAME_LEN, hdr_template->auc_hdr, MAC_80211_FRAME_LEN) != EOK) ||
+        (memcpy_s((hi_u8 *)hdr + hdr_template->var_addr_offset, WLAN_MAC_ADDR_LEN, var_addr,
+        WLAN_MAC_ADDR_LEN) != EOK)) {
+        return HI_FAIL;
+    }
+
+    if (qos == HMAC_TX_BSS_QOS) {
+        hmac_tx_set_qos_ctrl(tx_ctl, hdr);
+    }
+
+    return HI_SUCCESS;
+}
+
 /* ****************************************************************************
  函 数 名  : hmac_tx_encap
  功能描述  : 802.11帧头封装 AP模式
@@ -1056,7 +1155,7 @@ static hi_u32 hmac_tx_set_addresses(const hmac_vap_stru *hmac_vap, const hmac_us
 
 **************************************************************************** */
 /* 编程规范规则5.1 避免函数过长，函数不超过50行（非空非注释），申请例外: 帧封装函数，功能聚合完整，不建议拆分 */
-hi_u32 hmac_tx_encap(const hmac_vap_stru *hmac_vap, const hmac_user_stru *hmac_user, oal_netbuf_stru *netbuf)
+hi_u32 hmac_tx_encap(const hmac_vap_stru *hmac_vap, hmac_user_stru *hmac_user, oal_netbuf_stru *netbuf)
 {
     mac_ieee80211_qos_frame_addr4_stru       *hdr = HI_NULL;             /* 802.11头 */
     mac_ieee80211_qos_htc_frame_addr4_stru   *hdr_max = HI_NULL;         /* 最大的802.11头，申请空间使用 */
@@ -1135,15 +1234,20 @@ hi_u32 hmac_tx_encap(const hmac_vap_stru *hmac_vap, const hmac_user_stru *hmac_u
         hdr = (mac_ieee80211_qos_frame_addr4_stru *)oal_netbuf_data(netbuf);
     }
 
-    /* 设置帧控制 */
-    hmac_tx_set_frame_ctrl(qos, tx_ctl, hdr);
-
-    /* 设置地址 */
     set_addresses_info.puc_saddr = auc_saddr;
     set_addresses_info.puc_daddr = auc_daddr;
     set_addresses_info.us_ether_type = us_ether_type;
-    ret = hmac_tx_set_addresses(hmac_vap, hmac_user, tx_ctl, (mac_ieee80211_frame_addr4_stru *)hdr,
-        &set_addresses_info);
+    if (hmac_tx_hdr_template_eligible(hmac_vap, tx_ctl, us_ether_type)) {
+        /* 单播3地址帧使用用户的802.11头模板 */
+        ret = hmac_tx_encap_by_template(hmac_vap, hmac_user, tx_ctl, hdr, &set_addresses_info, qos);
+    } else {
+        /* 设置帧控制 */
+        hmac_tx_set_frame_ctrl(qos, tx_ctl, hdr);
+
+        /* 设置地址 */
+        ret = hmac_tx_set_addresses(hmac_vap, hmac_user, tx_ctl, (mac_ieee80211_frame_addr4_stru *)hdr,
+            &set_addresses_info);
+    }
     if (oal_unlikely(ret != HI_SUCCESS)) {
         if (tx_ctl->mac_head_type == 0) {
             oal_free(hdr_max);
@@ -1546,6 +1650,16 @@ hi_u32 hmac_tx_lan_to_wlan(mac_vap_stru *mac_vap, oal_netbuf_stru *netbuf)
         return ret;
     }
 
+#ifdef _PRE_WLAN_FEATURE_M2U
+    /* AP模式组播转单播，转换后的单播报文重新进入本函数发送 */
+    if (mac_vap->vap_mode == WLAN_VAP_MODE_BSS_AP) {
+        ret = hmac_m2u_convert(hmac_vap, netbuf);
+        if (ret != HI_CONTINUE) {
+            return ret;
+        }
+    }
+#endif
+
     /* 初始化CB tx rx字段 , CB字段在前面已经被清零， 在这里不需要重复对某些字段赋零值 */
     hmac_tx_ctl_stru* tx_ctl = (hmac_tx_ctl_stru *)oal_netbuf_cb(netbuf);
     tx_ctl->mpdu_num               = 1;
@@ -94,7 +94,7 @@ hi_u32 hmac_tx_post_event(mac_vap_stru *mac_vap);
 hi_u32 hmac_tx_event_process(oal_mem_stru *event_mem);
 #endif
 hi_u16 hmac_free_netbuf_list(oal_netbuf_stru *netbuf);
-hi_u32 hmac_tx_encap(const hmac_vap_stru *hmac_vap, const hmac_user_stru *hmac_user, oal_netbuf_stru *netbuf);
+hi_u32 hmac_tx_encap(const hmac_vap_stru *hmac_vap, hmac_user_stru *hmac_user, oal_netbuf_stru *netbuf);
 hmac_tx_return_type_enum_uint8 hmac_tx_ucast_process(hmac_vap_stru *hmac_vap, oal_netbuf_stru *netbuf,
     hmac_user_stru *hmac_user, const hmac_tx_ctl_stru *tx_ctl);
 hi_void hmac_tx_ba_setup(hmac_vap_stru *hmac_vap, hmac_user_stru *hmac_user, hi_u8 tidno);
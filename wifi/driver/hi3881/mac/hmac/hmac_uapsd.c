@@ -82,11 +82,26 @@ hi_u32 hmac_config_set_uapsden(mac_vap_stru *mac_vap, hi_u16 us_len, const hi_u8
     return ret;
 }
 
-hi_void hmac_uapsd_set_info(const hi_u8 *puc_mac_hdr, const hmac_user_stru *hmac_user, hi_u8 uapsd_flag, hi_u32 idx,
+/* QoS info中U-APSD标志位与AC的对应关系，bit0~bit3依次为VO/VI/BK/BE */
+static const hi_u8 g_auc_uapsd_qos_info_ac[WLAN_WME_AC_BUTT] = {
+    WLAN_WME_AC_VO, WLAN_WME_AC_VI, WLAN_WME_AC_BK, WLAN_WME_AC_BE
+};
+
+/* ****************************************************************************
+ 功能描述  : 将用户的U-APSD能力同步到DMAC，由DMAC的节能队列按max SP长度服务触发帧
+ 输入参数  : [1]hmac_user
+             [2]uapsd_flag
+             [3]uapsd_status
+**************************************************************************** */
+static hi_void hmac_uapsd_set_info(const hmac_user_stru *hmac_user, hi_u8 uapsd_flag,
     mac_user_uapsd_status_stru *uapsd_status)
 {
+    /* user index + uapsd flag + uapsd status，长度固定，直接使用栈上缓存 */
+    hi_u8 auc_param[sizeof(hi_u8) + sizeof(hi_u8) + sizeof(mac_user_uapsd_status_stru)];
+    hi_u16 us_len = 0;
+
     /* 设置max SP长度 */
-    hi_u8 max_sp = (puc_mac_hdr[idx + HMAC_UAPSD_WME_LEN] >> 5) & 0x3; /* 右移5位 */
+    hi_u8 max_sp = (uapsd_status->qos_info >> 5) & 0x3; /* 右移5位 */
     switch (max_sp) {
         case 1:                           /* 1 case 标志 */
             uapsd_status->max_sp_len = 2; /* 赋值为2 */
@@ -104,35 +119,25 @@ hi_void hmac_uapsd_set_info(const hi_u8 *puc_mac_hdr, const hmac_user_stru *hmac
     /* Send uapsd_flag & uapsd_status syn to dmac */
     mac_vap_stru *mac_vap = mac_vap_get_vap_stru(hmac_user->base_user->vap_id);
     if (oal_unlikely(mac_vap == HI_NULL)) {
-        oam_error_log1(0, OAM_SF_CFG, "{hmac_uapsd_update_user_para::vap %d null}", hmac_user->base_user->vap_id);
-        return;
-    }
-    hi_u16 us_len = sizeof(hi_u8);
-    hi_u16 us_len_total = sizeof(hi_u8) + sizeof(hi_u8) + sizeof(mac_user_uapsd_status_stru);
-    hi_u8 *puc_param = (hi_u8 *)oal_mem_alloc(OAL_MEM_POOL_ID_LOCAL, us_len_total);
-    if (oal_unlikely(puc_param == HI_NULL)) {
-        oam_error_log0(mac_vap->vap_id, OAM_SF_CFG, "{hmac_uapsd_update_user_para::puc_param null.}");
+        oam_error_log1(0, OAM_SF_CFG, "{hmac_uapsd_set_info::vap %d null}", hmac_user->base_user->vap_id);
         return;
     }
     // uc_user_index
-    puc_param[0] = (hi_u8)hmac_user->base_user->us_assoc_id;
+    auc_param[us_len++] = (hi_u8)hmac_user->base_user->us_assoc_id;
     // uc_uapsd_flag
-    puc_param[us_len] = uapsd_flag;
-    us_len++;
+    auc_param[us_len++] = uapsd_flag;
     // st_uapsd_status
-    if (memcpy_s(puc_param + us_len, sizeof(mac_user_uapsd_status_stru), uapsd_status,
+    if (memcpy_s(auc_param + us_len, sizeof(auc_param) - us_len, uapsd_status,
         sizeof(mac_user_uapsd_status_stru)) != EOK) {
-        oal_mem_free(puc_param);
-        oam_error_log0(0, OAM_SF_CFG, "hmac_uapsd_update_user_para:: st_uapsd_status memcpy_s fail.");
+        oam_error_log0(0, OAM_SF_CFG, "hmac_uapsd_set_info:: st_uapsd_status memcpy_s fail.");
         return;
     }
     us_len += sizeof(mac_user_uapsd_status_stru);
 
-    hi_u32 ret = hmac_config_send_event(mac_vap, WLAN_CFGID_UAPSD_UPDATE, us_len, puc_param);
+    hi_u32 ret = hmac_config_send_event(mac_vap, WLAN_CFGID_UAPSD_UPDATE, us_len, auc_param);
     if (oal_unlikely(ret != HI_SUCCESS)) {
-        oam_warning_log1(mac_vap->vap_id, OAM_SF_CFG, "{hmac_uapsd_update_user_para:hmac_config_send_event er%u}", ret);
+        oam_warning_log1(mac_vap->vap_id, OAM_SF_CFG, "{hmac_uapsd_set_info:hmac_config_send_event er%u}", ret);
     }
-    oal_mem_free(puc_param);
 }
 
 /* ****************************************************************************
@@ -145,62 +150,37 @@ hi_void hmac_uapsd_set_info(const hi_u8 *puc_mac_hdr, const hmac_user_stru *hmac
 hi_void hmac_uapsd_update_user_para(const hi_u8 *puc_mac_hdr, hi_u8 sub_type, hi_u32 msg_len,
     const hmac_user_stru *hmac_user)
 {
-    hi_u8 found_wmm = HI_FALSE;
-    hi_u8 en = HI_FALSE;
     hi_u8 uapsd_flag = 0;
+    hi_u8 ac_loop;
+    mac_ie_index_stru ie_index;
     mac_user_uapsd_status_stru uapsd_status = { 0 };
 
     hi_u32 idx = MAC_CAP_INFO_LEN + MAC_LIS_INTERVAL_IE_LEN;
     if (WLAN_FC0_SUBTYPE_REASSOC_REQ == sub_type) {
         idx += WLAN_MAC_ADDR_LEN;
     }
-    while (idx < msg_len) {
-        if (HI_TRUE != mac_is_wmm_ie((puc_mac_hdr + idx))) {
-            idx += (MAC_IE_HDR_LEN + puc_mac_hdr[(idx + 1)]);
-            continue;
-        }
-        found_wmm = HI_TRUE;
-        break;
-    }
+    /* 按IE长度做边界检查查找WMM IE，且IE必须包含QoS info字段 */
+    mac_ie_build_index(&ie_index, (idx < msg_len) ? (hi_u8 *)(puc_mac_hdr + idx) : HI_NULL,
+        (idx < msg_len) ? (msg_len - idx) : 0);
+    const hi_u8 *puc_wmm_ie = mac_ie_index_find(&ie_index, MAC_IE_IDX_WMM);
     /* 不存在WMM IE,直接返回 */
-    if (found_wmm == HI_FALSE) {
+    if ((puc_wmm_ie == HI_NULL) || (puc_wmm_ie[1] < HMAC_UAPSD_WME_LEN - MAC_IE_HDR_LEN + 1)) {
         oam_warning_log1(hmac_user->base_user->vap_id, OAM_SF_PWR, "Could not find WMM IE in assoc req,user_id[%d]\n",
             hmac_user->base_user->us_assoc_id);
         return;
     }
 
-    uapsd_status.qos_info = puc_mac_hdr[idx + HMAC_UAPSD_WME_LEN];
-
-    /* 8为WMM IE长度 */
-    if (BIT0 == (puc_mac_hdr[idx + HMAC_UAPSD_WME_LEN] & BIT0)) {
-        uapsd_status.ac_trigger_ena[WLAN_WME_AC_VO] = 1;
-        uapsd_status.ac_delievy_ena[WLAN_WME_AC_VO] = 1;
-        en = HI_TRUE;
-    }
-
-    if (BIT1 == (puc_mac_hdr[idx + HMAC_UAPSD_WME_LEN] & BIT1)) {
-        uapsd_status.ac_trigger_ena[WLAN_WME_AC_VI] = 1;
-        uapsd_status.ac_delievy_ena[WLAN_WME_AC_VI] = 1;
-        en = HI_TRUE;
-    }
-
-    if (BIT2 == (puc_mac_hdr[idx + HMAC_UAPSD_WME_LEN] & BIT2)) {
-        uapsd_status.ac_trigger_ena[WLAN_WME_AC_BK] = 1;
-        uapsd_status.ac_delievy_ena[WLAN_WME_AC_BK] = 1;
-        en = HI_TRUE;
-    }
-
-    if (BIT3 == (puc_mac_hdr[idx + HMAC_UAPSD_WME_LEN] & BIT3)) {
-        uapsd_status.ac_trigger_ena[WLAN_WME_AC_BE] = 1;
-        uapsd_status.ac_delievy_ena[WLAN_WME_AC_BE] = 1;
-        en = HI_TRUE;
-    }
-
-    if (en == HI_TRUE) {
-        uapsd_flag |= MAC_USR_UAPSD_EN;
+    /* 8为WMM IE中QoS info的偏移 */
+    uapsd_status.qos_info = puc_wmm_ie[HMAC_UAPSD_WME_LEN];
+    for (ac_loop = 0; ac_loop < WLAN_WME_AC_BUTT; ac_loop++) {
+        if ((uapsd_status.qos_info & bit(ac_loop)) != 0) {
+            uapsd_status.ac_trigger_ena[g_auc_uapsd_qos_info_ac[ac_loop]] = 1;
+            uapsd_status.ac_delievy_ena[g_auc_uapsd_qos_info_ac[ac_loop]] = 1;
+            uapsd_flag |= MAC_USR_UAPSD_EN;
+        }
     }
 
-    hmac_uapsd_set_info(puc_mac_hdr, hmac_user, uapsd_flag, idx, &uapsd_status);
+    hmac_uapsd_set_info(hmac_user, uapsd_flag, &uapsd_status);
 }
 
 #ifdef __cplusplus
@@ -30,10 +30,14 @@
 #include "hmac_chan_mgmt.h"
 #include "hmac_event.h"
 #include "hcc_hmac_if.h"
+#include "hmac_frag.h"
 #ifdef _PRE_WLAN_FEATURE_MESH
 #include "wlan_types.h"
 #include "hmac_vap.h"
 #endif
+#ifdef _PRE_WLAN_FEATURE_M2U
+#include "hmac_m2u.h"
+#endif
 
 #ifdef __cplusplus
 #if __cplusplus
@@ -420,9 +424,7 @@ hi_u32 hmac_sync_del_user(mac_vap_stru *mac_vap, hmac_user_stru *hmac_user, cons
         oal_mem_free(hmac_user->ch_text);
         hmac_user->ch_text = HI_NULL;
     }
-    if (hmac_user->defrag_timer.is_registerd == HI_TRUE) {
-        frw_timer_immediate_destroy_timer(&hmac_user->defrag_timer);
-    }
+    hmac_defrag_clear(hmac_user);
     /* 从vap中删除用户 */
     mac_vap_del_user(mac_vap, user_index);
 
@@ -486,6 +488,11 @@ hi_u32 hmac_user_del(mac_vap_stru *mac_vap, hmac_user_stru *hmac_user)
     hmac_stop_sa_query_timer(hmac_user);
 #endif
 
+#ifdef _PRE_WLAN_FEATURE_M2U
+    /* 删除该用户在组播转单播成员表中的记录 */
+    hmac_m2u_del_user(mac_vap, user_index);
+#endif
+
     hi_u32 ret = hmac_user_del_wapi_sta_mesh_proc(hmac_user, mac_vap, mac_user);
     if (ret != HI_SUCCESS) {
         return ret;
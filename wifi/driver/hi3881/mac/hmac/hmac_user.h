@@ -36,6 +36,8 @@ extern "C" {
   2 宏定义
 **************************************************************************** */
 #define HMAC_ADDBA_EXCHANGE_ATTEMPTS 10 /* 试图建立ADDBA会话的最大允许次数 */
+#define HMAC_DEFRAG_CTX_NUM          3  /* 每用户同时重组的MSDU个数 */
+#define HMAC_DEFRAG_MAX_FRAG_NUM     16 /* 分片号4bit, 单个MSDU最多16个分片 */
 
 #define hmac_user_is_amsdu_support(_user, _tid)         (((_user)->amsdu_supported) & (0x01 << ((_tid) & 0x07)))
 #define hmac_user_set_amsdu_support(_user, _tid)        (((_user)->amsdu_supported) |= (0x01 << ((_tid) & 0x07)))
@@ -43,8 +45,7 @@ extern "C" {
     (hi_u8)(~(0x01 << ((_tid) & 0x07))))
 
 #ifdef _PRE_WLAN_FEATURE_TX_CLASSIFY_LAN_TO_WLAN
-#define MAX_JUDGE_CACHE_LENGTH 20 /* 业务识别-用户待识别队列长度 */
-#define MAX_CONFIRMED_FLOW_NUM 2  /* 业务识别-用户已识别业务总数 */
+#define HMAC_TX_FLOW_TABLE_SIZE 8 /* 业务识别-用户流表项数，须为2的幂 */
 #endif
 
 #define hmac_user_stats_pkt_incr(_member, _cnt) ((_member) += (_cnt))
@@ -163,6 +164,7 @@ typedef struct {
 #define WAPI_KEY_LEN                    16
 #define WAPI_PN_LEN                     16
 #define HMAC_WAPI_MAX_KEYID             2
+#define WAPI_ROUND_KEY_NUM              32      /* SMS4轮密钥个数 */
 
 typedef struct {
     hi_u32 ulrx_mic_calc_fail; /* 由于参数错误导致mic计算错误 */
@@ -190,6 +192,8 @@ typedef struct {
     hi_u8 auc_wpi_ck[WAPI_KEY_LEN];
     hi_u8 auc_pn_rx[WAPI_PN_LEN];
     hi_u8 auc_pn_tx[WAPI_PN_LEN];
+    hi_u32 aul_ek_rk[WAPI_ROUND_KEY_NUM]; /* 安装密钥时由ek扩展的轮密钥 */
+    hi_u32 aul_ck_rk[WAPI_ROUND_KEY_NUM]; /* 安装密钥时由ck扩展的轮密钥 */
     hi_u8 key_en;
     hi_u8 auc_rsv[3]; /* 3 保留字节 */
 } hmac_wapi_key_stru;
@@ -228,57 +232,57 @@ typedef struct {
     hi_u32 proto; /* 协议 */
 } hmac_tx_flow_info_stru;
 
-/* 业务识别-待识别队列结构体: */
-typedef struct {
-    hmac_tx_flow_info_stru flow_info;
-
-    hi_u32 len; /* 来包长度 */
-    hi_u8  flag; /* 有效位，用于计数 */
-
-    hi_u8  udp_flag; /* udp flag为1即为UDP帧 */
-    hi_u8  tcp_flag; /* tcp flag为1即为TCP帧 */
+/* 业务识别-流表项状态 */
+typedef enum {
+    HMAC_TX_FLOW_STATE_FREE     = 0, /* 表项空闲 */
+    HMAC_TX_FLOW_STATE_LEARNING = 1, /* 正在采样识别 */
+    HMAC_TX_FLOW_STATE_RTP      = 2, /* 已识别为RTP语音/视频流，使用表项中TID */
+    HMAC_TX_FLOW_STATE_BULK     = 3, /* 已识别为普通流，不修改TID */
 
-    hi_u8  rtpver;        /* RTP version */
-    hi_u32 rtpssrc;      /* RTP SSRC */
-    hi_u32 payload_type; /* RTP:标记1bit、有效载荷类型(PT)7bit */
-} hmac_tx_judge_info_stru;
+    HMAC_TX_FLOW_STATE_BUTT
+} hmac_tx_flow_state_enum;
+typedef hi_u8 hmac_tx_flow_state_enum_uint8;
 
-/* 业务识别-待识别队列主要业务结构体: */
+/* 业务识别-流表项: 按五元组哈希存放，随来包增量统计并在线识别 */
 typedef struct {
     hmac_tx_flow_info_stru flow_info;
 
-    hi_u32 average_len; /* 业务来包平均长度 */
-    hi_u8  flag;         /* 有效位 */
+    hi_u32 first_jiffies; /* 本轮采样起始时间 */
+    hi_u32 last_jiffies;  /* 最新来包时间，用于老化 */
+    hi_u32 len_sum;       /* 本轮采样的报文载荷长度累加 */
+    hi_u32 rtpssrc;       /* 采样首包的RTP SSRC */
 
-    hi_u8  udp_flag; /* udp flag为1即为UDP帧 */
-    hi_u8  tcp_flag; /* tcp flag为1即为TCP帧 */
+    hi_u16 us_pkt_num;    /* 本轮采样的报文个数 */
+    hi_u8  rtpver;        /* 采样首包的RTP version及CSRC数 */
+    hi_u8  payload_type;  /* 采样首包的RTP:标记1bit、有效载荷类型(PT)7bit */
 
-    hi_u8  rtpver;        /* RTP version */
-    hi_u32 rtpssrc;      /* RTP SSRC */
-    hi_u32 payload_type; /* 标记1bit、有效载荷类型(PT)7bit */
-
-    hi_u32 wait_check_num; /* 待检测列表中此业务包个数 */
-} hmac_tx_major_flow_stru;
+    hmac_tx_flow_state_enum_uint8 state;
+    hi_u8  tid;           /* 识别完成后的TID */
+    hi_u8  auc_resv[2];   /* 2 保留字节 */
+} hmac_tx_flow_entry_stru;
+#endif
 
-/* 业务识别-用户已识别结构体: */
+/* 802.11头模板: 单播3地址数据帧的帧控制及地址字段，封装时整体拷贝后只修改随帧变化的字段 */
 typedef struct {
-    hmac_tx_flow_info_stru cfm_flow_info; /* 已识别业务的五元组信息 */
-
-    hi_u32 last_jiffies; /* 记录已识别业务的最新来包时间 */
-    hi_u16 us_cfm_tid;   /* 已识别业务tid */
-
-    hi_u16 us_cfm_flag; /* 有效位 */
-} hmac_tx_cfm_flow_stru;
-
-/* 业务识别-用户待识别业务队列: */
+    hi_u8 auc_hdr[MAC_80211_FRAME_LEN]; /* 不含QOS控制字段的802.11头 */
+    hi_u8 valid;                        /* 模板是否有效 */
+    hi_u8 qos;                          /* 生成模板时用户的QOS能力 */
+    hi_u8 vap_mode;                     /* 生成模板时vap的模式 */
+    hi_u8 var_addr_offset;              /* 随帧变化的地址在帧头中的偏移 */
+    hi_u8 var_addr_is_sa;               /* 随帧变化的地址取源地址(HI_TRUE)或目的地址(HI_FALSE) */
+    hi_u8 auc_resv[3];                  /* 3 保留字节 */
+} hmac_tx_hdr_template_stru;
+
+/* 去分片重组上下文，分片按到达顺序挂在数组中，收齐后一次性拷贝成完整MSDU */
 typedef struct {
-    hi_u32 jiffies_st; /* 记录待识别业务队列的起始时间与最新来包时间 */
-    hi_u32 jiffies_end;
-    hi_u32 to_judge_num; /* 用户待识别业务队列长度 */
-
-    hmac_tx_judge_info_stru ast_judge_cache[MAX_JUDGE_CACHE_LENGTH]; /* 待识别流队列 */
-} hmac_tx_judge_list_stru;
-#endif
+    oal_netbuf_stru *past_frag[HMAC_DEFRAG_MAX_FRAG_NUM]; /* 已收到的分片, 下标即分片号 */
+    hi_u32 last_ms;                     /* 最近一次收到分片的时间 */
+    hi_u16 us_seq_num;                  /* 正在重组的MSDU序列号 */
+    hi_u16 us_total_len;                /* 重组后的总长度(含首片MAC头) */
+    hi_u8 tid;
+    hi_u8 frag_cnt;                     /* 已收到的分片个数, 0表示上下文空闲 */
+    hi_u8 auc_resv[2];                  /* 2 保留字节 */
+} hmac_defrag_ctx_stru;
 
 typedef struct {
     hi_u8                       amsdu_supported;             /* 每个位代表某个TID是否支持AMSDU */
@@ -289,19 +293,22 @@ typedef struct {
     hmac_tid_stru               ast_tid_info[WLAN_TID_MAX_NUM];            /* 保存与TID相关的信息 */
     hi_u8                      *ch_text;                                  /* WEP用的挑战明文 */
     frw_timeout_stru            mgmt_timer;                              /* 认证关联用定时器 */
-    frw_timeout_stru            defrag_timer;                            /* 去分片超时定时器 */
-    oal_netbuf_stru            *defrag_netbuf;
+    frw_timeout_stru            defrag_timer;                            /* 去分片超时定时器，所有重组上下文共用 */
+    hmac_defrag_ctx_stru        ast_defrag_ctx[HMAC_DEFRAG_CTX_NUM];     /* 按TID+序列号区分的去分片上下文 */
 #ifdef _PRE_WLAN_FEATURE_PMF
     mac_sa_query_stru           sa_query_info;                      /* sa query流程的控制信息 */
 #endif
     mac_rate_stru               op_rates;                           /* user可选速率 AP侧保存STA速率；STA侧保存AP速率 */
     hmac_user_cap_info_stru     hmac_cap_info;                      /* hmac侧用户能力标志位 */
+    hmac_tx_hdr_template_stru   tx_hdr_template;                    /* 发送数据帧的802.11头模板 */
     hi_u32                      assoc_req_ie_len;
     hi_u8                      *puc_assoc_req_ie_buff;
 
 #ifdef _PRE_WLAN_FEATURE_EDCA_OPT_AP
     /* 发送/接收 tcp/udp be,bk,vi,vo报文 计数到HMAC_EDCA_OPT_PKT_NUM u16足够 */
     hi_u16                      txrx_data_stat[WLAN_WME_AC_BUTT][WLAN_TXRX_DATA_BUTT];
+    hi_u16                      us_edca_opt_active_bmap;   /* 各AC各类业务流是否活跃，bit = ac * 4 + 业务类型 */
+    hi_u8                       auc_edca_opt_resv[2];      /* 2 保留字节 */
 #endif
 #ifdef _PRE_WLAN_FEATURE_WAPI
     hmac_wapi_stru              wapi;
@@ -310,10 +317,7 @@ typedef struct {
     hi_u32                      rssi_last_timestamp;                /* 获取user rssi所用时间戳, 1s最多更新一次rssi */
 #endif
 #ifdef _PRE_WLAN_FEATURE_TX_CLASSIFY_LAN_TO_WLAN
-    hi_u8                       cfm_num;                            /* 用户已被识别业务个数 */
-    hi_u8                       auc_resv2[3]; /* 3 保留字节 */
-    hmac_tx_cfm_flow_stru       ast_cfm_flow_list[MAX_CONFIRMED_FLOW_NUM];  /* 已识别业务 */
-    hmac_tx_judge_list_stru     judge_list;                                 /* 待识别流队列 */
+    hmac_tx_flow_entry_stru     ast_tx_flow_table[HMAC_TX_FLOW_TABLE_SIZE]; /* 业务识别流表 */
 #endif
 #ifdef _PRE_WLAN_FEATURE_MESH
     /* 标志当前Mesh用户AMPE关联阶段是否已经收到并上报Confirm帧,关联成功时重置 */
@@ -394,6 +398,14 @@ static inline hi_u8 hmac_user_xht_support(const hmac_user_stru *hmac_user)
     return HI_FALSE;
 }
 
+/* ****************************************************************************
+ 功能描述  : 用户关联、密钥或能力变化时使802.11头模板失效，下一帧重新生成
+**************************************************************************** */
+static inline hi_void hmac_user_invalidate_tx_hdr_template(hmac_user_stru *hmac_user)
+{
+    hmac_user->tx_hdr_template.valid = HI_FALSE;
+}
+
 /* ****************************************************************************
   10 函数声明
 **************************************************************************** */
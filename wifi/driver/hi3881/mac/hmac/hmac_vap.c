@@ -29,6 +29,9 @@
 #include "hmac_ext_if.h"
 #include "hmac_chan_mgmt.h"
 #include "hmac_edca_opt.h"
+#ifdef _PRE_WLAN_FEATURE_M2U
+#include "hmac_m2u.h"
+#endif
 #include "hmac_p2p.h"
 #include "hmac_mgmt_sta.h"
 #include "hmac_mgmt_ap.h"
@@ -153,6 +156,10 @@ hi_u32 hmac_vap_mesh_ap_sta_init(hmac_vap_stru *hmac_vap, const mac_cfg_add_vap_
 #ifdef _PRE_WLAN_FEATURE_TX_CLASSIFY_LAN_TO_WLAN
             hmac_vap->tx_traffic_classify_flag = HI_SWITCH_ON; /* AP模式默认业务识别功能开启 */
 #endif
+
+#ifdef _PRE_WLAN_FEATURE_M2U
+            hmac_m2u_init(hmac_vap); /* AP模式默认组播转单播功能关闭,通过m2u_snoop_on命令开启 */
+#endif
             break;
 
         case WLAN_VAP_MODE_BSS_STA:
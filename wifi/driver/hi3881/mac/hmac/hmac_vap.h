@@ -137,6 +137,31 @@ typedef struct {
     hi_u8 reserved[2];            /* 2 保留字节 */
 } hmac_atcmdsrv_get_stats_stru;
 
+#ifdef _PRE_WLAN_FEATURE_M2U
+#define HMAC_M2U_GROUP_MAX_NUM      8   /* 每个vap侦听的组播组个数 */
+#define HMAC_M2U_MEMBER_MAX_NUM     8   /* 每个组播组记录的成员个数 */
+
+/* 组播组成员表项 */
+typedef struct {
+    hi_u8  auc_grp_mac[WLAN_MAC_ADDR_LEN];              /* 组播组对应的组播mac地址 */
+    hi_u8  member_num;                                  /* 当前成员个数,0表示表项空闲 */
+    hi_u8  overflow;                                    /* 成员表溢出标志,溢出期间该组回退为组播发送 */
+    hi_u8  auc_user_idx[HMAC_M2U_MEMBER_MAX_NUM];       /* 成员对应的user索引 */
+    hi_u32 aul_timestamp[HMAC_M2U_MEMBER_MAX_NUM];      /* 成员最近一次上报report的时间 ms */
+    hi_u32 overflow_stamp;                              /* 最近一次溢出的时间 ms */
+} hmac_m2u_group_stru;
+
+/* 组播转单播侦听表,发送(转单播查表老化)与接收(侦听)并发访问,由lock保护 */
+typedef struct {
+    oal_spin_lock_stru  lock;
+    hmac_m2u_group_stru ast_group[HMAC_M2U_GROUP_MAX_NUM];
+    hi_u8               snoop_on;                       /* 组播侦听及转单播开关 */
+    hi_u8               max_member;                     /* 成员数不超过该门限时转单播,否则按组播发送 */
+    hi_u8               group_num;                      /* 已记录的组播组个数 */
+    hi_u8               auc_resv[5];                    /* 5 保留字节,保持8字节对齐 */
+} hmac_m2u_stru;
+#endif
+
 typedef enum _hmac_tcp_opt_queue_ {
     HMAC_TCP_ACK_QUEUE = 0,
     HMAC_TCP_OPT_QUEUE_BUTT
@@ -221,6 +246,14 @@ typedef struct hmac_vap_tag {
     hi_u16                          us_edca_opt_time_ms;                  /* edca参数调整计时器周期 ms */
     hi_u8                           edca_opt_flag_ap;                     /* ap模式下是否使能edca优化特性 */
     hi_u8                           edca_opt_flag_sta;                    /* sta模式下是否使能edca优化特性 */
+    /* 上次同步到dmac的业务流统计，未变化时不再抛事件 */
+    hi_u8                           aauc_edca_opt_traffic[WLAN_WME_AC_BUTT][WLAN_TXRX_DATA_BUTT];
+    hi_u8                           edca_opt_traffic_synced;              /* aauc_edca_opt_traffic是否已同步 */
+    hi_u8                           edca_opt_skip_cnt;                    /* 连续未同步的周期数 */
+    hi_u8                           auc_edca_opt_resv[2];                 /* 2 保留字节 */
+#endif
+#ifdef _PRE_WLAN_FEATURE_M2U
+    hmac_m2u_stru                   m2u;                                  /* 组播转单播侦听表 */
 #endif
 
 #ifdef _PRE_WLAN_FEATURE_AMPDU_VAP
@@ -24,6 +24,7 @@
 #include "oal_mem.h"
 #include "mac_frame.h"
 #include "hmac_wapi.h"
+#include "hmac_wapi_sms4.h"
 #include "mac_data.h"
 #include "hmac_tx_data.h"
 
@@ -78,8 +79,8 @@ static inline hi_u8 hmac_wapi_is_qos(const mac_ieee80211_frame_stru *mac_hdr)
 }
 
 /* ****************************************************************************
- 功能描述  : 计算mic数据，作为计算mic之用
- 输出参数  : mic数据缓冲区的长度
+ 功能描述  : 构造mic数据的第一部分(由mac头等字段合成，16字节对齐)，第二部分为pdu，由调用者直接参与运算
+ 输出参数  : puc_mic 合成头存储区，长度不小于SMS4_MIC_PART1_QOS_LEN
  修改历史      :
   1.日    期   : 2015年5月21日
     作    者   : HiSilicon
@@ -87,24 +88,19 @@ static inline hi_u8 hmac_wapi_is_qos(const mac_ieee80211_frame_stru *mac_hdr)
     其    他   :hmac_rx_get_mac_hdr_len已经过滤4地址的情况，此处不再考虑
                 mic数据具体构成见<wapi实施指南>5.2.2.3
 **************************************************************************** */
-hi_u32 hmac_wapi_calc_mic_data(const mac_ieee80211_frame_stru *mac_hdr, hi_u8 keyidx, const hi_u8 *puc_payload,
-    hi_u16 us_pdu_len, const mic_date_stru *mac_date)
+static hi_u32 hmac_wapi_calc_mic_hdr(const mac_ieee80211_frame_stru *mac_hdr, hi_u8 keyidx, hi_u16 us_pdu_len,
+    hi_u8 *puc_mic, hi_u16 us_mic_len)
 {
     hi_u8 us_is_qos;
-    hi_u8 *puc_mic_oringin = HI_NULL;
-    hi_u8 *puc_mic = mac_date->puc_mic;
-    hi_u16 us_mic_len = mac_date->us_mic_len;
 
     if (memset_s(puc_mic, us_mic_len, 0, us_mic_len) != EOK) {
         return HI_FAIL;
     }
 
-    puc_mic_oringin = puc_mic;
-
     /* frame control */
     if (memcpy_s(puc_mic, sizeof(mac_hdr->frame_control), (hi_u8 *)&(mac_hdr->frame_control),
         sizeof(mac_hdr->frame_control)) != EOK) {
-        oam_error_log0(0, OAM_SF_CFG, "hmac_wapi_calc_mic_data:: st_frame_control memcpy_s fail.");
+        oam_error_log0(0, OAM_SF_CFG, "hmac_wapi_calc_mic_hdr:: st_frame_control memcpy_s fail.");
         return HI_FAIL;
     }
     puc_mic[0] &= ~(BIT4 | BIT5 | BIT6); /* sub type */
@@ -150,54 +146,30 @@ hi_u32 hmac_wapi_calc_mic_data(const mac_ieee80211_frame_stru *mac_hdr, hi_u8 ke
     *puc_mic = (hi_u8)((us_pdu_len & 0xff00) >> 8); /* 右移8位 */
     *(puc_mic + 1) = (hi_u8)(us_pdu_len & 0x00ff);
 
-    /* ***********填充第2部分****************** */
-    puc_mic_oringin += (HI_TRUE == hmac_wapi_is_qos(mac_hdr)) ? SMS4_MIC_PART1_QOS_LEN : SMS4_MIC_PART1_NO_QOS_LEN;
-    if (memcpy_s(puc_mic_oringin, us_pdu_len, puc_payload, us_pdu_len) != EOK) {
-        oam_error_log0(0, OAM_SF_CFG, "hmac_wapi_calc_mic_data:: puc_payload memcpy_s fail.");
-        return HI_FAIL;
-    }
-
     return HI_SUCCESS;
 }
 
 /* ****************************************************************************
- 功能描述  : 申请空间，用于存放mic
- 返 回 值  : 申请到的空间指针
- 修改历史      :
-  1.日    期   : 2015年5月21日
-    作    者   : HiSilicon
-    修改内容   : 创建
+ 功能描述  : 计算mic: 合成头与pdu分别按16字节补齐后依次参与CBC-MAC运算，pdu直接取自netbuf，不做暂存拷贝
+ 输入参数  : wpi_key_ck 计算mic所用的IV及轮密钥
+ 输出参数  : puc_mic 计算得到的mic，长度SMS4_MIC_LEN
 **************************************************************************** */
-static inline hi_u8 *hmac_wapi_mic_alloc(hi_u8 is_qos, hi_u16 us_pdu_len, hi_u16 *pus_mic_len)
+static hi_u32 hmac_wapi_calc_mic(hmac_wapi_crypt_stru wpi_key_ck, const mac_ieee80211_frame_stru *mac_hdr,
+    hi_u8 keyidx, const hi_u8 *puc_payload, hi_u16 us_pdu_len, hi_u8 *puc_mic)
 {
-    hi_u16 us_mic_part1_len;
-    hi_u16 us_mic_part2_len;
-    hi_u16 us_mic_len;
-
-    us_mic_part1_len = (HI_TRUE == is_qos) ? SMS4_MIC_PART1_QOS_LEN : SMS4_MIC_PART1_NO_QOS_LEN;
-    /* 按照协议，补齐不足位，16字节对齐 */
-    us_mic_part2_len = padding(us_pdu_len, SMS4_PADDING_LEN);
-    us_mic_len = us_mic_part1_len + us_mic_part2_len;
-    *pus_mic_len = us_mic_len;
-
-    return oal_mem_alloc(OAL_MEM_POOL_ID_LOCAL, us_mic_len);
-}
+    hi_u8 auc_mic_hdr[SMS4_MIC_PART1_QOS_LEN];
+    hmac_wpi_pmac_ctx_stru pmac_ctx;
+    hi_u16 us_mic_part1_len = (hmac_wapi_is_qos(mac_hdr) == HI_TRUE) ?
+        SMS4_MIC_PART1_QOS_LEN : SMS4_MIC_PART1_NO_QOS_LEN;
 
-/* ****************************************************************************
- 功能描述  : 释放申请的mic空间
- 修改历史      :
-  1.日    期   : 2015年5月21日
-    作    者   : HiSilicon
-    修改内容   : 创建
-    其    他
-**************************************************************************** */
-static inline hi_u32 hmac_wapi_mic_free(const hi_u8 *puc_mic)
-{
-    if (puc_mic != HI_NULL) {
-        oal_mem_free(puc_mic);
-        return HI_SUCCESS;
+    if (hmac_wapi_calc_mic_hdr(mac_hdr, keyidx, us_pdu_len, auc_mic_hdr, us_mic_part1_len) != HI_SUCCESS) {
+        return HI_FAIL;
     }
-    return HI_FAIL;
+
+    hmac_wpi_pmac_init(&pmac_ctx, wpi_key_ck);
+    hmac_wpi_pmac_update(&pmac_ctx, auc_mic_hdr, us_mic_part1_len);
+    hmac_wpi_pmac_update(&pmac_ctx, puc_payload, us_pdu_len);
+    return hmac_wpi_pmac_final(&pmac_ctx, puc_mic, SMS4_MIC_LEN);
 }
 
 /* ****************************************************************************
@@ -429,6 +401,9 @@ hi_u32 hmac_wapi_add_key(hmac_wapi_stru *wapi, hi_u8 key_index, const hi_u8 *puc
         oam_error_log0(0, OAM_SF_CFG, "hmac_wapi_add_key:: puc_key memcpy_s fail.");
         return HI_FAIL;
     }
+    /* 轮密钥只在安装密钥时扩展一次，收发每帧直接使用 */
+    hmac_sms4_keyext(key->auc_wpi_ek, WAPI_KEY_LEN, key->aul_ek_rk, WAPI_ROUND_KEY_NUM);
+    hmac_sms4_keyext(key->auc_wpi_ck, WAPI_KEY_LEN, key->aul_ck_rk, WAPI_ROUND_KEY_NUM);
     key->key_en = HI_TRUE;
 
     /* 重置PN */
@@ -483,10 +458,8 @@ hi_u8 hmac_wapi_is_wpihdr_valid(hmac_wapi_stru *wapi, const hi_u8 *puc_wapi_hdr)
 hi_u32 hmac_wapi_decrypt(hmac_wapi_stru *wapi, oal_netbuf_stru *netbuf)
 {
     hi_u8 auc_calc_mic[SMS4_MIC_LEN];
-    hi_u16 us_mic_len;
     hmac_wapi_crypt_stru wpi_key_ek = { 0 };
     hmac_wapi_crypt_stru wpi_key_ck = { 0 };
-    mic_date_stru mac_date;
 
     wapi_rx_port_valid(wapi);
 
@@ -561,8 +534,7 @@ hi_u32 hmac_wapi_decrypt(hmac_wapi_stru *wapi, oal_netbuf_stru *netbuf)
     /******************** 4. 解密************************* */
     wpi_key_ek.puc_iv  = puc_pn;
     wpi_key_ek.iv_len  = SMS4_PN_LEN; /* iv key len 16 */
-    wpi_key_ek.puc_key = wapi->ast_wapi_key[key_index].auc_wpi_ek;
-    wpi_key_ek.key_len = 16; /* ck key len 16 */
+    wpi_key_ek.pul_rk  = wapi->ast_wapi_key[key_index].aul_ek_rk;
     wapi_result = hmac_wpi_decrypt(wpi_key_ek, puc_pn + SMS4_PN_LEN, (us_pdu_len + SMS4_MIC_LEN), /* 需解密的长度 */
                                    (oal_netbuf_data(netbuff_des) + mac_hdr_len));
     if (wapi_result != HI_SUCCESS) {
@@ -576,34 +548,11 @@ hi_u32 hmac_wapi_decrypt(hmac_wapi_stru *wapi, oal_netbuf_stru *netbuf)
     oal_netbuf_put(netbuff_des, us_pdu_len);
 
     /* *********** 5. 计算mic，并进行校验 *********** */
-    hi_u8 *puc_mic_data = hmac_wapi_mic_alloc(hmac_wapi_is_qos(mac_hdr), us_pdu_len, &us_mic_len);
-    if (puc_mic_data == HI_NULL) {
-        wapi_rx_memalloc_err(wapi);
-        oal_netbuf_free(netbuff_des);
-        /* 注意netbuff后续是否有释放处理 */
-        oal_netbuf_free(netbuf);
-        return HI_ERR_CODE_ALLOC_MEM_FAIL;
-    }
-
-    /* 计算mic预备数据 */
-    mac_date.puc_mic = puc_mic_data;
-    mac_date.us_mic_len = us_mic_len;
-    if (hmac_wapi_calc_mic_data(mac_hdr, key_index, oal_netbuf_data(netbuff_des) + mac_hdr_len, us_pdu_len,
-        &mac_date) != HI_SUCCESS) {
-        oam_warning_log0(0, OAM_SF_ANY, "hmac_wapi_calc_mic_data return NON SUCCESS. ");
-    }
-
     wpi_key_ck.puc_iv  = puc_pn;
     wpi_key_ck.iv_len  = 16; /* iv key len 16 */
-    wpi_key_ck.puc_key = wapi->ast_wapi_key[key_index].auc_wpi_ck;
-    wpi_key_ck.key_len = 16; /* ck key len 16 */
-    wapi_result = hmac_wpi_pmac(wpi_key_ck, puc_mic_data, (us_mic_len >> 4), auc_calc_mic, SMS4_MIC_LEN); /* 右移4位 */
-
-    /* 计算完mic后，释放mic data */
-    if (hmac_wapi_mic_free(puc_mic_data) != HI_SUCCESS) {
-        oam_warning_log0(0, OAM_SF_ANY, "hmac_wapi_mic_free return NON SUCCESS. ");
-    }
-
+    wpi_key_ck.pul_rk  = wapi->ast_wapi_key[key_index].aul_ck_rk;
+    wapi_result = hmac_wapi_calc_mic(wpi_key_ck, mac_hdr, key_index, oal_netbuf_data(netbuff_des) + mac_hdr_len,
+        us_pdu_len, auc_calc_mic);
     if (wapi_result != HI_SUCCESS) {
         oal_netbuf_free(netbuff_des);
         oal_netbuf_free(netbuf);
@@ -641,47 +590,21 @@ hi_u32 hmac_wapi_decrypt(hmac_wapi_stru *wapi, oal_netbuf_stru *netbuf)
 static hi_u32 hmac_wapi_encrypt_mic(hmac_wapi_stru *wapi, hmac_wapi_encrypt_stru *hmac_wapi,
     const mac_ieee80211_frame_stru *mac_hdr, const hi_u8 *puc_payload)
 {
-    mic_date_stru mac_date;
-    /* *********** 2. 计算mic,wapi的数据帧一般为QOS帧  *********** */
-    hi_u8 *puc_mic_data = hmac_wapi_mic_alloc(hmac_wapi_is_qos(mac_hdr), hmac_wapi->pdu_len, &hmac_wapi->us_mic_len);
-    if (puc_mic_data == HI_NULL) {
-        wapi_tx_memalloc_err(wapi);
-        oam_error_log0(0, OAM_SF_ANY, "{hmac_wapi_encrypt::hmac_wapi_mic_alloc err!");
-        return HI_ERR_CODE_ALLOC_MEM_FAIL;
-    }
-
-    /* 计算mic预备数据 */
-    mac_date.puc_mic = puc_mic_data;
-    mac_date.us_mic_len = hmac_wapi->us_mic_len;
-    if (hmac_wapi_calc_mic_data(mac_hdr, hmac_wapi->key_index, puc_payload, hmac_wapi->pdu_len, puc_mic_data,
-        hmac_wapi->us_mic_len) != HI_SUCCESS) {
-        oam_warning_log0(0, OAM_SF_CFG, "hmac_wapi_calc_mic_data return NON SUCCESS. ");
-    }
-
     if (memcpy_s(hmac_wapi->auc_pn_swap, SMS4_PN_LEN, wapi->ast_wapi_key[hmac_wapi->key_index].auc_pn_tx,
         SMS4_PN_LEN) != EOK) {
-        if (hmac_wapi_mic_free(puc_mic_data) != HI_SUCCESS) {
-            oam_warning_log0(0, OAM_SF_CFG, "hmac_wapi_mic_free return NON SUCCESS. ");
-        }
-
         oam_error_log0(0, OAM_SF_CFG, "hmac_wapi_encrypt:: auc_pn_tx memcpy_s fail.");
         return HI_FAIL;
     }
     hmac_wpi_swap_pn(hmac_wapi->auc_pn_swap, SMS4_PN_LEN);
-    /* 计算mic */
+    /* 计算mic,wapi的数据帧一般为QOS帧 */
     hmac_wapi->wpi_key_ck.puc_iv = hmac_wapi->auc_pn_swap;
     hmac_wapi->wpi_key_ck.iv_len = SMS4_PN_LEN; /* iv key len 16 */
-    hmac_wapi->wpi_key_ck.puc_key = wapi->ast_wapi_key[hmac_wapi->key_index].auc_wpi_ck;
-    hmac_wapi->wpi_key_ck.key_len = 16; /* ck key len 16 */
-    hi_u32 ret = hmac_wpi_pmac(hmac_wapi->wpi_key_ck, puc_mic_data, (hmac_wapi->us_mic_len >> 4),
-        hmac_wapi->auc_calc_mic, SMS4_MIC_LEN); /* 右移4位 */
-
-    if (hmac_wapi_mic_free(puc_mic_data) != HI_SUCCESS) {
-        oam_warning_log0(0, OAM_SF_CFG, "hmac_wapi_mic_free return NON SUCCESS. ");
-    }
-    if (ret == HI_FAIL) {
+    hmac_wapi->wpi_key_ck.pul_rk = wapi->ast_wapi_key[hmac_wapi->key_index].aul_ck_rk;
+    hi_u32 ret = hmac_wapi_calc_mic(hmac_wapi->wpi_key_ck, mac_hdr, hmac_wapi->key_index, puc_payload,
+        hmac_wapi->pdu_len, hmac_wapi->auc_calc_mic);
+    if (ret != HI_SUCCESS) {
         wapi_tx_mic_err(wapi);
-        oam_error_log0(0, OAM_SF_ANY, "{hmac_wapi_encrypt::hmac_wpi_pmac mic calc err!");
+        oam_error_log0(0, OAM_SF_ANY, "{hmac_wapi_encrypt::hmac_wapi_calc_mic mic calc err!");
         return HI_ERR_CODE_WAPI_MIC_CALC_FAIL;
     }
 
@@ -691,15 +614,11 @@ static hi_u32 hmac_wapi_encrypt_mic(hmac_wapi_stru *wapi, hmac_wapi_encrypt_stru
 static hi_u32 hmac_wapi_encrypt_action(hmac_wapi_stru *wapi, oal_netbuf_stru *netbuf, hmac_wapi_encrypt_stru *hmac_wapi,
     hi_u8 *puc_datain, oal_netbuf_stru *netbuf_des)
 {
-    /* *********************** 4. 加密 *********************** */
+    /* *********************** 4. 加密，明文已放入目的netbuf，原地加密 *********************** */
     hmac_wapi->wpi_key_ek.puc_iv = hmac_wapi->auc_pn_swap;
     hmac_wapi->wpi_key_ek.iv_len = SMS4_PN_LEN;
-    hmac_wapi->wpi_key_ek.puc_key = wapi->ast_wapi_key[hmac_wapi->key_index].auc_wpi_ek;
-    hmac_wapi->wpi_key_ek.key_len = WAPI_KEY_LEN;
-    hi_u32 ret = hmac_wpi_encrypt(hmac_wapi->wpi_key_ek, puc_datain, hmac_wapi->pdu_len + SMS4_MIC_LEN,
-        oal_netbuf_data(netbuf_des) + HMAC_WAPI_HDR_LEN + MAC_80211_QOS_HTC_4ADDR_FRAME_LEN);
-
-    oal_free(puc_datain);
+    hmac_wapi->wpi_key_ek.pul_rk = wapi->ast_wapi_key[hmac_wapi->key_index].aul_ek_rk;
+    hi_u32 ret = hmac_wpi_encrypt(hmac_wapi->wpi_key_ek, puc_datain, hmac_wapi->pdu_len + SMS4_MIC_LEN, puc_datain);
     if (ret != HI_SUCCESS) {
         oal_netbuf_free(netbuf_des);
         oam_error_log1(0, OAM_SF_ANY, "{hmac_wapi_encrypt::hmac_wpi_encrypt err==%u!", ret);
@@ -798,16 +717,10 @@ hi_u32 hmac_wapi_encrypt(hmac_wapi_stru *wapi, oal_netbuf_stru *netbuf)
         return HI_FAIL;
     }
 
-    hi_u8 *puc_datain = (hi_u8 *)oal_memalloc(hmac_wapi.pdu_len + SMS4_MIC_LEN);
-    if (puc_datain == HI_NULL) {
-        oal_netbuf_free(netbuf_des);
-        oam_error_log0(0, OAM_SF_ANY, "{hmac_wapi_encrypt::puc_datain alloc err!");
-        wapi_tx_memalloc_err(wapi);
-        return HI_ERR_CODE_ALLOC_MEM_FAIL;
-    }
+    /* 明文pdu及mic直接放到目的netbuf的密文位置，随后原地加密 */
+    hi_u8 *puc_datain = oal_netbuf_data(netbuf_des) + HMAC_WAPI_HDR_LEN + MAC_80211_QOS_HTC_4ADDR_FRAME_LEN;
     if ((memcpy_s(puc_datain, hmac_wapi.pdu_len, puc_payload, hmac_wapi.pdu_len) != EOK) ||
         (memcpy_s(puc_datain + hmac_wapi.pdu_len, SMS4_MIC_LEN, hmac_wapi.auc_calc_mic, SMS4_MIC_LEN) != EOK)) {
-        oal_free(puc_datain);
         oal_netbuf_free(netbuf_des);
         oam_error_log0(0, OAM_SF_CFG, "hmac_wapi_encrypt:: puc_payload memcpy_s fail.");
         return HI_FAIL;
@@ -118,8 +118,8 @@ typedef struct {
 } wapi_mic_hdr_stru;
 
 typedef struct {
-    hi_u16 us_mic_len;
     hi_u16 pdu_len;
+    hi_u8  auc_resv[2]; /* 2 字节补齐 */
     hi_u8  auc_calc_mic[SMS4_MIC_LEN];
     hi_u8  auc_pn_swap[SMS4_PN_LEN];      /* 保存变换后的pn,用来计算mic和加密 */
     hmac_wapi_crypt_stru wpi_key_ck;
@@ -128,12 +128,6 @@ typedef struct {
     hi_u8 mac_hdr_len;
 } hmac_wapi_encrypt_stru;
 
-typedef struct {
-    hi_u8 *puc_mic;
-    hi_u16 us_mic_len;
-    hi_u8 rsv[2]; /* 2 字节补齐 */
-} mic_date_stru;
-
 /* ****************************************************************************
   4 函数声明
 **************************************************************************** */
@@ -36,8 +36,12 @@ extern "C" {
                         (_s)[((hi_u32)(_a)) >>  8 & 0xFF] <<  8 ^ \
                         (_s)[((hi_u32)(_a)) & 0xFF])
 
-#define l1(_b) ((_b) ^ rotl32(_b, 2) ^ rotl32(_b, 10) ^ rotl32(_b, 18) ^ rotl32(_b, 24))
 #define l2(_b) ((_b) ^ rotl32(_b, 13) ^ rotl32(_b, 23))
+/* 查表完成S盒与线性变换L(_b ^ rotl32(_b, 2) ^ rotl32(_b, 10) ^ rotl32(_b, 18) ^ rotl32(_b, 24))，_t为合并表 */
+#define sms4_t(_t, _a) ((_t)[((hi_u32)(_a)) >> 24 & 0xFF] ^ \
+                        rotr32((_t)[((hi_u32)(_a)) >> 16 & 0xFF], 8) ^ \
+                        rotr32((_t)[((hi_u32)(_a)) >>  8 & 0xFF], 16) ^ \
+                        rotr32((_t)[((hi_u32)(_a)) & 0xFF], 24))
 
 /* ****************************************************************************
   2 函数声明
@@ -39,7 +39,7 @@ extern "C" {
  输入参数  : hi_u8 *puc_iv    为IV存储区起始地址
              hi_u8 *puc_bufin    为明文存储区起始地址
              hi_u32 ul_buflen    为明文（以Byte为单位）长度
-             hi_u8 *puc_key      为会话密钥存储区起始地址
+             pul_rk              为会话密钥扩展后的轮密钥
              hi_u8* puc_bufout   为密文存储区起始地址，
                                 密文存储区空间与明文存储区空间大小相同
  修改历史      :
@@ -61,11 +61,9 @@ hi_u32 hmac_wpi_encrypt(hmac_wapi_crypt_stru wpi_key, hi_u8 *puc_bufin, hi_u32 b
     hi_u32 counter;
     hi_u32 comp;
     hi_u32 loop;
-    hi_u32 aul_pr_keyin[WPI_PR_KEYIN_LEN] = { 0 };
+    const hi_u32 *aul_pr_keyin = wpi_key.pul_rk;
     hi_u8 *puc_iv = wpi_key.puc_iv;
     hi_u8 iv_len = wpi_key.iv_len;
-    hi_u8 *puc_key = wpi_key.puc_key;
-    hi_u8 key_len = wpi_key.key_len;
 
     if (buflen < 1) {
 #ifdef WAPI_DEBUG_MODE
@@ -74,8 +72,6 @@ hi_u32 hmac_wpi_encrypt(hmac_wapi_crypt_stru wpi_key, hi_u8 *puc_bufin, hi_u32 b
         return HI_FAIL;
     }
 
-    hmac_sms4_keyext(puc_key, key_len, aul_pr_keyin, WPI_PR_KEYIN_LEN);
-
     counter = buflen / 16; /* 16 用于计算 */
     comp = buflen % 16;    /* 16 用于计算 */
 
@@ -128,53 +124,67 @@ hi_u32 hmac_wpi_decrypt(hmac_wapi_crypt_stru wpi_key, hi_u8 *puc_bufin, hi_u32 b
 }
 
 /* ****************************************************************************
- 功能描述  : 计算mic
- 输入参数  : hi_u8* puc_iv    为IV存储区起始地址
-             hi_u8* pucBuf      为text存储区起始地址
-             hi_u32 ulPamclen   为text长度（以Byte为单位，且应为16Byte的整数倍）除以16的倍数
-             hi_u8* pucKey      为用于计算MIC的密钥KEY存储区起始地址
-             hi_u8* pucMic      为MIC存储区起始地址
- 修改历史      :
-  1.日    期   : 2012年5月2日
-    作    者   : HiSilicon
-    修改内容   : 新生成函数
+ 功能描述  : 一个16字节分组参与CBC-MAC运算，分组地址不要求4字节对齐
 **************************************************************************** */
-hi_u32 hmac_wpi_pmac(hmac_wapi_crypt_stru wpi_key, hi_u8 *puc_buf, hi_u32 pamclen, hi_u8 *puc_mic, hi_u8 mic_len)
+static hi_void hmac_wpi_pmac_block(hmac_wpi_pmac_ctx_stru *pmac_ctx, const hi_u8 *puc_block)
 {
-    hi_u32 aul_mic_tmp[4] = { 0 };  /* 元素个数为4 */
-    hi_u32 loop;
-    hi_u32 *pul_in = HI_NULL;
-    hi_u32 aul_pr_mac_keyin[WPI_PR_KEYIN_LEN] = { 0 };
-    hi_u8 *puc_iv = wpi_key.puc_iv;
-    hi_u8  iv_len = wpi_key.iv_len;
-    hi_u8 *puc_key = wpi_key.puc_key;
-    hi_u8  key_len = wpi_key.key_len;
-
-    if (mic_len < SMS4_MIC_LEN) {
-        return HI_FAIL;
+    hi_u32 aul_block[4]; /* 元素个数为4 */
+    const hi_u32 *pul_in = (const hi_u32 *)puc_block;
+
+    if (((uintptr_t)puc_block & (sizeof(hi_u32) - 1)) != 0) {
+        if (memcpy_s(aul_block, sizeof(aul_block), puc_block, SMS4_MIC_LEN) != EOK) {
+            return;
+        }
+        pul_in = aul_block;
     }
-    if ((pamclen < 1) || (pamclen > 4096)) { /* 4096 边界 */
-        return HI_FAIL;
+
+    pmac_ctx->aul_mic[0] ^= pul_in[0];
+    pmac_ctx->aul_mic[1] ^= pul_in[1];
+    pmac_ctx->aul_mic[2] ^= pul_in[2]; /* 2 元素索引 */
+    pmac_ctx->aul_mic[3] ^= pul_in[3]; /* 3 元素索引 */
+    hmac_sms4_crypt((hi_u8 *)pmac_ctx->aul_mic, 4, (hi_u8 *)pmac_ctx->aul_mic, pmac_ctx->pul_rk, /* len 4 */
+        WPI_PR_KEYIN_LEN);
+}
+
+/* ****************************************************************************
+ 功能描述  : 增量计算mic: 初始化，以IV加密结果作为CBC-MAC初值
+ 输入参数  : wpi_key  puc_iv为IV存储区起始地址，pul_rk为用于计算MIC的密钥扩展后的轮密钥
+**************************************************************************** */
+hi_void hmac_wpi_pmac_init(hmac_wpi_pmac_ctx_stru *pmac_ctx, hmac_wapi_crypt_stru wpi_key)
+{
+    pmac_ctx->pul_rk = wpi_key.pul_rk;
+    hmac_sms4_crypt(wpi_key.puc_iv, wpi_key.iv_len, (hi_u8 *)pmac_ctx->aul_mic, wpi_key.pul_rk, WPI_PR_KEYIN_LEN);
+}
+
+/* ****************************************************************************
+ 功能描述  : 增量计算mic: 处理一段数据，完整分组直接在原缓冲区上运算，
+             末尾不足16字节的部分在栈上补零成一个分组(mic数据各部分均按16字节补齐)
+**************************************************************************** */
+hi_void hmac_wpi_pmac_update(hmac_wpi_pmac_ctx_stru *pmac_ctx, const hi_u8 *puc_buf, hi_u32 buflen)
+{
+    hi_u8 auc_tail[SMS4_MIC_LEN] = { 0 };
+
+    for (; buflen >= SMS4_MIC_LEN; buflen -= SMS4_MIC_LEN) {
+        hmac_wpi_pmac_block(pmac_ctx, puc_buf);
+        puc_buf += SMS4_MIC_LEN;
     }
 
-    hmac_sms4_keyext(puc_key, key_len, aul_pr_mac_keyin, WPI_PR_KEYIN_LEN);
-    pul_in = (hi_u32 *)puc_buf;
-    hmac_sms4_crypt(puc_iv, iv_len, (hi_u8 *)aul_mic_tmp, aul_pr_mac_keyin, WPI_PR_KEYIN_LEN);
-
-    for (loop = 0; loop < pamclen; loop++) {
-        aul_mic_tmp[0] ^= pul_in[0];
-        aul_mic_tmp[1] ^= pul_in[1];
-        aul_mic_tmp[2] ^= pul_in[2]; /* 2 元素索引 */
-        aul_mic_tmp[3] ^= pul_in[3]; /* 3 元素索引 */
-        pul_in += 4;                 /* 自增4 */
-        hmac_sms4_crypt((hi_u8 *)aul_mic_tmp, 4, (hi_u8 *)aul_mic_tmp, aul_pr_mac_keyin, WPI_PR_KEYIN_LEN); /* len 4 */
+    if (buflen != 0) {
+        if (memcpy_s(auc_tail, sizeof(auc_tail), puc_buf, buflen) != EOK) {
+            return;
+        }
+        hmac_wpi_pmac_block(pmac_ctx, auc_tail);
     }
+}
 
-    pul_in = (hi_u32 *)puc_mic;
-    pul_in[0] = aul_mic_tmp[0];
-    pul_in[1] = aul_mic_tmp[1];
-    pul_in[2] = aul_mic_tmp[2]; /* 2 元素索引 */
-    pul_in[3] = aul_mic_tmp[3]; /* 3 元素索引 */
+/* ****************************************************************************
+ 功能描述  : 增量计算mic: 输出mic
+**************************************************************************** */
+hi_u32 hmac_wpi_pmac_final(const hmac_wpi_pmac_ctx_stru *pmac_ctx, hi_u8 *puc_mic, hi_u8 mic_len)
+{
+    if (memcpy_s(puc_mic, mic_len, pmac_ctx->aul_mic, SMS4_MIC_LEN) != EOK) {
+        return HI_FAIL;
+    }
 
     return HI_SUCCESS;
 }
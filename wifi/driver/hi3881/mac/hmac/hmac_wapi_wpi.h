@@ -31,19 +31,26 @@ extern "C" {
 #define WPI_PR_KEYIN_LEN 32
 
 typedef struct {
-    hi_u8 *puc_key;
+    const hi_u32 *pul_rk; /* 安装密钥时已扩展的轮密钥，WPI_PR_KEYIN_LEN个 */
     hi_u8 *puc_iv;
-    hi_u8  key_len;
     hi_u8  iv_len;
-    hi_u8  resv[2]; /* resv 2byte */
+    hi_u8  resv[3]; /* resv 3byte */
 } hmac_wapi_crypt_stru;
 
+/* 增量计算mic的上下文: 数据按16字节分组直接从原始缓冲区参与CBC-MAC运算 */
+typedef struct {
+    const hi_u32 *pul_rk;
+    hi_u32 aul_mic[4]; /* 4 当前CBC-MAC中间值 */
+} hmac_wpi_pmac_ctx_stru;
+
 /* ****************************************************************************
   2 函数声明
 **************************************************************************** */
 hi_u32 hmac_wpi_encrypt(hmac_wapi_crypt_stru wpi_key, hi_u8 *puc_bufin, hi_u32 buflen, hi_u8 *puc_bufout);
 hi_u32 hmac_wpi_decrypt(hmac_wapi_crypt_stru wpi_key, hi_u8 *puc_bufin, hi_u32 buflen, hi_u8 *puc_bufout);
-hi_u32 hmac_wpi_pmac(hmac_wapi_crypt_stru wpi_key, hi_u8 *puc_buf, hi_u32 pamclen, hi_u8 *puc_mic, hi_u8 mic_len);
+hi_void hmac_wpi_pmac_init(hmac_wpi_pmac_ctx_stru *pmac_ctx, hmac_wapi_crypt_stru wpi_key);
+hi_void hmac_wpi_pmac_update(hmac_wpi_pmac_ctx_stru *pmac_ctx, const hi_u8 *puc_buf, hi_u32 buflen);
+hi_u32 hmac_wpi_pmac_final(const hmac_wpi_pmac_ctx_stru *pmac_ctx, hi_u8 *puc_mic, hi_u8 mic_len);
 
 #ifdef __cplusplus
 #if __cplusplus
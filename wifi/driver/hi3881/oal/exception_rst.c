@@ -27,6 +27,7 @@
 #include "exception_rst.h"
 #include "plat_firmware.h"
 #include "oal_file.h"
+#include "oal_time.h"
 #include "oal_sdio_host_if.h"
 #include "hcc_host.h"
 #include "oam_ext_if.h"
@@ -47,6 +48,9 @@ void oal_wakeup_exception(void)
         printk("[E]%s, g_pst_exception_info is null\n", __FUNCTION__);
         return;
     }
+    if (g_pst_exception_info->exception_reset_enable != PLAT_EXCEPTION_ENABLE) {
+        return;
+    }
 
     oal_spin_lock_irq_save(&(g_pst_exception_info->excp_lock), &flags);
     if (work_busy(&(g_pst_exception_info->excp_worker))) {
@@ -68,6 +72,11 @@ void oal_exception_submit(hi_s32 excep_type)
         return;
     }
 
+    /* 未开启异常复位时保持原有行为, 不改变pm状态也不调度恢复 */
+    if (g_pst_exception_info->exception_reset_enable != PLAT_EXCEPTION_ENABLE) {
+        return;
+    }
+
     if (wlan_pm_is_shutdown()) {
         return;
     }
@@ -189,3 +198,265 @@ hi_void oal_frw_exception_report(hi_void)
         printk("FRW_ENQUEUE_FAIL event notification failed\n");
     }
 }
+
+/* ****************************************************************************
+ 功能描述  : 获取异常恢复统计
+ 输出参数  : stats: 恢复次数、各级成功率及耗时统计
+**************************************************************************** */
+hi_u32 plat_exception_recovery_stats_get(plat_excp_recovery_stats_stru *stats)
+{
+    unsigned long flags;
+
+    if ((g_pst_exception_info == HI_NULL) || (stats == HI_NULL)) {
+        return HI_ERR_CODE_PTR_NULL;
+    }
+
+    oal_spin_lock_irq_save(&(g_pst_exception_info->excp_lock), &flags);
+    *stats = g_pst_exception_info->recovery_stats;
+    oal_spin_unlock_irq_restore(&(g_pst_exception_info->excp_lock), &flags);
+    return HI_SUCCESS;
+}
+
+/* ****************************************************************************
+ 功能描述  : 打印异常恢复统计: 开关状态、各级恢复次数及成功次数、恢复耗时
+**************************************************************************** */
+hi_void plat_exception_recovery_stats_dump(hi_void)
+{
+    plat_excp_recovery_stats_stru stats;
+    hi_u32 recovery_cnt;
+
+    if (plat_exception_recovery_stats_get(&stats) != HI_SUCCESS) {
+        printk("dfr: exception info not initialized\n");
+        return;
+    }
+
+    recovery_cnt = stats.succ_cnt[PLAT_EXCP_STAGE_CHAN_RESET] + stats.succ_cnt[PLAT_EXCP_STAGE_FW_RELOAD] +
+        stats.fail_cnt;
+    printk("dfr: enable[%u] exception_cnt[%u]\n", g_pst_exception_info->exception_reset_enable,
+        g_pst_exception_info->wifi_exception_cnt);
+    printk("dfr: chan_reset attempt[%u] succ[%u], fw_reload attempt[%u] succ[%u], fail[%u]\n",
+        stats.attempt_cnt[PLAT_EXCP_STAGE_CHAN_RESET], stats.succ_cnt[PLAT_EXCP_STAGE_CHAN_RESET],
+        stats.attempt_cnt[PLAT_EXCP_STAGE_FW_RELOAD], stats.succ_cnt[PLAT_EXCP_STAGE_FW_RELOAD], stats.fail_cnt);
+    printk("dfr: cost last[%u]ms max[%u]ms avg[%u]ms over_budget[%u], last type[%u] stage[%u]\n",
+        stats.last_cost_ms, stats.max_cost_ms, (recovery_cnt != 0) ? (stats.total_cost_ms / recovery_cnt) : 0,
+        stats.over_budget_cnt, stats.last_type, stats.last_stage);
+}
+
+hi_s32 get_exception_info_reference(struct st_exception_info **exception_data)
+{
+    if (exception_data == HI_NULL) {
+        return -EXCEPTION_FAIL;
+    }
+    *exception_data = g_pst_exception_info;
+    return (g_pst_exception_info == HI_NULL) ? -EXCEPTION_FAIL : EXCEPTION_SUCCESS;
+}
+
+void plat_dfr_cfg_set(unsigned long arg)
+{
+    if (g_pst_exception_info == HI_NULL) {
+        return;
+    }
+    g_pst_exception_info->exception_reset_enable = (arg != 0) ? PLAT_EXCEPTION_ENABLE : PLAT_EXCEPTION_DISABLE;
+    oam_warning_log1(0, 0, "plat_dfr_cfg_set:: exception reset enable[%d]", (hi_u32)arg);
+}
+
+/* ****************************************************************************
+ 功能描述  : 第一级恢复: 重新使能SDIO function1并重放hcc队列, device固件及其上的vap/user/密钥状态保持不变,
+             host无需重新下发
+ 输入参数  : start_ms: 本次恢复开始时间, 用于约束快速复位预算
+ 返 回 值  : HI_SUCCESS: 通道已恢复
+**************************************************************************** */
+static hi_s32 plat_exception_chan_reset(hi_u32 start_ms)
+{
+    struct BusDev *bus = oal_get_bus_default_handler();
+    hcc_handler_stru *hcc = hcc_host_get_handler();
+    struct wlan_pm_info *wlan_pm = wlan_pm_get_drv();
+    hi_s32 ret;
+    hi_u32 retry;
+
+    if ((bus == HI_NULL) || (hcc == HI_NULL) || (wlan_pm == HI_NULL)) {
+        return HI_FAIL;
+    }
+
+    /* 复位期间暂停hcc: 持发送锁挡住TX线程, 关闭通道状态使中断处理不再收包 */
+    hcc_tx_transfer_lock(hcc);
+    oal_disable_sdio_state(bus, OAL_SDIO_ALL);
+    /* 清除残留中断并重新使能function1中断源, 失败时总线已被关闭, 只能升级为固件重加载 */
+    ret = oal_sdio_dev_init(bus);
+    if (ret != HI_SUCCESS) {
+        hcc_tx_transfer_unlock(hcc);
+        oam_warning_log1(0, 0, "plat_exception_chan_reset:: sdio func1 re-enable fail[%d]", ret);
+        return HI_FAIL;
+    }
+    /* device能够应答唤醒说明固件仍在运行 */
+    ret = HI_FAIL;
+    for (retry = 0; retry < PLAT_EXCP_CHAN_RESET_RETRY; retry++) {
+        if (oal_sdio_wakeup_dev(bus) >= 0) {
+            ret = HI_SUCCESS;
+            break;
+        }
+        if ((hi_u32)hi_get_milli_seconds() - start_ms > PLAT_EXCP_CHAN_RESET_BUDGET_MS) {
+            break;
+        }
+    }
+    if (ret != HI_SUCCESS) {
+        hcc_tx_transfer_unlock(hcc);
+        oam_warning_log0(0, 0, "plat_exception_chan_reset:: device no response");
+        return HI_FAIL;
+    }
+    wlan_pm_state_set(wlan_pm, HOST_DISALLOW_TO_SLEEP);
+    hcc_tx_transfer_unlock(hcc);
+
+    /* 队列中的报文未被丢弃, 唤醒收发线程将其重新发往device */
+    hcc_sched_transfer(hcc);
+    hcc_rx_sched_transfer(hcc);
+    hcc_tx_network_startall_queues(hcc);
+    return HI_SUCCESS;
+}
+
+/* ****************************************************************************
+ 功能描述  : 第二级恢复: 丢弃hcc队列, 复位device并重新下载固件
+ 返 回 值  : EXCEPTION_SUCCESS: 固件已重新加载
+**************************************************************************** */
+hi_s32 wifi_system_reset(hi_void)
+{
+    hcc_handler_stru *hcc = hcc_host_get_handler();
+    struct wlan_pm_info *wlan_pm = wlan_pm_get_drv();
+
+    if ((hcc == HI_NULL) || (wlan_pm == HI_NULL)) {
+        return -EXCEPTION_FAIL;
+    }
+
+    /* 固件重新加载后device侧上下文全部丢失, 队列中的报文已无意义 */
+    hcc_clear_all_queues(hcc, HI_TRUE);
+    if (oal_sdio_func_reset() != HI_SUCCESS) {
+        oam_error_log0(0, 0, "wifi_system_reset:: sdio func reset fail");
+        return -EXCEPTION_FAIL;
+    }
+    if (wlan_power_on() != WIFI_POWER_SUCCESS) {
+        oam_error_log0(0, 0, "wifi_system_reset:: wlan power on fail");
+        return -EXCEPTION_FAIL;
+    }
+    wlan_pm_state_set(wlan_pm, HOST_DISALLOW_TO_SLEEP);
+    oal_clear_dev_panic();
+    return EXCEPTION_SUCCESS;
+}
+
+static hi_void plat_exception_recovery_stats_update(hi_u32 exception_type, plat_excp_stage_enum_uint8 stage,
+    hi_s32 ret, hi_u32 cost_ms)
+{
+    plat_excp_recovery_stats_stru *stats = &(g_pst_exception_info->recovery_stats);
+    unsigned long flags;
+
+    oal_spin_lock_irq_save(&(g_pst_exception_info->excp_lock), &flags);
+    stats->last_type = (hi_u8)exception_type;
+    stats->last_stage = stage;
+    stats->last_cost_ms = cost_ms;
+    stats->total_cost_ms += cost_ms;
+    if (cost_ms > stats->max_cost_ms) {
+        stats->max_cost_ms = cost_ms;
+    }
+    if (cost_ms > PLAT_EXCP_RECOVERY_BUDGET_MS) {
+        stats->over_budget_cnt++;
+    }
+    if (ret == EXCEPTION_SUCCESS) {
+        stats->succ_cnt[stage]++;
+    } else {
+        stats->fail_cnt++;
+    }
+    oal_spin_unlock_irq_restore(&(g_pst_exception_info->excp_lock), &flags);
+}
+
+/* ****************************************************************************
+ 功能描述  : 异常分级恢复入口: device未挂死时在预算内尝试通道快速复位, 失败或超时再重新加载固件
+ 输入参数  : exception_type: 异常类型
+ 返 回 值  : EXCEPTION_SUCCESS: 恢复成功
+**************************************************************************** */
+hi_s32 plat_exception_handler(hi_u32 exception_type)
+{
+    plat_excp_recovery_stats_stru *stats = HI_NULL;
+    plat_excp_stage_enum_uint8 stage = PLAT_EXCP_STAGE_CHAN_RESET;
+    hi_s32 ret = -EXCEPTION_FAIL;
+    hi_u32 start_ms, cost_ms;
+
+    if (g_pst_exception_info == HI_NULL) {
+        return -EXCEPTION_FAIL;
+    }
+    stats = &(g_pst_exception_info->recovery_stats);
+    g_pst_exception_info->wifi_exception_cnt++;
+    if (g_pst_exception_info->exception_reset_enable != PLAT_EXCEPTION_ENABLE) {
+        oam_warning_log1(0, 0, "plat_exception_handler:: type[%d] reset disabled", exception_type);
+        return -EXCEPTION_FAIL;
+    }
+
+    start_ms = (hi_u32)hi_get_milli_seconds();
+    /* device挂死时固件已不可用, 直接重新加载 */
+    if (exception_type != DEVICE_PANIC) {
+        stats->attempt_cnt[PLAT_EXCP_STAGE_CHAN_RESET]++;
+        if (plat_exception_chan_reset(start_ms) == HI_SUCCESS) {
+            ret = EXCEPTION_SUCCESS;
+        }
+    }
+
+    if (ret != EXCEPTION_SUCCESS) {
+        stage = PLAT_EXCP_STAGE_FW_RELOAD;
+        stats->attempt_cnt[PLAT_EXCP_STAGE_FW_RELOAD]++;
+        ret = wifi_system_reset();
+        if (ret == EXCEPTION_SUCCESS) {
+            /* 固件重加载后vap需由上层重建 */
+            oal_frw_exception_report();
+        }
+    }
+
+    cost_ms = (hi_u32)hi_get_milli_seconds() - start_ms;
+    plat_exception_recovery_stats_update(exception_type, stage, ret, cost_ms);
+    oam_warning_log4(0, 0, "plat_exception_handler:: type[%d] stage[%d] ret[%d] cost[%u]ms",
+        exception_type, stage, ret, cost_ms);
+    oam_warning_log3(0, 0, "plat_exception_handler:: chan reset succ[%u] fw reload succ[%u] fail[%u]",
+        stats->succ_cnt[PLAT_EXCP_STAGE_CHAN_RESET], stats->succ_cnt[PLAT_EXCP_STAGE_FW_RELOAD], stats->fail_cnt);
+    return ret;
+}
+
+static hi_void plat_exception_reset_work(oal_work_stru *work)
+{
+    hi_unref_param(work);
+    (hi_void)plat_exception_handler(g_pst_exception_info->excetion_type);
+}
+
+hi_s32 plat_exception_reset_init(hi_void)
+{
+    struct st_exception_info *exception_info = HI_NULL;
+
+    if (g_pst_exception_info != HI_NULL) {
+        return EXCEPTION_SUCCESS;
+    }
+
+    exception_info = (struct st_exception_info *)oal_kzalloc(sizeof(struct st_exception_info), OAL_GFP_KERNEL);
+    if (exception_info == HI_NULL) {
+        oam_error_log0(0, 0, "plat_exception_reset_init:: no mem");
+        return -EXCEPTION_FAIL;
+    }
+    memset_s(exception_info, sizeof(struct st_exception_info), 0, sizeof(struct st_exception_info));
+    /* 默认关闭, 由上层通过plat_dfr_cfg_set或hipriv命令dfr_enable开启, 避免与上层自身的DEV_PANIC处理重复复位 */
+    exception_info->exception_reset_enable = PLAT_EXCEPTION_DISABLE;
+    exception_info->dump_mem_flag = NOT_DUMP_MEM;
+    oal_spin_lock_init(&(exception_info->excp_lock));
+    OAL_INIT_WORK(&(exception_info->excp_worker), plat_exception_reset_work);
+
+    g_pst_exception_info = exception_info;
+    return EXCEPTION_SUCCESS;
+}
+
+hi_s32 plat_exception_reset_exit(hi_void)
+{
+    struct st_exception_info *exception_info = g_pst_exception_info;
+
+    if (exception_info == HI_NULL) {
+        return EXCEPTION_SUCCESS;
+    }
+
+    oal_cancel_work_sync(&(exception_info->excp_worker));
+    g_pst_exception_info = HI_NULL;
+    oal_free(exception_info);
+    return EXCEPTION_SUCCESS;
+}
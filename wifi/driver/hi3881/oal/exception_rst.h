@@ -44,6 +44,10 @@
 #define PLAT_EXCEPTION_ENABLE                  1
 #define PLAT_EXCEPTION_DISABLE                 0
 
+#define PLAT_EXCP_CHAN_RESET_BUDGET_MS         300  /* 通道快速复位的时间预算,超出后升级为固件重加载 */
+#define PLAT_EXCP_CHAN_RESET_RETRY             2    /* 通道快速复位后在预算内探测device应答的最大次数 */
+#define PLAT_EXCP_RECOVERY_BUDGET_MS           3000 /* 单次异常恢复的总时间预算,超出计入超时统计 */
+
 /* ****************************************************************************
   3 STRUCT DEFINE
 **************************************************************************** */
@@ -62,6 +66,27 @@ typedef struct wifi_dump_mem_info_stru {
 
 #define NOT_DUMP_MEM 0
 
+/* 异常恢复分级: 先尝试通道快速复位, 失败后升级为固件重加载 */
+typedef enum {
+    PLAT_EXCP_STAGE_CHAN_RESET = 0, /* SDIO function重新使能 + hcc队列重放 */
+    PLAT_EXCP_STAGE_FW_RELOAD  = 1, /* 复位device并重新下载固件 */
+    PLAT_EXCP_STAGE_BUTT,
+} plat_excp_stage_enum;
+typedef hi_u8 plat_excp_stage_enum_uint8;
+
+typedef struct {
+    hi_u32 attempt_cnt[PLAT_EXCP_STAGE_BUTT]; /* 各级恢复尝试次数 */
+    hi_u32 succ_cnt[PLAT_EXCP_STAGE_BUTT];    /* 各级恢复成功次数 */
+    hi_u32 fail_cnt;                          /* 各级恢复均失败的次数 */
+    hi_u32 over_budget_cnt;                   /* 恢复耗时超出总预算的次数 */
+    hi_u32 last_cost_ms;                      /* 最近一次恢复耗时 */
+    hi_u32 max_cost_ms;                       /* 恢复耗时峰值 */
+    hi_u32 total_cost_ms;                     /* 恢复耗时累计, 与恢复次数相除得到平均恢复时间 */
+    hi_u8  last_type;                         /* 最近一次异常类型 */
+    plat_excp_stage_enum_uint8 last_stage;    /* 最近一次恢复最终所处级别 */
+    hi_u8  auc_resv[2];                       /* 2 BYTE 保留字段 */
+} plat_excp_recovery_stats_stru;
+
 struct st_exception_info {
     hi_u32 exception_reset_enable;
     hi_u32 excetion_type;
@@ -75,6 +100,8 @@ struct st_exception_info {
     oal_spin_lock_stru  excp_lock;
 
     void (*wifi_dfr_func)(void);
+
+    plat_excp_recovery_stats_stru recovery_stats;
 };
 
 /* ****************************************************************************
@@ -116,4 +143,6 @@ hi_void oal_set_dev_panic(hi_void);
 hi_void oal_clear_dev_panic(hi_void);
 hi_u8 oal_dev_is_panic(hi_void);
 hi_void oal_frw_exception_report(hi_void);
+hi_u32 plat_exception_recovery_stats_get(plat_excp_recovery_stats_stru *stats);
+hi_void plat_exception_recovery_stats_dump(hi_void);
 #endif
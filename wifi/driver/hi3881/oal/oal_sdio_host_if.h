@@ -214,6 +214,7 @@ hi_s32 oal_sdio_func_init(struct BusDev *bus);
 hi_s32 oal_sdio_func_probe_resume(struct BusDev *bus);
 #endif
 hi_s32 oal_sdio_func_reset(void);
+hi_s32 oal_sdio_dev_init(struct BusDev *bus);
 hi_void oal_sdio_func_remove(struct BusDev *bus);
 hi_s32 oal_sdio_message_register(struct BusDev *bus, hi_u8 msg, sdio_msg_rx cb, hi_void *data);
 hi_void oal_sdio_message_unregister(struct BusDev *bus, hi_u8 msg);
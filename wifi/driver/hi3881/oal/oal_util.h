@@ -206,8 +206,11 @@ typedef enum {
     OAM_LOG_LEVEL_BUTT
 } oam_log_level_enum;
 
+/* 变参日志的参数个数与类型不定，以OAM_LOG_PARAM_CNT_VAR标识，始终同步格式化输出 */
+#define OAM_LOG_PARAM_CNT_VAR   0xFF
 #define oam_logn(vid, eid, level, fmt, args...) \
-    oal_print_nlogs(__FILE__, __FUNCTION__, (hi_u16)__LINE__, OAL_RET_ADDR, vid, eid, level, 0, fmt, ##args)
+    oal_print_nlogs(__FILE__, __FUNCTION__, (hi_u16)__LINE__, OAL_RET_ADDR, vid, eid, level, \
+        OAM_LOG_PARAM_CNT_VAR, fmt, ##args)
 
 #define oam_log(vid, eid, level, fmt, cnt, p1, p2, p3, p4) \
     oal_print_nlogs(__FILE__, __FUNCTION__, (hi_u16)__LINE__, OAL_RET_ADDR, vid, eid, level, cnt, fmt, p1, p2, p3, p4)
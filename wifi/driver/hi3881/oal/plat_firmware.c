@@ -239,6 +239,14 @@ static firmware_mem_stru *firmware_mem_request(void)
         oam_info_log0(0, 0, "puc_data_buf KMALLOC failed\n");
         goto nomem;
     }
+#ifndef _PRE_HI113X_FS_DISABLE
+    /* 双缓冲预读使用的第二块buffer，申请失败时退回单buffer顺序读发 */
+    firmware_mem->puc_data_buf_next = (hi_u8 *)OS_KMALLOC_GFP(firmware_mem->ul_data_buf_len);
+    if (firmware_mem->puc_data_buf_next == HI_NULL) {
+        oam_warning_log1(0, 0, "puc_data_buf_next len [%d] KMALLOC failed, no prefetch\n",
+            firmware_mem->ul_data_buf_len);
+    }
+#endif
 
     firmware_mem->puc_recv_cmd_buff = (hi_u8 *)OS_KMALLOC_GFP(CMD_BUFF_LEN);
     if (firmware_mem->puc_recv_cmd_buff == HI_NULL) {
@@ -274,6 +282,9 @@ static void firmware_mem_free(firmware_mem_stru *firmware_mem)
     if (firmware_mem->puc_data_buf != HI_NULL) {
         oal_free(firmware_mem->puc_data_buf);
     }
+    if (firmware_mem->puc_data_buf_next != HI_NULL) {
+        oal_free(firmware_mem->puc_data_buf_next);
+    }
     oal_free(firmware_mem);
     firmware_mem = HI_NULL;
 #if (_PRE_FEATURE_USB == _PRE_FEATURE_CHANNEL_TYPE) && (_PRE_OS_VERSION_LITEOS == _PRE_OS_VERSION)
@@ -926,8 +937,90 @@ static hi_s32 exec_quit_type_cmd(firmware_mem_stru *firmware_mem)
 #ifndef _PRE_HI113X_FS_DISABLE
 int g_fw_mode = FIRMWARE_BIN; /* 默认业务bin */
 module_param(g_fw_mode, int, 0644);
+/* ****************************************************************************
+ 功能描述  : 从firmware文件当前位置读取一块数据
+**************************************************************************** */
+static hi_s32 firmware_file_read_chunk(oal_file_stru *fp, hi_u8 *buf, hi_u32 len)
+{
+    hi_s32 rdlen = oal_file_read(fp, buf, len);
+#if (_PRE_OS_VERSION_LINUX == _PRE_OS_VERSION)
+    if (rdlen > 0) {
+        OAL_FILE_POS(fp) += rdlen;
+    }
+#endif
+    return rdlen;
+}
+
+/* ****************************************************************************
+ 功能描述  : 预读work，在当前块占用总线期间读取下一块
+**************************************************************************** */
+static hi_void firmware_prefetch_work(oal_work_stru *work)
+{
+    firmware_prefetch_stru *prefetch = oal_container_of(work, firmware_prefetch_stru, work);
+
+    prefetch->rdlen = firmware_file_read_chunk(prefetch->fp, prefetch->buf, prefetch->len);
+    OAL_COMPLETE(&prefetch->done);
+}
+
+/* ****************************************************************************
+ 功能描述  : 发送一块firmware数据: 先发FILES地址命令，device READY后发送数据并等待FILES OK
+ 输入参数  : buf         : 数据
+             len         : 数据长度
+             addr        : device侧写入地址
+             verify_stage: 0开始 1传输中 2结束 3开始即结束
+ 返 回 值  : -1表示失败，0表示成功
+**************************************************************************** */
+static hi_s32 firmware_send_file_chunk(hi_u8 *buf, hi_s32 len, hi_u32 addr, hi_s32 verify_stage,
+    const firmware_mem_stru *firmware_mem)
+{
+    hi_s32 ret;
+
+    oam_info_log1(0, 0, "exec_file_type_cmd:: send addr is [0x%x]", addr);
+    if (snprintf_s((hi_char *)firmware_mem->puc_send_cmd_buff, CMD_BUFF_LEN, CMD_BUFF_LEN - 1,
+        "%s%c0x%x%c0x%x%c%d%c", FILES_CMD_KEYWORD, COMPART_KEYWORD, addr, COMPART_KEYWORD, len,
+        COMPART_KEYWORD, verify_stage, COMPART_KEYWORD) == -1) {
+        return -OAL_EFAIL;
+    }
+
+    /* 发送地址 */
+    oam_info_log1(0, 0, "exec_file_type_cmd:: send file addr cmd is [%s]", firmware_mem->puc_send_cmd_buff);
+    ret = msg_send_and_recv_except(firmware_mem->puc_send_cmd_buff,
+        strlen((hi_char *)firmware_mem->puc_send_cmd_buff), (const hi_u8 *)MSG_FROM_DEV_READY_OK, firmware_mem);
+    if (ret < 0) {
+        oam_error_log1(0, 0, "exec_file_type_cmd:: SEND [%s] error", (uintptr_t)firmware_mem->puc_send_cmd_buff);
+        return -OAL_EFAIL;
+    }
+    /* Wait at least 5 ms */
+#if (_PRE_OS_VERSION_LINUX == _PRE_OS_VERSION)
+    usleep_range(FILE_CMD_WAIT_TIME_MIN, FILE_CMD_WAIT_TIME_MAX);
+#elif (_PRE_OS_VERSION_LITEOS == _PRE_OS_VERSION)
+    usleep(FILE_CMD_WAIT_TIME_MIN);
+#endif
+    /* 发送文件内容 */
+    ret = msg_send_and_recv_except(buf, len, (const hi_u8 *)MSG_FROM_DEV_FILES_OK, firmware_mem);
+    if (ret < 0) {
+        oam_error_log0(0, 0, "exec_file_type_cmd:: send data fail");
+        return -OAL_EFAIL;
+    }
+    return HI_SUCCESS;
+}
+
+static hi_s32 firmware_file_verify_stage(hi_u32 offset, hi_s32 rdlen, hi_u32 file_len)
+{
+    if (offset == 0 && offset + rdlen == file_len) {
+        return 3; /* 3:start and end. */
+    } else if (offset == 0) {
+        return 0; /* start trans. */
+    } else if (offset + rdlen == file_len) {
+        return 2; /* 2:end trans. */
+    }
+    return 1; /* transferring. */
+}
+
 /* ****************************************************************************
  功能描述  : 执行file类型的命令
+             有第二块数据buffer时双缓冲发送: 当前块在总线上传输(含device READY后的等待)期间，
+             由预读work读取下一块，读文件与总线传输重叠
  输入参数  : key  : 命令的关键字
              val: 命令的参数
  输出参数  : 无
@@ -937,9 +1030,8 @@ static hi_s32 exec_file_type_cmd(hi_u8 *key, hi_u8 *val, firmware_mem_stru *firm
 {
     hi_unref_param(key);
     unsigned long addr;
-    hi_u32 addr_send;
     hi_char *path = HI_NULL;
-    hi_s32 ret;
+    hi_s32 ret = HI_SUCCESS;
     hi_u32 file_len;
     hi_u32 per_send_len;
     hi_u32 send_count;
@@ -947,7 +1039,9 @@ static hi_s32 exec_file_type_cmd(hi_u8 *key, hi_u8 *val, firmware_mem_stru *firm
     hi_u32 i;
     hi_u32 offset = 0;
     oal_file_stru *fp = HI_NULL;
-    hi_s32 verify_stage = 0;
+    hi_u8 *cur_buf = HI_NULL;
+    oal_workqueue_stru *prefetch_wq = HI_NULL;
+    firmware_prefetch_stru prefetch;
 
     if (firmware_mem == HI_NULL || firmware_mem->puc_send_cmd_buff == HI_NULL ||
         firmware_mem->puc_data_buf == HI_NULL) {
@@ -987,65 +1081,61 @@ static hi_s32 exec_file_type_cmd(hi_u8 *key, hi_u8 *val, firmware_mem_stru *firm
     send_count = (file_len + per_send_len - 1) / per_send_len;
     oam_info_log1(0, 0, "exec_file_type_cmd:: send_count=%d", send_count);
 
-    for (i = 0; i < send_count; i++) {
-        rdlen = oal_file_read(fp, firmware_mem->puc_data_buf, per_send_len);
-        if (rdlen > 0) {
-            oam_info_log2(0, 0, "exec_file_type_cmd:: len of kernel_read is [%d], i=%d", rdlen, i);
-#if (_PRE_OS_VERSION_LINUX == _PRE_OS_VERSION)
-            OAL_FILE_POS(fp) += rdlen;
-#endif
-        } else {
-            oam_error_log2(0, 0, "exec_file_type_cmd:: len of kernel_read is error! ret=[%d], i=%d", rdlen, i);
-            oal_file_close(fp);
-            return -OAL_EFAIL;
-        }
+    /* 多于一块且有第二块buffer时启用预读，否则退回顺序读发 */
+    if ((send_count > 1) && (firmware_mem->puc_data_buf_next != HI_NULL)) {
+        prefetch_wq = oal_create_singlethread_workqueue("fw_prefetch_wq");
+    }
+    memset_s(&prefetch, sizeof(prefetch), 0, sizeof(prefetch));
+    OAL_INIT_WORK(&prefetch.work, firmware_prefetch_work);
+    prefetch.fp = fp;
+    prefetch.len = per_send_len;
 
-        addr_send = (hi_u32)(addr + offset);
-        oam_info_log2(0, 0, "exec_file_type_cmd:: send addr is [0x%x], i=%d", addr_send, i);
+    cur_buf = firmware_mem->puc_data_buf;
+    rdlen = firmware_file_read_chunk(fp, cur_buf, per_send_len);
+    for (i = 0; i < send_count; i++) {
+        hi_bool prefetching = HI_FALSE;
 
-        if (offset == 0 && offset + rdlen == file_len) {
-            verify_stage = 3; /* 3:start and end. */
-        } else if (offset == 0) {
-            verify_stage = 0; /* start trans. */
-        } else if (offset + rdlen == file_len) {
-            verify_stage = 2; /* 2:end trans. */
-        } else {
-            verify_stage = 1; /* transferring. */
+        if (rdlen <= 0) {
+            oam_error_log2(0, 0, "exec_file_type_cmd:: len of kernel_read is error! ret=[%d], i=%d", rdlen, i);
+            ret = -OAL_EFAIL;
+            break;
         }
+        oam_info_log2(0, 0, "exec_file_type_cmd:: len of kernel_read is [%d], i=%d", rdlen, i);
 
-        if (snprintf_s((hi_char *)firmware_mem->puc_send_cmd_buff, CMD_BUFF_LEN, CMD_BUFF_LEN - 1,
-            "%s%c0x%x%c0x%x%c%d%c", FILES_CMD_KEYWORD, COMPART_KEYWORD, addr_send, COMPART_KEYWORD, rdlen,
-            COMPART_KEYWORD, verify_stage, COMPART_KEYWORD) == -1) {
-            return -OAL_EFAIL;
+        if ((prefetch_wq != HI_NULL) && (i + 1 < send_count)) {
+            prefetch.buf = (cur_buf == firmware_mem->puc_data_buf) ?
+                firmware_mem->puc_data_buf_next : firmware_mem->puc_data_buf;
+            OAL_INIT_COMPLETION(&prefetch.done);
+            prefetching = (oal_queue_work(prefetch_wq, &prefetch.work) != 0) ? HI_TRUE : HI_FALSE;
         }
 
-        /* 发送地址 */
-        oam_info_log1(0, 0, "exec_file_type_cmd:: send file addr cmd is [%s]", firmware_mem->puc_send_cmd_buff);
-        ret = msg_send_and_recv_except(firmware_mem->puc_send_cmd_buff,
-            strlen((hi_char *)firmware_mem->puc_send_cmd_buff), (const hi_u8 *)MSG_FROM_DEV_READY_OK, firmware_mem);
-        if (ret < 0) {
-            oam_error_log1(0, 0, "exec_file_type_cmd:: SEND [%s] error", (uintptr_t)firmware_mem->puc_send_cmd_buff);
-            oal_file_close(fp);
-            return -OAL_EFAIL;
+        ret = firmware_send_file_chunk(cur_buf, rdlen, (hi_u32)(addr + offset),
+            firmware_file_verify_stage(offset, rdlen, file_len), firmware_mem);
+        /* 预读持有fp与buffer，无论发送成败都要等其完成 */
+        if (prefetching == HI_TRUE) {
+            OAL_WAIT_FOR_COMPLETION(&prefetch.done);
         }
-        /* Wait at least 5 ms */
-#if (_PRE_OS_VERSION_LINUX == _PRE_OS_VERSION)
-        usleep_range(FILE_CMD_WAIT_TIME_MIN, FILE_CMD_WAIT_TIME_MAX);
-#elif (_PRE_OS_VERSION_LITEOS == _PRE_OS_VERSION)
-        usleep(FILE_CMD_WAIT_TIME_MIN);
-#endif
-        /* 发送文件内容 */
-        ret = msg_send_and_recv_except(firmware_mem->puc_data_buf, rdlen, (const hi_u8 *)MSG_FROM_DEV_FILES_OK,
-            firmware_mem);
         if (ret < 0) {
-            oam_error_log0(0, 0, "exec_file_type_cmd:: send data fail");
-            oal_file_close(fp);
-            return -OAL_EFAIL;
+            break;
         }
-
         offset += rdlen;
+
+        if (i + 1 < send_count) {
+            if (prefetching == HI_TRUE) {
+                cur_buf = prefetch.buf;
+                rdlen = prefetch.rdlen;
+            } else {
+                rdlen = firmware_file_read_chunk(fp, cur_buf, per_send_len);
+            }
+        }
+    }
+    if (prefetch_wq != HI_NULL) {
+        oal_destroy_workqueue(prefetch_wq);
     }
     oal_file_close(fp);
+    if (ret < 0) {
+        return -OAL_EFAIL;
+    }
     /* 发送的长度要和文件的长度一致 */
     if (offset != file_len) {
         oam_error_log2(0, 0, "exec_file_type_cmd:: send len[%d] is different with file_len[%d]", offset, file_len);
@@ -174,12 +174,24 @@ typedef struct _firmware_mem {
     hi_u8  *puc_data_buf;
     /* pucDataBuf的长度 */
     hi_u32 ul_data_buf_len;
+    /* 双缓冲预读的第二块buffer，长度同ul_data_buf_len，可为空 */
+    hi_u8  *puc_data_buf_next;
 
 #define CMD_BUFF_LEN 256
     hi_u8 *puc_recv_cmd_buff;
     hi_u8 *puc_send_cmd_buff;
 } firmware_mem_stru;
 
+/* firmware文件预读上下文 */
+typedef struct {
+    oal_work_stru   work;
+    oal_completion  done;
+    oal_file_stru  *fp;
+    hi_u8          *buf;
+    hi_u32          len;
+    hi_s32          rdlen;
+} firmware_prefetch_stru;
+
 typedef struct _efuse_info_st_ {
     hi_u32 chip_id : 8;
     hi_u32 chip_ver : 2;
@@ -509,6 +509,8 @@ void wlan_pm_dump_host_info(void)
     printk("wakeup_fail_timeout:%d\n", wlan_pm->wakeup_fail_timeout);
     printk("wakeup_fail_set_reg:%d\n", wlan_pm->wakeup_fail_set_reg);
     printk("wakeup_fail_submit_work:%d\n", wlan_pm->wakeup_fail_submit_work);
+    printk("wakeup_coalesced:%d\n", wlan_pm->wakeup_coalesced);
+    printk("sleep_gap_avg:%u ms, wdg_adapt_cnt:%u\n", wlan_pm->sleep_gap_avg, wlan_pm->wdg_adapt_cnt);
     printk("sleep_succ:%d\n", wlan_pm->sleep_succ);
     printk("dev_sleep_wait_ack:%d\n", oal_atomic_read(&g_dev_sleep_wait_ack));
     printk("sleep_msg_send_cnt:%d\n", wlan_pm->sleep_msg_send_cnt);
@@ -685,6 +687,31 @@ hi_void wlan_pm_wakeup_fail_process(hi_void)
 #endif
 }
 
+/* ****************************************************************************
+ 功能描述  : 唤醒成功后根据本次睡眠时长更新自适应睡眠检查次数
+             睡眠时长持续偏短说明业务为周期性小突发，延长空闲检查以减少睡眠唤醒次数
+ 输入参数  : wlan_pm
+**************************************************************************** */
+static hi_void wlan_pm_sleep_gap_update(struct wlan_pm_info *wlan_pm)
+{
+    hi_u32 gap;
+
+    if (wlan_pm->sleep_stamp == 0) {
+        return;
+    }
+    gap = hi_get_milli_seconds() - wlan_pm->sleep_stamp;
+    wlan_pm->sleep_stamp = 0;
+    /* 新样本权重1/4的滑动平均 */
+    wlan_pm->sleep_gap_avg = (wlan_pm->sleep_gap_avg * 3 + gap) >> 2; /* 3: 历史权重 2: 除以4 */
+    if (wlan_pm->sleep_gap_avg < WLAN_SLEEP_SHORT_GAP_MS) {
+        if (wlan_pm->wdg_adapt_cnt < WLAN_SLEEP_ADAPT_MAX_CNT) {
+            wlan_pm->wdg_adapt_cnt++;
+        }
+    } else if (wlan_pm->wdg_adapt_cnt > 0) {
+        wlan_pm->wdg_adapt_cnt--;
+    }
+}
+
 unsigned long wlan_pm_wakeup_dev(hi_void)
 {
     struct wlan_pm_info *wlan_pm = wlan_pm_get_drv();
@@ -711,6 +738,15 @@ unsigned long wlan_pm_wakeup_dev(hi_void)
     }
     oal_up(&g_chan_wake_sema);
 
+    /* 并发发送者在此排队，只由第一个执行唤醒握手；排队者拿到锁时握手已结束，成功则直接返回。
+       状态在握手前即置为DISALLOW，函数入口未持锁的判断仍可能在ack之前返回，与原有行为一致 */
+    oal_mutex_lock(&wlan_pm->wakeup_mutex);
+    if (wlan_pm->wlan_dev_state == HOST_DISALLOW_TO_SLEEP) {
+        wlan_pm->wakeup_coalesced++;
+        oal_mutex_unlock(&wlan_pm->wakeup_mutex);
+        return HI_SUCCESS;
+    }
+
 #if (_PRE_FEATURE_SDIO == _PRE_FEATURE_CHANNEL_TYPE)
     oal_wlan_gpio_intr_enable(wlan_pm->bus, HI_FALSE);
 #endif
@@ -724,18 +760,24 @@ unsigned long wlan_pm_wakeup_dev(hi_void)
     wlan_pm_state_set(wlan_pm, HOST_DISALLOW_TO_SLEEP);
     ret = wlan_pm_wakeup_dev_again();
     if (ret != HI_SUCCESS) {
-        goto wakeup_fail;
+        goto wakeup_fail_locked;
     }
     wlan_pm->wakeup_succ++;
     wlan_pm->wdg_timeout_curr_cnt = 0;
     wlan_pm->packet_cnt = 0;
+    wlan_pm_sleep_gap_update(wlan_pm);
+    oal_mutex_unlock(&wlan_pm->wakeup_mutex);
     wlan_pm_feed_wdg();
     return HI_SUCCESS;
 wakeup_fail:
+    oal_mutex_lock(&wlan_pm->wakeup_mutex);
+wakeup_fail_locked:
+    /* 持锁恢复状态，避免排队者在恢复前看到DISALLOW而向已睡眠的device发送 */
 #ifndef _PRE_FEATURE_NO_GPIO
     board_set_wlan_h2d_pm_state(WLAN_PM_SLPREQ_LEVEL);
 #endif
     wlan_pm_state_set(wlan_pm, HOST_ALLOW_TO_SLEEP);
+    oal_mutex_unlock(&wlan_pm->wakeup_mutex);
     wlan_pm_wakeup_fail_process();
     return HI_FAIL;
 }
@@ -1070,6 +1112,7 @@ unsigned long wlan_pm_dev_sleep_request(void)
 #endif
     hcc_tx_transfer_unlock(hcc_host_get_handler());
     wlan_pm->sleep_succ++;
+    wlan_pm->sleep_stamp = hi_get_milli_seconds();
     return HI_SUCCESS;
 fail_sleep:
     wlan_pm_feed_wdg();
@@ -1222,13 +1265,15 @@ void wlan_pm_wdg_timeout(struct wlan_pm_info *wlan_pm)
         oam_error_log0(0, 0, "wlan_pm_wdg_timeout dev info is null !");
         return;
     }
+    /* 近期睡眠时长偏短时，下一个突发大概率很快到来，额外多等wdg_adapt_cnt个周期再请求睡眠 */
+    hi_u32 check_cnt = wlan_pm->wdg_timeout_cnt + wlan_pm->wdg_adapt_cnt;
     if ((wlan_pm->wlan_pm_enable) && (wlan_pm->vote_status == 0)) {
         if (wlan_pm->packet_cnt == 0) {
             wlan_pm->wdg_timeout_curr_cnt++;
-            if ((wlan_pm->wdg_timeout_curr_cnt >= wlan_pm->wdg_timeout_cnt) &&
+            if ((wlan_pm->wdg_timeout_curr_cnt >= check_cnt) &&
                 (wlan_pm_work_submit(wlan_pm, &wlan_pm->sleep_work) != 0)) {
                 oam_warning_log0(0, OAM_SF_PWR, "wlan_pm_sleep_work submit fail,work is running !\n");
-            } else if (wlan_pm->wdg_timeout_curr_cnt >= wlan_pm->wdg_timeout_cnt) {
+            } else if (wlan_pm->wdg_timeout_curr_cnt >= check_cnt) {
                 /* 提交了sleep work后，定时器不重启，避免重复提交sleep work */
                 wlan_pm->sleep_work_submit++;
                 return;
@@ -1309,6 +1354,8 @@ struct wlan_pm_info *wlan_pm_init(void)
     wlan_pm->wdg_timeout_cnt            = WLAN_SLEEP_DEFAULT_CHECK_CNT;
     wlan_pm->wdg_timeout_curr_cnt       = 0;
     wlan_pm->packet_cnt                 = 0;
+    wlan_pm->sleep_gap_avg              = WLAN_SLEEP_SHORT_GAP_MS;
+    OAL_MUTEX_INIT(&wlan_pm->wakeup_mutex);
 
     g_gpst_wlan_pm_info = wlan_pm;
 
@@ -1362,6 +1409,7 @@ unsigned long wlan_pm_exit(hi_void)
     oal_bus_message_unregister(wlan_pm->bus, D2H_MSG_DEV_WKUP);
 
     oal_destroy_workqueue(wlan_pm->pm_wq);
+    OAL_MUTEX_DESTROY(&wlan_pm->wakeup_mutex);
     kfree(wlan_pm);
     g_gpst_wlan_pm_info = HI_NULL;
     printk("[plat_pm]wlan_pm_exit SUCCESSFULLY\r\n");
@@ -53,6 +53,8 @@
 #define WLAN_SLEEP_TIMER_PERIOD         80        /* 睡眠定时器80ms定时 */
 #define WLAN_SLEEP_DEFAULT_CHECK_CNT    5         /* 默认检查5次，即400ms */
 #define WLAN_SLEEP_LONG_CHECK_CNT       10        /* 入网阶段,延长至400ms */
+#define WLAN_SLEEP_SHORT_GAP_MS         320       /* 睡眠时长小于该值视为"睡了即醒",睡眠不划算 */
+#define WLAN_SLEEP_ADAPT_MAX_CNT        5         /* 自适应延长睡眠检查的最大次数,即再多等400ms */
 #define WLAN_SDIO_MSG_RETRY_NUM         3
 #define WLAN_WAKEUP_FAIL_MAX_TIMES      1         /* 连续多少次wakeup失败，可进入DFR流程 */
 #define WLAN_TRY_WAKEUP_FAIL_TIMES      3
@@ -137,6 +139,12 @@ struct wlan_pm_info {
     hi_u32                  slpreq_flag;
     hi_u32                  slpack;
 
+    /* 自适应睡眠:根据历史睡眠时长预测下一个突发,避免频繁睡眠唤醒 */
+    oal_mutex_stru          wakeup_mutex;            /* 串行化唤醒握手,并发发送者共享一次唤醒 */
+    hi_u32                  sleep_stamp;             /* 最近一次入睡时间戳(ms) */
+    hi_u32                  sleep_gap_avg;           /* 入睡到下次唤醒时长的平滑均值(ms) */
+    hi_u32                  wdg_adapt_cnt;           /* 在wdg_timeout_cnt基础上额外等待的检查次数 */
+
     oal_completion          close_done;
     oal_completion          device_ready;
     oal_completion          wakeup_done;
@@ -158,6 +166,7 @@ struct wlan_pm_info {
     hi_u32                  wakeup_fail_set_reg;
     hi_u32                  wakeup_fail_submit_work;
     hi_u32                  wakeup_gpio_up_cnt;
+    hi_u32                  wakeup_coalesced;
 
     hi_u32                  sleep_succ;
     hi_u32                  sleep_feed_wdg_cnt;
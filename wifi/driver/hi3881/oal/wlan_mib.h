@@ -968,6 +968,9 @@ typedef enum {
     WLAN_CFGID_EDCA_OPT_CYCLE_AP     = 345,         /* 设置AP的edca调整周期 */
     WLAN_CFGID_EDCA_OPT_SWITCH_STA   = 346,         /* 设置STA的edca优化开关 */
 #endif
+#endif
+#if defined(_PRE_WLAN_FEATURE_M2U) && defined(_PRE_WLAN_FEATURE_HIPRIV)
+    WLAN_CFGID_M2U_SNOOP_ON          = 347,         /* 设置组播侦听及转单播参数 */
 #endif
     WLAN_CFGID_PROTECTION_UPDATE_STA_USER = 348, /* 增加用户更新保护模式 */
 #ifdef _PRE_DEBUG_MODE
@@ -54,31 +54,455 @@ static const char* g_log_tag[OAM_LOG_LEVEL_BUTT] = {
     [OAM_LOG_LEVEL_VERBOSE] = "V",
 };
 
+/* ****************************************************************************
+  调用点限速:按(文件,行号)散列到2路组相联的令牌桶，突发OAM_LOG_RL_BURST条后每OAM_LOG_RL_INTERVAL_MS补充1条
+  组内两个桶均被占用时淘汰最久未补充的一个；每个CPU一张表，关本地中断后更新，无需加锁
+  所有级别均限速；开始抑制及抑制结束的汇总均同步输出，异常复位时不丢失抑制信息
+**************************************************************************** */
+#define OAM_LOG_RL_SET_BITS         5
+#define OAM_LOG_RL_SET_NUM          (1 << OAM_LOG_RL_SET_BITS)
+#define OAM_LOG_RL_WAYS             2
+#define OAM_LOG_RL_BURST            10
+#define OAM_LOG_RL_INTERVAL_MS      200
+#define OAM_LOG_RL_HASH_GOLDEN      0x9E3779B1U
+#define OAM_LOG_FMT_UNKNOWN         0
+#define OAM_LOG_FMT_DEFER           1
+#define OAM_LOG_FMT_SYNC            2
+
+typedef struct {
+    const hi_char *file;
+    hi_u32 stamp;                           /* 上次补充令牌的时间(ms) */
+    hi_u32 suppressed;                      /* 被抑制的条数，放行时汇总输出 */
+    hi_u16 line_no;
+    hi_u8 tokens;
+    hi_u8 fmt_defer;                        /* 格式串能否延迟输出的缓存，同一调用点的格式串固定 */
+} oam_log_rl_site_stru;
+
+typedef struct {
+    oam_log_rl_site_stru site[OAM_LOG_RL_SET_NUM][OAM_LOG_RL_WAYS];
+} oam_log_rl_table_stru;
+
+#if (_PRE_OS_VERSION_LINUX == _PRE_OS_VERSION)
+typedef unsigned long oam_log_rl_irq_flag;
+static DEFINE_PER_CPU(oam_log_rl_table_stru, g_oam_log_rl_table);
+#define oam_log_rl_table_local()            this_cpu_ptr(&g_oam_log_rl_table)
+#define oam_log_rl_irq_save(_flags)         local_irq_save(_flags)
+#define oam_log_rl_irq_restore(_flags)      local_irq_restore(_flags)
+#elif (_PRE_OS_VERSION_LITEOS == _PRE_OS_VERSION)
+typedef hi_u32 oam_log_rl_irq_flag;
+#ifdef LOSCFG_KERNEL_SMP
+#define OAM_LOG_RL_TABLE_NUM                LOSCFG_KERNEL_CORE_NUM
+#define oam_log_rl_table_id()               ArchCurrCpuid()
+#else
+#define OAM_LOG_RL_TABLE_NUM                1
+#define oam_log_rl_table_id()               0
+#endif
+static oam_log_rl_table_stru g_oam_log_rl_table[OAM_LOG_RL_TABLE_NUM];
+#define oam_log_rl_table_local()            (&g_oam_log_rl_table[oam_log_rl_table_id()])
+#define oam_log_rl_irq_save(_flags)         ((_flags) = LOS_IntLock())
+#define oam_log_rl_irq_restore(_flags)      LOS_IntRestore(_flags)
+#endif
+
+/* ****************************************************************************
+ 功能描述  : 判断格式串能否延迟输出，每个调用点只扫描一次，结果缓存在限速表项中
+             带%s/64位参数的格式串引用的内容在drain时可能已失效，保持同步；
+             %p在64位系统上不是32位参数，同样保持同步
+**************************************************************************** */
+static hi_bool oam_log_fmt_deferrable(const hi_char *fmt)
+{
+    const hi_char *pos = fmt;
+
+    while ((pos = strchr(pos, '%')) != HI_NULL) {
+        pos++;
+        while ((*pos >= '0' && *pos <= '9') || *pos == '-' || *pos == '#' || *pos == '.') {
+            pos++;
+        }
+        if (*pos == 's' || *pos == 'l' || *pos == 'p') {
+            return HI_FALSE;
+        }
+        if (*pos != '\0') {
+            pos++;
+        }
+    }
+    return HI_TRUE;
+}
+
+static hi_void oam_log_rl_report(const hi_char *file, hi_u16 line_no, hi_u32 suppressed)
+{
+    const hi_char *name = hi_strrchr(file, '/');
+
+    if (suppressed == 0) {
+        PRINT("[oam][%s:%d] rate limited, suppressing\r\n", (name != HI_NULL) ? name : file, line_no);
+        return;
+    }
+    PRINT("[oam][%s:%d] %u logs suppressed\r\n", (name != HI_NULL) ? name : file, line_no, suppressed);
+}
+
+static oam_log_rl_site_stru *oam_log_rl_site_lookup(oam_log_rl_site_stru *set, const hi_char *file,
+    hi_u16 line_no)
+{
+    oam_log_rl_site_stru *victim = &set[0];
+    hi_u32 way;
+
+    for (way = 0; way < OAM_LOG_RL_WAYS; way++) {
+        if ((set[way].file == file) && (set[way].line_no == line_no)) {
+            return &set[way];
+        }
+        if ((set[way].file == HI_NULL) || ((victim->file != HI_NULL) && (set[way].stamp < victim->stamp))) {
+            victim = &set[way];
+        }
+    }
+    return victim;
+}
+
+/* ****************************************************************************
+ 功能描述  : 调用点限速判断，返回HI_FALSE表示本条日志应被丢弃
+             fmt非空且放行时，通过fmt_defer返回该调用点格式串能否延迟输出
+**************************************************************************** */
+static hi_bool oam_log_rl_check(const hi_char *file, hi_u16 line_no, const hi_char *fmt, hi_u8 *fmt_defer)
+{
+    hi_u32 hash = ((hi_u32)(uintptr_t)file + line_no) * OAM_LOG_RL_HASH_GOLDEN;
+    hi_u32 now = hi_get_milli_seconds();
+    const hi_char *report_file = HI_NULL;
+    hi_u16 report_line = 0;
+    hi_u32 report_cnt = 0;
+    hi_bool allowed = HI_TRUE;
+    hi_bool start = HI_FALSE;
+    oam_log_rl_site_stru *site = HI_NULL;
+    oam_log_rl_irq_flag flags;
+    hi_u32 refill;
+
+    oam_log_rl_irq_save(flags);
+    site = oam_log_rl_site_lookup(oam_log_rl_table_local()->site[hash >> (32 - OAM_LOG_RL_SET_BITS)], /* 32: 取高位 */
+        file, line_no);
+    if ((site->file != file) || (site->line_no != line_no)) {
+        /* 被淘汰的调用点先汇总其抑制条数 */
+        report_file = site->file;
+        report_line = site->line_no;
+        report_cnt = site->suppressed;
+        site->file = file;
+        site->line_no = line_no;
+        site->stamp = now;
+        site->tokens = OAM_LOG_RL_BURST;
+        site->suppressed = 0;
+        site->fmt_defer = OAM_LOG_FMT_UNKNOWN;
+    }
+    refill = (now - site->stamp) / OAM_LOG_RL_INTERVAL_MS;
+    if (refill != 0) {
+        site->tokens = (hi_u8)oal_min(site->tokens + refill, OAM_LOG_RL_BURST);
+        site->stamp += refill * OAM_LOG_RL_INTERVAL_MS;
+    }
+    if (site->tokens == 0) {
+        /* 首次被抑制时先输出提示，汇总条数在恢复放行或被淘汰时输出 */
+        start = (site->suppressed == 0) ? HI_TRUE : HI_FALSE;
+        site->suppressed++;
+        allowed = HI_FALSE;
+    } else {
+        site->tokens--;
+        if (site->suppressed != 0) {
+            report_file = site->file;
+            report_line = site->line_no;
+            report_cnt = site->suppressed;
+            site->suppressed = 0;
+        }
+        if (fmt != HI_NULL) {
+            if (site->fmt_defer == OAM_LOG_FMT_UNKNOWN) {
+                site->fmt_defer = oam_log_fmt_deferrable(fmt) ? OAM_LOG_FMT_DEFER : OAM_LOG_FMT_SYNC;
+            }
+            *fmt_defer = site->fmt_defer;
+        }
+    }
+    oam_log_rl_irq_restore(flags);
+
+    if (report_cnt != 0) {
+        oam_log_rl_report(report_file, report_line, report_cnt);
+    }
+    if (start == HI_TRUE) {
+        oam_log_rl_report(file, line_no, 0);
+    }
+    return allowed;
+}
+
+hi_bool oam_log_ratelimit(const hi_char *file, hi_u16 line_no)
+{
+    return oam_log_rl_check(file, line_no, HI_NULL, HI_NULL);
+}
+
+/* ****************************************************************************
+  延迟日志环:热点路径只记录(格式串,行号,级别,时间戳,4个整型参数)，由低优先级线程统一格式化输出
+  每个CPU一个环，写入方关本地中断后单生产者写入，drain线程单消费者读取，全程无锁
+**************************************************************************** */
+#define OAM_LOG_RING_SIZE           256       /* 每个环的条目数，必须为2的幂 */
+#define OAM_LOG_RING_MASK           (OAM_LOG_RING_SIZE - 1)
+#define OAM_LOG_PARAM_MAX           4
+#define OAM_LOG_DRAIN_PERIOD_MS     20        /* 环为空时drain线程的轮询周期 */
+#define OAM_LOG_DRAIN_BUDGET        64        /* 每个环每轮最多输出的条目数，避免长时间占用CPU */
+#define OAM_LOG_TASK_NAME           "hisi_oam_log"
+#define OAM_LOG_TASK_SIZE           0x1000
+#if (_PRE_OS_VERSION_LINUX == _PRE_OS_VERSION)
+#define OAM_LOG_TASK_PRIO           0         /* SCHED_NORMAL */
+#define OAM_LOG_TASK_POLICY         0
+#define oam_log_ring_ctx_num()      nr_cpu_ids
+#define oam_log_ring_ctx_id()       raw_smp_processor_id()
+static DEFINE_PER_CPU(hi_u32, g_oam_log_ring_busy);
+#define oam_log_ring_busy_local()   ((volatile hi_u32 *)this_cpu_ptr(&g_oam_log_ring_busy))
+#define oam_log_ring_busy_of(_ctx)  (cpu_possible(_ctx) ? \
+    (volatile hi_u32 *)per_cpu_ptr(&g_oam_log_ring_busy, _ctx) : HI_NULL)
+#elif (_PRE_OS_VERSION_LITEOS == _PRE_OS_VERSION)
+#define OAM_LOG_TASK_PRIO           30        /* 低于所有驱动任务 */
+#define OAM_LOG_TASK_POLICY         OAL_SCHED_RR
+#ifdef LOSCFG_KERNEL_SMP
+#define oam_log_ring_ctx_num()      LOSCFG_KERNEL_CORE_NUM
+#define oam_log_ring_ctx_id()       ArchCurrCpuid()
+#else
+#define oam_log_ring_ctx_num()      1
+#define oam_log_ring_ctx_id()       0
+#endif
+static volatile hi_u32 g_oam_log_ring_busy[oam_log_ring_ctx_num()];
+#define oam_log_ring_busy_local()   (&g_oam_log_ring_busy[oam_log_ring_ctx_id()])
+#define oam_log_ring_busy_of(_ctx)  (&g_oam_log_ring_busy[_ctx])
+#endif
+
+typedef struct {
+    const hi_char *fmt;                     /* 格式串为常量字符串，drain时直接使用 */
+    hi_u32 time_ms;
+    hi_u16 line_no;
+    hi_u8 level;
+    hi_u8 resv;
+    hi_u32 args[OAM_LOG_PARAM_MAX];         /* 可延迟的格式串只含32位整型转换符 */
+} oam_log_entry_stru;
+
+typedef struct {
+    volatile hi_u32 head;                   /* 仅写入方修改 */
+    volatile hi_u32 tail;                   /* 仅drain线程修改 */
+    volatile hi_u32 drop_cnt;               /* 环满丢弃计数，仅写入方修改 */
+    hi_u32 drop_reported;                   /* 已上报的丢弃计数，仅drain线程修改 */
+    oam_log_entry_stru entry[OAM_LOG_RING_SIZE];
+} oam_log_ring_stru;
+
+static oam_log_ring_stru *g_oam_log_ring = HI_NULL;
+static hi_u32 g_oam_log_ring_num = 0;
+static oal_kthread_stru *g_oam_log_thread = HI_NULL;
+static volatile hi_u8 g_oam_log_exit = HI_FALSE;
+static volatile hi_u8 g_oam_log_stopped = HI_FALSE;
+
+/* ****************************************************************************
+ 功能描述  : 记录到本CPU的环，环未创建或正在释放时返回HI_FALSE，由调用者同步输出
+             关中断区内先置本CPU的忙标志再读环指针，释放环前等待各CPU忙标志清零
+**************************************************************************** */
+static hi_bool oam_log_ring_record(const hi_char *fmt, hi_u16 us_line_no, hi_u8 clog_level, va_list args)
+{
+    oam_log_ring_stru *rings = HI_NULL;
+    oam_log_ring_stru *ring = HI_NULL;
+    oam_log_entry_stru *entry = HI_NULL;
+    volatile hi_u32 *busy = HI_NULL;
+    hi_u32 idx;
+#if (_PRE_OS_VERSION_LINUX == _PRE_OS_VERSION)
+    unsigned long flags;
+
+    local_irq_save(flags);
+#elif (_PRE_OS_VERSION_LITEOS == _PRE_OS_VERSION)
+    hi_u32 flags = LOS_IntLock();
+#endif
+    busy = oam_log_ring_busy_local();
+    *busy = HI_TRUE;
+    oal_smp_mb();
+    rings = g_oam_log_ring;
+    if (rings != HI_NULL) {
+        ring = &rings[oam_log_ring_ctx_id()];
+        if (ring->head - ring->tail >= OAM_LOG_RING_SIZE) {
+            ring->drop_cnt++;
+        } else {
+            entry = &ring->entry[ring->head & OAM_LOG_RING_MASK];
+            entry->fmt = fmt;
+            entry->time_ms = oal_get_curr_time_ms();
+            entry->line_no = us_line_no;
+            entry->level = clog_level;
+            /* oam_logN固定传入4个参数，不足的以0补齐；按int提升后的宽度读取，与同步路径的消费方式一致 */
+            for (idx = 0; idx < OAM_LOG_PARAM_MAX; idx++) {
+                entry->args[idx] = va_arg(args, hi_u32);
+            }
+            oal_smp_mb();
+            ring->head++;
+        }
+    }
+    oal_smp_mb();
+    *busy = HI_FALSE;
+#if (_PRE_OS_VERSION_LINUX == _PRE_OS_VERSION)
+    local_irq_restore(flags);
+#elif (_PRE_OS_VERSION_LITEOS == _PRE_OS_VERSION)
+    LOS_IntRestore(flags);
+#endif
+    return (rings != HI_NULL) ? HI_TRUE : HI_FALSE;
+}
+
+static hi_void oam_log_entry_print(const oam_log_entry_stru *entry)
+{
+    hi_char buffer[OAM_PRINT_FORMAT_LENGTH] = {0};
+    hi_s32 offset;
+    hi_s32 tmp;
+
+    offset = snprintf_s(buffer, OAM_PRINT_FORMAT_LENGTH, OAM_PRINT_FORMAT_LENGTH - 1, "[%d][%s:%d]",
+        entry->time_ms, g_log_tag[entry->level], entry->line_no);
+    if (offset == -1) {
+        return;
+    }
+    tmp = snprintf_s(buffer + offset, OAM_PRINT_FORMAT_LENGTH - offset, OAM_PRINT_FORMAT_LENGTH - offset - 1,
+        entry->fmt, entry->args[0], entry->args[1], entry->args[2], entry->args[3]); /* 0 1 2 3: 参数下标 */
+    if (tmp == -1) {
+        return;
+    }
+    offset = offset + tmp;
+    if (snprintf_s(buffer + offset,
+        OAM_PRINT_FORMAT_LENGTH - offset, OAM_PRINT_FORMAT_LENGTH - offset - 1, "\r\n") == -1) {
+        return;
+    }
+    PRINT(buffer);
+}
+
+static hi_u32 oam_log_ring_drain(oam_log_ring_stru *rings)
+{
+    hi_u32 ctx;
+    hi_u32 num;
+    hi_u32 total = 0;
+
+    for (ctx = 0; ctx < g_oam_log_ring_num; ctx++) {
+        oam_log_ring_stru *ring = &rings[ctx];
+        hi_u32 drop = ring->drop_cnt;
+        for (num = 0; (num < OAM_LOG_DRAIN_BUDGET) && (ring->tail != ring->head); num++) {
+            oal_smp_mb();
+            oam_log_entry_print(&ring->entry[ring->tail & OAM_LOG_RING_MASK]);
+            oal_smp_mb();
+            ring->tail++;
+        }
+        if (drop != ring->drop_reported) {
+            PRINT("[oam]ctx %u dropped %u logs\r\n", ctx, drop - ring->drop_reported);
+            ring->drop_reported = drop;
+        }
+        total += num;
+    }
+    return total;
+}
+
+static hi_s32 oam_log_drain_thread(hi_void *data)
+{
+    oam_log_ring_stru *rings = (oam_log_ring_stru *)data;
+#if (_PRE_OS_VERSION_LINUX == _PRE_OS_VERSION)
+    allow_signal(SIGTERM);
+#endif
+    while (g_oam_log_exit == HI_FALSE && !oal_kthread_should_stop()) {
+        if (oam_log_ring_drain(rings) == 0) {
+            oal_msleep(OAM_LOG_DRAIN_PERIOD_MS);
+        }
+    }
+    g_oam_log_stopped = HI_TRUE;
+    return HI_SUCCESS;
+}
+
+/* ****************************************************************************
+ 功能描述  : 创建延迟日志环与drain线程，失败时日志退回同步输出
+**************************************************************************** */
+hi_u32 oam_log_ring_init(hi_void)
+{
+    oal_kthread_param_stru thread_param = { 0 };
+    hi_u32 size = (hi_u32)(oam_log_ring_ctx_num() * sizeof(oam_log_ring_stru));
+    oam_log_ring_stru *ring = oal_memalloc(size);
+    if (ring == HI_NULL) {
+        return HI_ERR_CODE_ALLOC_MEM_FAIL;
+    }
+    memset_s(ring, size, 0, size);
+    g_oam_log_ring_num = (hi_u32)oam_log_ring_ctx_num();
+    g_oam_log_exit = HI_FALSE;
+    g_oam_log_stopped = HI_FALSE;
+
+    thread_param.l_cpuid = NOT_BIND_CPU;
+    thread_param.l_policy = OAM_LOG_TASK_POLICY;
+    thread_param.l_prio = OAM_LOG_TASK_PRIO;
+    thread_param.ul_stacksize = OAM_LOG_TASK_SIZE;
+    g_oam_log_thread = oal_kthread_create(OAM_LOG_TASK_NAME, oam_log_drain_thread, ring, &thread_param);
+    if (IS_ERR_OR_NULL(g_oam_log_thread)) {
+        g_oam_log_thread = HI_NULL;
+        oal_free(ring);
+        return HI_FAIL;
+    }
+    oal_smp_mb();
+    g_oam_log_ring = ring;
+    return HI_SUCCESS;
+}
+
+/* ****************************************************************************
+ 功能描述  : 停止drain线程，输出环中剩余日志后释放
+**************************************************************************** */
+hi_void oam_log_ring_exit(hi_void)
+{
+    oam_log_ring_stru *ring = g_oam_log_ring;
+    hi_u32 times = 0;
+    hi_u32 ctx;
+
+    if (ring == HI_NULL) {
+        return;
+    }
+    g_oam_log_ring = HI_NULL;
+    g_oam_log_exit = HI_TRUE;
+    while (g_oam_log_stopped == HI_FALSE && times < 100) { /* 最多等待100个周期 */
+        oal_msleep(OAM_LOG_DRAIN_PERIOD_MS);
+        times++;
+    }
+#if (_PRE_OS_VERSION_LINUX == _PRE_OS_VERSION)
+    if (g_oam_log_stopped == HI_FALSE) {
+        oal_kthread_stop(g_oam_log_thread);
+    }
+#endif
+    g_oam_log_thread = HI_NULL;
+    /* 写入方先置忙标志再读环指针，此处先清指针再检查忙标志，二者均有全屏障，不会漏掉仍持有旧指针的写入方 */
+    oal_smp_mb();
+    for (ctx = 0; ctx < g_oam_log_ring_num; ctx++) {
+        volatile hi_u32 *busy = oam_log_ring_busy_of(ctx);
+        while ((busy != HI_NULL) && (*busy != HI_FALSE)) {
+            oal_msleep(1);
+        }
+    }
+    (hi_void)oam_log_ring_drain(ring);
+    oal_free(ring);
+}
+
 hi_void oal_print_nlogs(const hi_char *pfile_name, const hi_char *pfuc_name, hi_u16 us_line_no, void *pfunc_addr,
     hi_u8 uc_vap_id, hi_u8 en_feature_id, hi_u8 clog_level, hi_u8 uc_param_cnt, hi_char *fmt, ...)
 {
     hi_char buffer[OAM_PRINT_FORMAT_LENGTH] = {0};
+    /* ERROR级别保持同步输出，避免异常复位前丢失；无参数的格式串可直接延迟，参数过多的保持同步 */
+    hi_bool need_scan = (clog_level != OAM_LOG_LEVEL_ERROR) && (uc_param_cnt != 0) &&
+        (uc_param_cnt <= OAM_LOG_PARAM_MAX);
+    hi_u8 fmt_defer = ((clog_level != OAM_LOG_LEVEL_ERROR) && (uc_param_cnt == 0)) ?
+        OAM_LOG_FMT_DEFER : OAM_LOG_FMT_SYNC;
     hi_s32 offset;
     hi_s32 tmp;
 
-    hi_unref_param(pfile_name);
     hi_unref_param(pfuc_name);
     hi_unref_param(pfunc_addr);
     hi_unref_param(uc_vap_id);
     hi_unref_param(en_feature_id);
-    hi_unref_param(uc_param_cnt);
 
 
     if (clog_level > g_level_log || clog_level >= OAM_LOG_LEVEL_BUTT) {
         return;
     }
+    /* 所有级别均限速，逐包失败的ERROR日志同样会形成风暴；放行的ERROR日志仍同步输出 */
+    if (oam_log_rl_check(pfile_name, us_line_no, need_scan ? fmt : HI_NULL, &fmt_defer) == HI_FALSE) {
+        return;
+    }
+    va_list args;
+    va_start(args, fmt);
+    if ((fmt_defer == OAM_LOG_FMT_DEFER) && (oam_log_ring_record(fmt, us_line_no, clog_level, args) == HI_TRUE)) {
+        va_end(args);
+        return;
+    }
     offset = snprintf_s(buffer, OAM_PRINT_FORMAT_LENGTH, OAM_PRINT_FORMAT_LENGTH - 1, "[%d][%s:%d]",
         oal_get_curr_time_ms(), g_log_tag[clog_level], us_line_no);
     if (offset == -1) {
+        va_end(args);
         return;
     }
-    va_list args;
-    va_start(args, fmt);
     tmp = vsprintf_s(buffer + offset, OAM_PRINT_FORMAT_LENGTH - offset - 1, fmt, args);
     if (tmp == -1) {
         va_end(args);
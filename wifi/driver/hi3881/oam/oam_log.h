@@ -28,10 +28,19 @@ extern "C" {
 #endif
 #endif
 
+/* ****************************************************************************
+  7 宏定义
+**************************************************************************** */
+/* 非oam日志接口的输出(如hex dump)复用调用点限速 */
+#define oam_log_site_allowed() oam_log_ratelimit(__FILE__, (hi_u16)__LINE__)
+
 /* ****************************************************************************
   10 函数声明
 **************************************************************************** */
 hi_u32 oam_log_level_set(hi_u32 log_level);
+hi_u32 oam_log_ring_init(hi_void);
+hi_void oam_log_ring_exit(hi_void);
+hi_bool oam_log_ratelimit(const hi_char *file, hi_u16 line_no);
 
 hi_void oal_print_nlogs(const hi_char *pfile_name, const hi_char *pfuc_name, hi_u16 us_line_no, void *pfunc_addr,
     hi_u8 uc_vap_id, hi_u8 en_feature_id, hi_u8 clog_level, hi_u8 uc_param_cnt, hi_char *fmt, ...);
@@ -118,6 +118,10 @@ hi_s32 oam_main_init(hi_void)
         return ret;
     }
 #endif
+    /* 日志环创建失败不影响功能，日志退回同步输出 */
+    if (oam_log_ring_init() != HI_SUCCESS) {
+        printk("oam_main_init: log ring init fail, log synchronously\r\n");
+    }
     printk("oam_main_init SUCCESSFULLY!\r\n");
     return HI_SUCCESS;
 }
@@ -135,6 +139,7 @@ hi_void oam_main_exit(hi_void)
         oam_warning_log0(0, 0, "oam_main_exit:: oam_user_ctrl_exit fail!");
     }
 #endif
+    oam_log_ring_exit();
     return;
 }
 #endif
@@ -1365,8 +1365,9 @@ hi_u8 hi_wifi_wow_set_pattern(const hi_char *ifname, hi_u32 type, hi_u8 index, h
 /* wow 唤醒/睡眠请求 */
 hi_u8 hi_wifi_wow_host_sleep_switch(const hi_char *ifname, hi_u8 en)
 {
-    wal_msg_write_stru       write_msg;
+    wal_msg_batch_stru       batch;
     oal_net_device_stru     *netdev = HI_NULL;
+    hi_s32                   value = en; /* 两个WID的参数均为4字节使能开关 */
     hi_u32                   ret;
 
     netdev = oal_get_netdev_by_name(ifname);
@@ -1381,26 +1382,15 @@ hi_u8 hi_wifi_wow_host_sleep_switch(const hi_char *ifname, hi_u8 en)
     }
 
     /* **************************************************************************
-                                抛事件到wal层处理
+                    两个WID打包为一个事件抛到wal层处理，hmac按顺序执行
     ************************************************************************** */
-    wal_write_msg_hdr_init(&write_msg, WLAN_CFGID_WOW_ACTIVATE_EN, sizeof(hi_s32));
-    *((hi_u8 *)(write_msg.auc_value)) = en; /* 设置配置命令参数 */
-
-    ret = wal_send_cfg_event(netdev, WAL_MSG_TYPE_WRITE, WAL_MSG_WRITE_MSG_HDR_LENGTH + sizeof(hi_s32),
-        (hi_u8 *)&write_msg, HI_FALSE, HI_NULL);
-    if (oal_unlikely(ret != HI_SUCCESS)) {
-        oam_warning_log1(0, OAM_SF_ANY, "{hi_wifi_wow_enable_switch::return err code[%u]!}", ret);
-        return ret;
+    wal_msg_batch_init(&batch);
+    if ((wal_msg_batch_add(&batch, WLAN_CFGID_WOW_ACTIVATE_EN, &value, sizeof(hi_s32)) != HI_SUCCESS) ||
+        (wal_msg_batch_add(&batch, WLAN_CFGID_HOST_SLEEP_EN, &value, sizeof(hi_s32)) != HI_SUCCESS)) {
+        return HI_FAIL;
     }
 
-    /* **************************************************************************
-                                抛事件到wal层处理
-    ************************************************************************** */
-    wal_write_msg_hdr_init(&write_msg, WLAN_CFGID_HOST_SLEEP_EN, sizeof(hi_s32));
-    *((hi_s32 *)(write_msg.auc_value)) = en; /* 设置配置命令参数 */
-
-    ret = wal_send_cfg_event(netdev, WAL_MSG_TYPE_WRITE, WAL_MSG_WRITE_MSG_HDR_LENGTH + sizeof(hi_s32),
-        (hi_u8 *)&write_msg, HI_FALSE, HI_NULL);
+    ret = wal_send_cfg_batch(netdev, &batch, HI_FALSE);
     if (oal_unlikely(ret != HI_SUCCESS)) {
         oam_warning_log1(0, OAM_SF_ANY, "{hi_wifi_wow_host_sleep_switch::return err code[%u]!}\r\n", ret);
         return ret;
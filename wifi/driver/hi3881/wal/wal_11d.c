@@ -36,6 +36,7 @@ extern "C" {
 /* ****************************************************************************
   2 全局变量定义
 **************************************************************************** */
+/* 按国家码升序排列，wal_get_dfs_domain二分查找依赖此顺序 */
 const wal_dfs_domain_entry_stru g_ast_dfs_domain_table[] = {
     {"AE", MAC_DFS_DOMAIN_ETSI, {0, 0, 0}},
     {"AL", MAC_DFS_DOMAIN_NULL, {0, 0, 0}},
@@ -238,12 +239,23 @@ static inline hi_u32 wal_regdomain_get_channel(hi_u8 band, hi_u32 start_freq, hi
 **************************************************************************** */
 static inline hi_void wal_get_dfs_domain(mac_regdomain_info_stru *mac_regdom, const hi_char *pc_country)
 {
-    hi_u32 u_idx;
+    hi_u32 low = 0;
+    hi_u32 high = hi_array_size(g_ast_dfs_domain_table);
+    hi_u32 mid;
+    hi_u16 key = wal_regdb_alpha2_key(pc_country);
+    hi_u16 mid_key;
 
-    for (u_idx = 0; u_idx < hi_array_size(g_ast_dfs_domain_table); u_idx++) {
-        if (0 == strcmp(g_ast_dfs_domain_table[u_idx].pc_country, pc_country)) {
-            mac_regdom->dfs_domain = g_ast_dfs_domain_table[u_idx].dfs_domain;
+    /* g_ast_dfs_domain_table按国家码升序排列，二分查找 */
+    while (low < high) {
+        mid = low + ((high - low) >> 1);
+        mid_key = wal_regdb_alpha2_key(g_ast_dfs_domain_table[mid].pc_country);
+        if (mid_key == key) {
+            mac_regdom->dfs_domain = g_ast_dfs_domain_table[mid].dfs_domain;
             return;
+        } else if (mid_key < key) {
+            low = mid + 1;
+        } else {
+            high = mid;
         }
     }
 
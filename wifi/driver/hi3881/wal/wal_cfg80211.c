@@ -360,18 +360,8 @@ hi_u32 wal_del_p2p_group(const mac_device_stru *mac_dev)
 hi_u32 wal_set_p2p_status(oal_net_device_stru *netdev, wlan_p2p_status_enum_uint32 status)
 {
     hi_u32 ret;
-    wal_msg_write_stru write_msg;
 
-    /* 填写消息头 */
-    wal_write_msg_hdr_init(&write_msg, WLAN_CFGID_SET_P2P_STATUS, sizeof(wlan_p2p_status_enum_uint32));
-    /* 填写消息体 */
-    if (memcpy_s(write_msg.auc_value, sizeof(write_msg.auc_value),
-                 &status, sizeof(wlan_p2p_status_enum_uint32)) != EOK) {
-        oam_error_log0(0, OAM_SF_ANY, "{wal_set_p2p_status::mem safe function err!}");
-        return HI_FAIL;
-    }
-    ret = wal_send_cfg_event(netdev, WAL_MSG_TYPE_WRITE,
-        WAL_MSG_WRITE_MSG_HDR_LENGTH + sizeof(wlan_p2p_status_enum_uint32), (hi_u8 *)&write_msg, HI_FALSE, HI_NULL);
+    ret = wal_post_cfg_event(netdev, WLAN_CFGID_SET_P2P_STATUS, &status, sizeof(wlan_p2p_status_enum_uint32));
     if (oal_unlikely(ret != HI_SUCCESS)) {
         oam_warning_log1(0, OAM_SF_ANY, "{wal_set_p2p_status::return err code [%u]!}\r\n", ret);
         return HI_FAIL;
@@ -688,7 +678,6 @@ hi_u32 wal_find_wmm_uapsd(hi_u8 *puc_frame_body, hi_s32 l_len)
 hi_u32 wal_cfg80211_open_wmm(oal_net_device_stru *netdev, hi_u16 us_len, hi_u8 *puc_param)
 {
     mac_vap_stru *mac_vap = HI_NULL;
-    wal_msg_write_stru write_msg;
     hi_u32 ret;
     mac_vap = oal_net_dev_priv(netdev);
     if (oal_unlikely(mac_vap == HI_NULL || puc_param == HI_NULL)) {
@@ -702,16 +691,7 @@ hi_u32 wal_cfg80211_open_wmm(oal_net_device_stru *netdev, hi_u16 us_len, hi_u8 *
         return HI_FAIL;
     }
 
-    /* 填写事件头 */
-    wal_write_msg_hdr_init(&write_msg, WLAN_CFGID_WMM_SWITCH, sizeof(hi_u8));
-    /* 填写消息体 */
-    if (memcpy_s(write_msg.auc_value, sizeof(write_msg.auc_value), puc_param, sizeof(hi_u8)) != EOK) {
-        oam_error_log0(0, OAM_SF_CFG, "{wal_cfg80211_open_wmm::mem safe function err!}");
-        return HI_FAIL;
-    }
-
-    ret = wal_send_cfg_event(netdev, WAL_MSG_TYPE_WRITE, WAL_MSG_WRITE_MSG_HDR_LENGTH + sizeof(hi_u8),
-        (hi_u8 *)&write_msg, HI_FALSE, HI_NULL);
+    ret = wal_post_cfg_event(netdev, WLAN_CFGID_WMM_SWITCH, puc_param, sizeof(hi_u8));
     if (oal_unlikely(ret != HI_SUCCESS)) {
         oam_warning_log1(0, OAM_SF_ANY, "{wal_cfg80211_open_wmm:return err code %d!}\r\n", ret);
         return HI_FAIL;
@@ -743,8 +723,7 @@ hi_u32 wal_parse_wmm_ie(oal_net_device_stru *netdev, mac_vap_stru *mac_vap, oal_
     hi_u8                wmm = HI_TRUE;
     hi_u32               ret = HI_SUCCESS;
 
-    hi_u8                uapsd;
-    wal_msg_write_stru   write_msg;
+    hi_u32               uapsd;
 
     /*  查找wmm_ie  */
     puc_wmm_ie = mac_find_vendor_ie(MAC_WLAN_OUI_MICROSOFT, MAC_WLAN_OUI_TYPE_MICROSOFT_WMM, beacon_info->tail,
@@ -759,19 +738,10 @@ hi_u32 wal_parse_wmm_ie(oal_net_device_stru *netdev, mac_vap_stru *mac_vap, oal_
             oam_warning_log0(mac_vap->vap_id, OAM_SF_CFG, "{wal_parse_wmm_ie::uapsd is disabled!!}");
         }
 
-        /* 填写 msg 消息头 */
-        wal_write_msg_hdr_init(&write_msg, WLAN_CFGID_UAPSD_EN, sizeof(hi_u32));
-        /* 填写 msg 消息体 */
         uapsd = HI_FALSE;
 
-        if (memcpy_s(write_msg.auc_value, sizeof(write_msg.auc_value), &uapsd, sizeof(hi_u32)) != EOK) {
-            oam_error_log0(0, OAM_SF_CFG, "{wal_parse_wmm_ie::mem safe function err!}");
-            return HI_FAIL;
-        }
-
         /* 发送消息 */
-        ret = (hi_u32)wal_send_cfg_event(netdev, WAL_MSG_TYPE_WRITE, WAL_MSG_WRITE_MSG_HDR_LENGTH + sizeof(hi_u32),
-            (hi_u8 *)&write_msg, HI_FALSE, HI_NULL);
+        ret = wal_post_cfg_event(netdev, WLAN_CFGID_UAPSD_EN, &uapsd, sizeof(hi_u32));
         if (oal_unlikely(ret != HI_SUCCESS)) {
             ret = HI_FAIL;
             oam_warning_log1(mac_vap->vap_id, OAM_SF_CFG, "{wal_parse_wmm_ie::uapsd switch set failed[%u].}", ret);
@@ -1803,8 +1773,7 @@ static hi_void wal_cfg80211_stop_p2p_device(oal_wiphy_stru *wiphy, oal_wireless_
 static hi_s32 wal_cfg80211_set_power_mgmt(oal_wiphy_stru *wiphy, oal_net_device_stru *netdev, bool enabled,
     hi_s32 timeout)
 {
-    wal_msg_write_stru           write_msg;
-    mac_cfg_ps_open_stru        *sta_pm_open = HI_NULL;
+    mac_cfg_ps_open_stru         sta_pm_open;
     hi_u32                       ret;
     mac_vap_stru                *mac_vap = HI_NULL;
 
@@ -1813,7 +1782,6 @@ static hi_s32 wal_cfg80211_set_power_mgmt(oal_wiphy_stru *wiphy, oal_net_device_
         return HI_SUCCESS;
     }
 
-    wal_write_msg_hdr_init(&write_msg, WLAN_CFGID_SET_STA_PM_ON, sizeof(mac_cfg_ps_open_stru));
     mac_vap = oal_net_dev_priv(netdev);
     if (oal_unlikely(mac_vap == NULL)) {
         oam_warning_log0(0, OAM_SF_PWR, "{wal_cfg80211_set_power_mgmt::get mac vap failed.}");
@@ -1829,13 +1797,13 @@ static hi_s32 wal_cfg80211_set_power_mgmt(oal_wiphy_stru *wiphy, oal_net_device_
     oam_warning_log3(0, OAM_SF_PWR, "{wal_cfg80211_set_power_mgmt::vap mode[%d]p2p mode[%d]set pm:[%d]}",
         mac_vap->vap_mode, mac_vap->p2p_mode, enabled);
 
-    sta_pm_open = (mac_cfg_ps_open_stru *)(write_msg.auc_value);
+    /* 安全编程规则6.6例外(1) 固定长度的结构体进行内存初始化 */
+    memset_s(&sta_pm_open, sizeof(sta_pm_open), 0, sizeof(sta_pm_open));
     /* MAC_STA_PM_SWITCH_ON / MAC_STA_PM_SWITCH_OFF */
-    sta_pm_open->pm_enable = enabled;
-    sta_pm_open->pm_ctrl_type = MAC_STA_PM_CTRL_TYPE_HOST;
+    sta_pm_open.pm_enable = enabled;
+    sta_pm_open.pm_ctrl_type = MAC_STA_PM_CTRL_TYPE_HOST;
 
-    ret = wal_send_cfg_event(netdev, WAL_MSG_TYPE_WRITE, WAL_MSG_WRITE_MSG_HDR_LENGTH + sizeof(mac_cfg_ps_open_stru),
-        (hi_u8 *)&write_msg, HI_FALSE, HI_NULL);
+    ret = wal_post_cfg_event(netdev, WLAN_CFGID_SET_STA_PM_ON, &sta_pm_open, sizeof(mac_cfg_ps_open_stru));
     if (ret != HI_SUCCESS) {
         oam_warning_log1(0, OAM_SF_ANY, "{wal_cfg80211_set_power_mgmt::fail to send pm cfg msg, error[%u]}", ret);
         return -HI_FAIL;
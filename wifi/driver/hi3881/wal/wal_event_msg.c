@@ -72,7 +72,6 @@ hi_void wal_msg_queue_init(hi_void)
     oal_spin_lock_init(&g_wal_wid_msg_queue.st_lock);
     hi_list_init(&g_wal_wid_msg_queue.head);
     g_wal_wid_msg_queue.count = 0;
-    hi_wait_queue_init_head(&g_wal_wid_msg_queue.wait_queue);
 }
 
 static hi_void _wal_msg_request_add_queue_(wal_msg_request_stru *msg)
@@ -188,6 +187,8 @@ hi_u32 wal_set_msg_response_by_addr(hi_u32 addr, hi_u8 *resp_mem, hi_u32 resp_re
             request->resp_mem = resp_mem;
             request->ret = resp_ret;
             request->resp_len = rsp_len;
+            /* 只唤醒等待该请求的调用者 */
+            OAL_COMPLETE(&request->done);
             ret = HI_SUCCESS;
             break;
         }
@@ -263,40 +264,6 @@ hi_u32 wal_alloc_cfg_event(oal_net_device_stru *netdev, frw_event_mem_stru **eve
     return HI_SUCCESS;
 }
 
-/* ****************************************************************************
- 函 数 名  : wal_request_wait_event_condition
- 功能描述  : 判断wal response 完成条件是否满足
- 输入参数  : wal_msg_request_stru *pst_msg_stru
-
- 输出参数  :
- 返 回 值  : 错误码
- 调用函数  :
- 被调函数  :
-
- 修改历史      :
-  1.日    期   : 2015年11月10日
-    作    者   : HiSilicon
-    修改内容   : 新生成函数
-
-**************************************************************************** */
-static inline hi_u32 wal_request_wait_event_condition(const wal_msg_request_stru *msg_stru)
-{
-    hi_u32 l_ret = HI_FALSE;
-
-    oal_spin_lock_bh(&g_wal_wid_msg_queue.st_lock);
-    if ((msg_stru->resp_mem != NULL) || (msg_stru->ret != HI_SUCCESS)) {
-        l_ret = HI_TRUE;
-    }
-    oal_spin_unlock_bh(&g_wal_wid_msg_queue.st_lock);
-
-    return l_ret;
-}
-
-hi_void wal_cfg_msg_task_sched(hi_void)
-{
-    hi_wait_queue_wake_up(&g_wal_wid_msg_queue.wait_queue);
-}
-
 hi_u32 wal_send_cfg_wait_event(wal_msg_stru **rsp_msg, wal_msg_request_stru *msg_request)
 {
     /* **************************************************************************
@@ -304,9 +271,8 @@ hi_u32 wal_send_cfg_wait_event(wal_msg_stru **rsp_msg, wal_msg_request_stru *msg
     ************************************************************************** */
     wal_wake_lock();
 
-    /* info, boolean argument to function */ /* 使用非wifi目录定义宏函数,误报告警,lin_t e26告警屏蔽 */
-    hi_u32 wal_ret = (hi_u32)hi_wait_event_timeout(g_wal_wid_msg_queue.wait_queue,
-        HI_TRUE == wal_request_wait_event_condition(msg_request), (10 * HZ)); /* 10 频率 */
+    /* 每个请求独立的completion，response到达时只唤醒本请求 */
+    hi_u32 wal_ret = oal_wait_for_completion_timeout(&msg_request->done, (10 * HZ)); /* 10 频率 */
     /* response had been set, remove it from the list */
     wal_msg_request_remove_queue(msg_request);
 
@@ -380,6 +346,7 @@ hi_u32 wal_send_cfg_event(oal_net_device_stru *netdev, wal_msg_type_enum_uint8 m
     /* 规则6.6：禁止使用内存操作类危险函数 例外(1)对固定长度的数组进行初始化，或对固定长度的结构体进行内存初始化 */
     memset_s((&msg_request), sizeof(msg_request), 0, sizeof(msg_request));
     msg_request.request_address = (uintptr_t)&msg_request;
+    OAL_INIT_COMPLETION(&msg_request.done);
 
     if (rsp_msg != NULL) {
         *rsp_msg = NULL;
@@ -427,6 +394,129 @@ hi_u32 wal_send_cfg_event(oal_net_device_stru *netdev, wal_msg_type_enum_uint8 m
     return wal_send_cfg_wait_event(rsp_msg, &msg_request);
 }
 
+/* ****************************************************************************
+ 功能描述  : 发送无需返回的单条WRITE配置消息，直接在事件内存中填写WID，不等待hmac处理结果
+ 输入参数  : netdev: net_device
+             wid:    配置ID
+             value:  配置参数
+             us_len: 配置参数长度
+ 返 回 值  : 事件下发的错误码
+**************************************************************************** */
+hi_u32 wal_post_cfg_event(oal_net_device_stru *netdev, wlan_cfgid_enum_uint16 wid, const hi_void *value,
+    hi_u16 us_len)
+{
+    wal_msg_stru       *cfg_msg = HI_NULL;
+    wal_msg_write_stru *write_msg = HI_NULL;
+    frw_event_mem_stru *event_mem = HI_NULL;
+    hi_u16              us_msg_len = (hi_u16)(WAL_MSG_WRITE_MSG_HDR_LENGTH + us_len);
+
+    if (oal_unlikely((us_len > WAL_MSG_WRITE_MAX_LEN) || ((value == HI_NULL) && (us_len != 0)))) {
+        oam_error_log1(0, OAM_SF_ANY, "{wal_post_cfg_event::invalid param, len[%u]}", us_len);
+        return HI_ERR_CODE_INVALID_CONFIG;
+    }
+
+    if (oal_unlikely(wal_alloc_cfg_event(netdev, &event_mem, HI_NULL, &cfg_msg,
+        WAL_MSG_WRITE_MSG_HDR_LENGTH + us_msg_len) != HI_SUCCESS)) {
+        oam_warning_log0(0, OAM_SF_ANY, "{wal_post_cfg_event::wal_alloc_cfg_event return err!}");
+        return HI_ERR_CODE_PTR_NULL;
+    }
+
+    wal_cfg_msg_hdr_init(&(cfg_msg->msg_hdr), WAL_MSG_TYPE_WRITE, us_msg_len, (hi_u8)wal_get_msg_sn());
+    write_msg = (wal_msg_write_stru *)(cfg_msg->auc_msg_data);
+    wal_write_msg_hdr_init(write_msg, wid, us_len);
+    if ((us_len != 0) && (memcpy_s(write_msg->auc_value, us_len, value, us_len) != EOK)) {
+        oam_error_log0(0, OAM_SF_ANY, "{wal_post_cfg_event::mem safe function err!}");
+        frw_event_free(event_mem);
+        return HI_FAIL;
+    }
+
+    frw_event_dispatch_event(event_mem);
+    frw_event_free(event_mem);
+    return HI_SUCCESS;
+}
+
+/* ****************************************************************************
+ 功能描述  : 初始化批量配置消息
+**************************************************************************** */
+hi_void wal_msg_batch_init(wal_msg_batch_stru *batch)
+{
+    batch->us_len = 0;
+    batch->num = 0;
+}
+
+/* ****************************************************************************
+ 功能描述  : 向批量配置消息中追加一个WID，格式与单条WRITE消息相同，hmac按追加顺序依次处理
+ 输入参数  : batch:  批量消息
+             wid:    配置ID
+             value:  配置参数
+             us_len: 配置参数长度
+ 返 回 值  : HI_SUCCESS 或 空间不足的错误码
+**************************************************************************** */
+hi_u32 wal_msg_batch_add(wal_msg_batch_stru *batch, wlan_cfgid_enum_uint16 wid, const hi_void *value,
+    hi_u16 us_len)
+{
+    wal_msg_write_stru *write_msg = HI_NULL;
+    hi_u32              remain = sizeof(batch->auc_msg) - batch->us_len;
+
+    if (oal_unlikely((batch->num >= WAL_MSG_BATCH_MAX_NUM) || (remain < WAL_MSG_WRITE_MSG_HDR_LENGTH + us_len) ||
+        ((value == HI_NULL) && (us_len != 0)))) {
+        oam_error_log3(0, OAM_SF_ANY, "{wal_msg_batch_add::batch full or invalid, wid[%d] num[%d] len[%d]}",
+            wid, batch->num, us_len);
+        return HI_ERR_CODE_INVALID_CONFIG;
+    }
+
+    write_msg = (wal_msg_write_stru *)(batch->auc_msg + batch->us_len);
+    wal_write_msg_hdr_init(write_msg, wid, us_len);
+    if ((us_len != 0) &&
+        (memcpy_s(write_msg->auc_value, remain - WAL_MSG_WRITE_MSG_HDR_LENGTH, value, us_len) != EOK)) {
+        oam_error_log0(0, OAM_SF_ANY, "{wal_msg_batch_add::mem safe function err!}");
+        return HI_FAIL;
+    }
+
+    batch->us_len += (hi_u16)(WAL_MSG_WRITE_MSG_HDR_LENGTH + us_len);
+    batch->num++;
+    return HI_SUCCESS;
+}
+
+/* ****************************************************************************
+ 功能描述  : 以一个事件下发批量配置消息
+ 输入参数  : netdev:   net_device
+             batch:    批量消息
+             need_rsp: HI_TRUE-等待全部WID处理完成并检查各自错误码(一次等待); HI_FALSE-下发后直接返回
+ 返 回 值  : 第一个失败WID的错误码，全部成功返回HI_SUCCESS
+**************************************************************************** */
+hi_u32 wal_send_cfg_batch(oal_net_device_stru *netdev, const wal_msg_batch_stru *batch, hi_u8 need_rsp)
+{
+    wal_msg_stru           *rsp_msg = HI_NULL;
+    wal_msg_write_rsp_stru *write_rsp = HI_NULL;
+    hi_u32                  ret;
+    hi_u16                  us_idx;
+
+    if (batch->num == 0) {
+        return HI_SUCCESS;
+    }
+
+    ret = wal_send_cfg_event(netdev, WAL_MSG_TYPE_WRITE, batch->us_len, batch->auc_msg, need_rsp,
+        (need_rsp == HI_TRUE) ? &rsp_msg : HI_NULL);
+    if ((ret != HI_SUCCESS) || (rsp_msg == HI_NULL)) {
+        return ret;
+    }
+
+    /* 返回消息为每个WID一个wal_msg_write_rsp_stru，取第一个失败的错误码 */
+    for (us_idx = 0; us_idx + sizeof(wal_msg_write_rsp_stru) <= rsp_msg->msg_hdr.us_msg_len;
+        us_idx += sizeof(wal_msg_write_rsp_stru)) {
+        write_rsp = (wal_msg_write_rsp_stru *)(rsp_msg->auc_msg_data + us_idx);
+        if (write_rsp->err_code != HI_SUCCESS) {
+            oam_warning_log2(0, OAM_SF_ANY, "{wal_send_cfg_batch::wid[%u] err code[%u]}", write_rsp->wid,
+                write_rsp->err_code);
+            ret = (ret == HI_SUCCESS) ? write_rsp->err_code : ret;
+        }
+    }
+
+    oal_free(rsp_msg);
+    return ret;
+}
+
 #ifdef __cplusplus
 #if __cplusplus
 }
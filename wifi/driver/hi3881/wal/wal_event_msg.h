@@ -41,6 +41,8 @@ extern "C" {
 #define WAL_MSG_WID_LENGTH              sizeof(wlan_cfgid_enum_uint16)
 #define WAL_MSG_QUERY_LEN               16
 #define WAL_BW_STR_MAX_LEN              20
+/* 批量配置消息中WID的最大个数，受hmac返回消息长度(HMAC_RSP_MSG_MAX_LEN 64字节)限制: (64 - 4) / 8 */
+#define WAL_MSG_BATCH_MAX_NUM           7
 
 /* 填写配置消息头 */
 #define wal_cfg_msg_hdr_init(_pst_cfg_msg_hdr, _en_type, _us_len, _uc_sn) \
@@ -130,6 +132,7 @@ typedef struct {
     hi_void             *resp_mem;
     hi_u32              resp_len;
     hi_u32              ret;
+    oal_completion      done;           /* response到达时完成，等待者只等待自己的请求 */
 } wal_msg_request_stru;
 
 typedef struct {
@@ -139,10 +142,17 @@ typedef struct {
 typedef struct {
     oal_spin_lock_stru st_lock;
     hi_list head;
-    oal_wait_queue_head_stru wait_queue;
     hi_u32 count;
 } wal_msg_queue;
 
+/* 批量配置消息: 多个WID按WRITE消息格式连续存放，一个事件下发，一次等待 */
+typedef struct {
+    hi_u16 us_len;                                /* 已打包的消息总长度 */
+    hi_u8  num;                                   /* 已打包的WID个数 */
+    hi_u8  resv;
+    hi_u8  auc_msg[sizeof(wal_msg_write_stru)];   /* 与单条最大WRITE消息等长 */
+} wal_msg_batch_stru;
+
 #ifdef __cplusplus
 #if __cplusplus
 }
@@ -151,7 +161,12 @@ typedef struct {
 
 hi_u32 wal_check_and_release_msg_resp(wal_msg_stru *rsp_msg);
 hi_void wal_msg_queue_init(hi_void);
-hi_void wal_cfg_msg_task_sched(hi_void);
 hi_u32 wal_set_msg_response_by_addr(hi_u32 addr, hi_u8 *resp_mem, hi_u32 resp_ret, hi_u32 rsp_len);
+hi_u32 wal_post_cfg_event(oal_net_device_stru *netdev, wlan_cfgid_enum_uint16 wid, const hi_void *value,
+    hi_u16 us_len);
+hi_void wal_msg_batch_init(wal_msg_batch_stru *batch);
+hi_u32 wal_msg_batch_add(wal_msg_batch_stru *batch, wlan_cfgid_enum_uint16 wid, const hi_void *value,
+    hi_u16 us_len);
+hi_u32 wal_send_cfg_batch(oal_net_device_stru *netdev, const wal_msg_batch_stru *batch, hi_u8 need_rsp);
 
 #endif /* end of wal_event_msg.h */
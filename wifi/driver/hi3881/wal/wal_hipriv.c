@@ -42,6 +42,7 @@
 #include "lwip/netifapi.h"
 #endif
 #include "plat_firmware.h"
+#include "exception_rst.h"
 
 #ifdef __cplusplus
 #if __cplusplus
@@ -395,6 +396,41 @@ hi_void set_under_mfg(hi_u32 under_mfg)
 {
     g_under_mfg = under_mfg;
 }
+#if defined(_PRE_WLAN_FEATURE_HIPRIV) || defined(_PRE_WLAN_FEATURE_SIGMA)
+/* ****************************************************************************
+ 功能描述  : hipriv命令参数单趟切分，按空格分隔依次拷贝到argv[i]，每个缓冲区WAL_HIPRIV_CMD_NAME_MAX_LEN字节
+ 输入参数  : pc_param, 配置命令的参数字符串
+             argc, 需要解析的参数个数
+ 输出参数  : argv, 解析出的参数
+**************************************************************************** */
+static hi_u32 wal_hipriv_split_args(const hi_char *pc_param, hi_char * const argv[], hi_u32 argc)
+{
+    const hi_char *pc_pos = pc_param;
+    hi_u32 idx;
+    hi_u32 len;
+
+    for (idx = 0; idx < argc; idx++) {
+        /* 去掉参数前的空格 */
+        while (*pc_pos == ' ') {
+            ++pc_pos;
+        }
+        for (len = 0; (*pc_pos != ' ') && (*pc_pos != '\0'); len++, pc_pos++) {
+            if (oal_unlikely(len + 1 >= WAL_HIPRIV_CMD_NAME_MAX_LEN)) {
+                oam_warning_log1(0, OAM_SF_ANY, "{wal_hipriv_split_args::param[%u] too long!}", idx + 1);
+                return HI_ERR_CODE_ARRAY_OVERFLOW;
+            }
+            argv[idx][len] = *pc_pos;
+        }
+        argv[idx][len] = '\0';
+        if (len == 0) {
+            oam_warning_log1(0, OAM_SF_ANY, "{wal_hipriv_split_args::get param[%u] failed!}", idx + 1);
+            return HI_ERR_CODE_PTR_NULL;
+        }
+    }
+    return HI_SUCCESS;
+}
+#endif
+
 #ifdef _PRE_WLAN_FEATURE_HIPRIV
 /* ****************************************************************************
  功能描述  : hipriv命令2个参数解析函数
@@ -403,23 +439,9 @@ hi_void set_under_mfg(hi_u32 under_mfg)
 **************************************************************************** */
 static hi_u32 wal_hipriv_two_param_parse(hi_char *pc_param, wal_hipriv_two_param_stru *out_param)
 {
-    hi_u32 ret;
-    hi_u32 off_set = 0;
-    /* 获取第一个参数 */
-    ret = wal_get_cmd_one_arg(pc_param, out_param->cmd_param1, WAL_HIPRIV_CMD_NAME_MAX_LEN, &off_set);
-    if (ret != HI_SUCCESS) {
-        oam_warning_log0(0, OAM_SF_ANY, "{wal_hipriv_two_param_parse::get first param failed!}");
-        return ret;
-    }
-    /* 偏移，取下一个参数 */
-    pc_param = pc_param + off_set;
-    /* 获取第二个参数 */
-    ret = wal_get_cmd_one_arg(pc_param, out_param->cmd_param2, WAL_HIPRIV_CMD_NAME_MAX_LEN, &off_set);
-    if (ret != HI_SUCCESS) {
-        oam_warning_log0(0, OAM_SF_ANY, "{wal_hipriv_two_param_parse::get second param failed!}");
-        return ret;
-    }
-    return HI_SUCCESS;
+    hi_char * const argv[] = {out_param->cmd_param1, out_param->cmd_param2};
+
+    return wal_hipriv_split_args(pc_param, argv, hi_array_size(argv));
 }
 #endif
 
@@ -431,30 +453,9 @@ static hi_u32 wal_hipriv_two_param_parse(hi_char *pc_param, wal_hipriv_two_param
 **************************************************************************** */
 static hi_u32 wal_hipriv_three_param_parse(hi_char *pc_param, wal_hipriv_three_param_stru *out_param)
 {
-    hi_u32 ret;
-    hi_u32 off_set = 0;
-    /* 获取第一个参数 */
-    ret = wal_get_cmd_one_arg(pc_param, out_param->cmd_param1, WAL_HIPRIV_CMD_NAME_MAX_LEN, &off_set);
-    if (ret != HI_SUCCESS) {
-        oam_warning_log0(0, OAM_SF_ANY, "{wal_hipriv_three_param_parse::get first param failed!}");
-        return ret;
-    }
-    /* 偏移，取下一个参数 */
-    pc_param = pc_param + off_set;
-    /* 获取第二个参数 */
-    ret = wal_get_cmd_one_arg(pc_param, out_param->cmd_param2, WAL_HIPRIV_CMD_NAME_MAX_LEN, &off_set);
-    if (ret != HI_SUCCESS) {
-        oam_warning_log0(0, OAM_SF_ANY, "{wal_hipriv_three_param_parse::get second param failed!}");
-        return ret;
-    }
-    pc_param = pc_param + off_set;
-    /* 获取第三个参数 */
-    ret = wal_get_cmd_one_arg(pc_param, out_param->cmd_param3, WAL_HIPRIV_CMD_NAME_MAX_LEN, &off_set);
-    if (ret != HI_SUCCESS) {
-        oam_warning_log0(0, OAM_SF_ANY, "{wal_hipriv_three_param_parse::get third param failed!}");
-        return ret;
-    }
-    return HI_SUCCESS;
+    hi_char * const argv[] = {out_param->cmd_param1, out_param->cmd_param2, out_param->cmd_param3};
+
+    return wal_hipriv_split_args(pc_param, argv, hi_array_size(argv));
 }
 #endif
 
@@ -466,37 +467,11 @@ static hi_u32 wal_hipriv_three_param_parse(hi_char *pc_param, wal_hipriv_three_p
 **************************************************************************** */
 static hi_u32 wal_hipriv_four_param_parse(hi_char *pc_param, wal_hipriv_four_param_stru *out_param)
 {
-    hi_u32 ret;
-    hi_u32 off_set = 0;
-    /* 获取第一个参数 */
-    ret = wal_get_cmd_one_arg(pc_param, out_param->cmd_param1, WAL_HIPRIV_CMD_NAME_MAX_LEN, &off_set);
-    if (ret != HI_SUCCESS) {
-        oam_warning_log0(0, OAM_SF_ANY, "{wal_hipriv_four_param_parse::get first param failed!}");
-        return ret;
-    }
-    /* 偏移，取下一个参数 */
-    pc_param = pc_param + off_set;
-    /* 获取第二个参数 */
-    ret = wal_get_cmd_one_arg(pc_param, out_param->cmd_param2, WAL_HIPRIV_CMD_NAME_MAX_LEN, &off_set);
-    if (ret != HI_SUCCESS) {
-        oam_warning_log0(0, OAM_SF_ANY, "{wal_hipriv_four_param_parse::get second param failed!}");
-        return ret;
-    }
-    pc_param = pc_param + off_set;
-    /* 获取第三个参数 */
-    ret = wal_get_cmd_one_arg(pc_param, out_param->cmd_param3, WAL_HIPRIV_CMD_NAME_MAX_LEN, &off_set);
-    if (ret != HI_SUCCESS) {
-        oam_warning_log0(0, OAM_SF_ANY, "{wal_hipriv_four_param_parse::get third param failed!}");
-        return ret;
-    }
-    pc_param = pc_param + off_set;
-    /* 获取第四个参数 */
-    ret = wal_get_cmd_one_arg(pc_param, out_param->cmd_param4, WAL_HIPRIV_CMD_NAME_MAX_LEN, &off_set);
-    if (ret != HI_SUCCESS) {
-        oam_warning_log0(0, OAM_SF_ANY, "{wal_hipriv_four_param_parse::get fouth param failed!}");
-        return ret;
-    }
-    return HI_SUCCESS;
+    hi_char * const argv[] = {
+        out_param->cmd_param1, out_param->cmd_param2, out_param->cmd_param3, out_param->cmd_param4
+    };
+
+    return wal_hipriv_split_args(pc_param, argv, hi_array_size(argv));
 }
 #endif
 
@@ -4146,6 +4121,108 @@ static hi_u32 wal_hipriv_set_edca_opt_cycle_ap(oal_net_device_stru *netdev, hi_c
 #endif
 #endif
 
+#if defined(_PRE_WLAN_FEATURE_M2U) && defined(_PRE_WLAN_FEATURE_HIPRIV)
+/* ****************************************************************************
+ 功能描述  : 设置组播侦听及转单播参数: m2u_snoop_on [0|1] [max_member]
+             两个参数均必须携带, max_member取值范围1~HMAC_M2U_MEMBER_MAX_NUM
+**************************************************************************** */
+static hi_u32 wal_hipriv_m2u_snoop_on(oal_net_device_stru *netdev, hi_char *pc_param)
+{
+    wal_msg_write_stru              write_msg;
+    hi_u32                          off_set;
+    hi_char                         ac_name[WAL_HIPRIV_CMD_NAME_MAX_LEN] = {0};
+    mac_cfg_m2u_snoop_on_param_stru m2u_param = {0};
+    hi_u32                          ret;
+
+    /* 安全编程规则6.6例外(1) 固定长度的结构体进行内存初始化 */
+    memset_s((hi_u8 *)&write_msg, sizeof(wal_msg_write_stru), 0, sizeof(wal_msg_write_stru));
+
+    ret = wal_get_cmd_one_arg(pc_param, ac_name, WAL_HIPRIV_CMD_NAME_MAX_LEN, &off_set);
+    if (ret != HI_SUCCESS) {
+        oam_warning_log1(0, OAM_SF_M2U, "{wal_hipriv_m2u_snoop_on::get switch error[%u]!}\r\n", ret);
+        return ret;
+    }
+    pc_param += off_set;
+
+    m2u_param.m2u_snoop_on = (hi_u8)oal_atoi(ac_name);
+    if (m2u_param.m2u_snoop_on > HI_SWITCH_ON) {
+        oam_warning_log1(0, OAM_SF_M2U, "{wal_hipriv_m2u_snoop_on::switch err[%d]!}\r\n", m2u_param.m2u_snoop_on);
+        return HI_FAIL;
+    }
+
+    /* 获取转单播成员数门限 */
+    ret = wal_get_cmd_one_arg(pc_param, ac_name, WAL_HIPRIV_CMD_NAME_MAX_LEN, &off_set);
+    if (ret != HI_SUCCESS) {
+        oam_warning_log1(0, OAM_SF_M2U, "{wal_hipriv_m2u_snoop_on::get max_member error[%u]!}\r\n", ret);
+        return ret;
+    }
+    m2u_param.max_member = (hi_u8)oal_atoi(ac_name);
+    if ((m2u_param.max_member == 0) || (m2u_param.max_member > HMAC_M2U_MEMBER_MAX_NUM)) {
+        oam_warning_log1(0, OAM_SF_M2U, "{wal_hipriv_m2u_snoop_on::max_member err[%d]!}\r\n",
+            m2u_param.max_member);
+        return HI_FAIL;
+    }
+
+    /* **************************************************************************
+                             抛事件到wal层处理
+    ************************************************************************** */
+    wal_write_msg_hdr_init(&write_msg, WLAN_CFGID_M2U_SNOOP_ON, sizeof(m2u_param));
+    if (memcpy_s(write_msg.auc_value, WAL_MSG_WRITE_MAX_LEN, &m2u_param, sizeof(m2u_param)) != EOK) {
+        oam_error_log0(0, OAM_SF_M2U, "{wal_hipriv_m2u_snoop_on::mem safe function err!}");
+        return HI_FAIL;
+    }
+
+    ret = wal_send_cfg_event(netdev, WAL_MSG_TYPE_WRITE, WAL_MSG_WRITE_MSG_HDR_LENGTH + sizeof(m2u_param),
+        (hi_u8 *)&write_msg, HI_FALSE, HI_NULL);
+    if (oal_unlikely(ret != HI_SUCCESS)) {
+        oam_warning_log1(0, OAM_SF_M2U, "{wal_hipriv_m2u_snoop_on::send event return err code [%u]!}\r\n", ret);
+        return ret;
+    }
+
+    return HI_SUCCESS;
+}
+#endif
+
+#ifdef _PRE_WLAN_FEATURE_HIPRIV
+/* ****************************************************************************
+ 功能描述  : 开关device异常分级恢复: dfr_enable [0|1]
+**************************************************************************** */
+static hi_u32 wal_hipriv_dfr_enable(oal_net_device_stru *netdev, hi_char *pc_param)
+{
+    hi_u32  off_set;
+    hi_char ac_name[WAL_HIPRIV_CMD_NAME_MAX_LEN] = {0};
+    hi_u32  enable;
+
+    hi_unref_param(netdev);
+    hi_u32 ret = wal_get_cmd_one_arg(pc_param, ac_name, WAL_HIPRIV_CMD_NAME_MAX_LEN, &off_set);
+    if (ret != HI_SUCCESS) {
+        oam_warning_log1(0, OAM_SF_ANY, "{wal_hipriv_dfr_enable::get switch error[%u]!}\r\n", ret);
+        return ret;
+    }
+
+    enable = (hi_u32)oal_atoi(ac_name);
+    if (enable > HI_SWITCH_ON) {
+        oam_warning_log1(0, OAM_SF_ANY, "{wal_hipriv_dfr_enable::switch err[%u]!}\r\n", enable);
+        return HI_FAIL;
+    }
+
+    plat_dfr_cfg_set(enable);
+    return HI_SUCCESS;
+}
+
+/* ****************************************************************************
+ 功能描述  : 打印device异常分级恢复统计: dfr_info
+**************************************************************************** */
+static hi_u32 wal_hipriv_dfr_info(oal_net_device_stru *netdev, hi_char *pc_param)
+{
+    hi_unref_param(netdev);
+    hi_unref_param(pc_param);
+
+    plat_exception_recovery_stats_dump();
+    return HI_SUCCESS;
+}
+#endif
+
 #ifdef _PRE_WLAN_FEATURE_HIPRIV
 /* ****************************************************************************
  功能描述  :  设置VAP mib
@@ -6174,6 +6251,8 @@ static const wal_hipriv_cmd_entry_stru  g_ast_hipriv_cmd[] = {
 #endif
 #ifdef _PRE_WLAN_FEATURE_HIPRIV
     {"set_cca_threshold", wal_hipriv_set_cca_threshold},       /* 设置CCA门限: */
+    {"dfr_enable",      wal_hipriv_dfr_enable},         /* 开关device异常分级恢复: dfr_enable [0|1] */
+    {"dfr_info",        wal_hipriv_dfr_info},           /* 打印异常恢复次数、成功率及耗时统计: dfr_info */
 #ifdef _PRE_WLAN_FEATURE_STA_PM
     {"set_psm_offset",  wal_hipriv_sta_set_psm_offset}, /* 配置tbtt、ext tbtt 提前量和beacon超时时间 */
     {"set_hw_ps_mode",  wal_hipriv_sta_set_hw_ps_mode}, /* 可配置硬件深睡和浅睡模式 */
@@ -6191,6 +6270,9 @@ static const wal_hipriv_cmd_entry_stru  g_ast_hipriv_cmd[] = {
     {"edca_switch_ap",  wal_hipriv_set_edca_opt_switch_ap},     /* 是否开启edca优化机制 */
     {"edca_cycle_ap",   wal_hipriv_set_edca_opt_cycle_ap},      /* 设置edca参数调整的周期 */
 #endif
+#ifdef _PRE_WLAN_FEATURE_M2U
+    {"m2u_snoop_on",    wal_hipriv_m2u_snoop_on},   /* 设置组播转单播: m2u_snoop_on [0|1] [max_member], 参数均必填 */
+#endif
 #ifdef _PRE_WLAN_FEATURE_MESH
     {"set_times_limit", wal_hipriv_set_report_times_limit},     /* 设置发送次数上报相关参数(联调调试使用) */
     {"set_cnt_limit",   wal_hipriv_set_report_cnt_limit},       /* 设置发送上报相关参数(联调调试使用) */
@@ -6286,6 +6368,55 @@ hi_u32 wal_hipriv_get_netdev(const hi_char *pc_cmd, oal_net_device_stru **netdev
 }
 
 #if defined(_PRE_WLAN_FEATURE_HIPRIV) || defined(_PRE_WLAN_FEATURE_SIGMA)
+/* g_ast_hipriv_cmd按命令名升序排列的下标，由wal_hipriv_cmd_index_init生成 */
+static hi_u8 g_auc_hipriv_cmd_sorted[hi_array_size(g_ast_hipriv_cmd)];
+
+/* ****************************************************************************
+ 功能描述  : 生成hipriv命令名的有序索引。命令表按特性宏分组、无法在源码中保持有序，
+             初始化时做一次插入排序，命令分发时二分查找
+**************************************************************************** */
+hi_void wal_hipriv_cmd_index_init(hi_void)
+{
+    hi_u8 idx;
+    hi_u8 pos;
+
+    for (idx = 0; idx < hi_array_size(g_ast_hipriv_cmd); idx++) {
+        for (pos = idx; (pos > 0) && (strcmp(g_ast_hipriv_cmd[g_auc_hipriv_cmd_sorted[pos - 1]].pc_cmd_name,
+            g_ast_hipriv_cmd[idx].pc_cmd_name) > 0); pos--) {
+            g_auc_hipriv_cmd_sorted[pos] = g_auc_hipriv_cmd_sorted[pos - 1];
+        }
+        g_auc_hipriv_cmd_sorted[pos] = idx;
+    }
+}
+
+/* ****************************************************************************
+ 功能描述  : 在有序索引中二分查找命令
+ 输入参数  : pc_cmd_name: 命令名
+ 返 回 值  : 命令表项，未找到返回HI_NULL
+**************************************************************************** */
+static const wal_hipriv_cmd_entry_stru *wal_hipriv_find_cmd(const hi_char *pc_cmd_name)
+{
+    const wal_hipriv_cmd_entry_stru *cmd_entry = HI_NULL;
+    hi_s32 low = 0;
+    hi_s32 high = (hi_s32)hi_array_size(g_ast_hipriv_cmd) - 1;
+    hi_s32 mid;
+    hi_s32 cmp;
+
+    while (low <= high) {
+        mid = low + ((high - low) >> 1);
+        cmd_entry = &g_ast_hipriv_cmd[g_auc_hipriv_cmd_sorted[mid]];
+        cmp = strcmp(cmd_entry->pc_cmd_name, pc_cmd_name);
+        if (cmp == 0) {
+            return cmd_entry;
+        } else if (cmp < 0) {
+            low = mid + 1;
+        } else {
+            high = mid - 1;
+        }
+    }
+    return HI_NULL;
+}
+
 /* ****************************************************************************
  功能描述  : 处理私有配置命令
  输入参数  : pc_cmd: 命令
@@ -6293,6 +6424,7 @@ hi_u32 wal_hipriv_get_netdev(const hi_char *pc_cmd, oal_net_device_stru **netdev
 **************************************************************************** */
 static hi_u32 wal_hipriv_process_cmd(oal_net_device_stru *netdev, hi_char *pc_cmd)
 {
+    const wal_hipriv_cmd_entry_stru *cmd_entry = HI_NULL;
     hi_u8    cmd;
     hi_u32   off_set = 0;
     hi_u32   ret;
@@ -6308,25 +6440,24 @@ static hi_u32 wal_hipriv_process_cmd(oal_net_device_stru *netdev, hi_char *pc_cm
         return HI_FAIL;
     }
 
-    /* 根据命令名找到命令枚举 */
-    for (cmd = 0; cmd < hi_array_size(g_ast_hipriv_cmd); cmd++) {
-        if (strcmp(g_ast_hipriv_cmd[cmd].pc_cmd_name, ac_cmd_name) == 0) {
-            pc_cmd += off_set;
-            ret = g_ast_hipriv_cmd[cmd].func(netdev, pc_cmd);
-            if (ret != HI_SUCCESS) {
-                oam_warning_log1(0, OAM_SF_ANY, "{cmd func process failed, ret=%u}", ret);
+    /* 根据命令名找到命令 */
+    cmd_entry = wal_hipriv_find_cmd(ac_cmd_name);
+    if (cmd_entry != HI_NULL) {
+        pc_cmd += off_set;
+        ret = cmd_entry->func(netdev, pc_cmd);
+        if (ret != HI_SUCCESS) {
+            oam_warning_log1(0, OAM_SF_ANY, "{cmd func process failed, ret=%u}", ret);
 #ifdef _PRE_WLAN_FEATURE_MFG_TEST
-                printk("ERROR\r\n");
+            printk("ERROR\r\n");
 #endif
-            }
-            return ret;
         }
+        return ret;
     }
 
     if (strcmp(ac_cmd_name, "help") == 0) {
         oam_print("hipriv commands:\n");
         for (cmd = 0; cmd < hi_array_size(g_ast_hipriv_cmd); cmd++) {
-            oam_print(" %s\n", g_ast_hipriv_cmd[cmd].pc_cmd_name);
+            oam_print(" %s\n", g_ast_hipriv_cmd[g_auc_hipriv_cmd_sorted[cmd]].pc_cmd_name);
         }
         return HI_SUCCESS;
     }
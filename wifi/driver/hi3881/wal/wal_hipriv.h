@@ -200,6 +200,7 @@ hi_u32 wal_hipriv_addba_req(oal_net_device_stru *netdev, hi_char *pc_param);
 #endif
 #if defined(_PRE_WLAN_FEATURE_HIPRIV) || defined(_PRE_WLAN_FEATURE_SIGMA)
 hi_u32 wal_hipriv_entry(const hi_char *pc_buffer, hi_u32 count);
+hi_void wal_hipriv_cmd_index_init(hi_void);
 #endif
 hi_u32 wal_hipriv_tx_proc(oal_net_device_stru *netdev, hi_char *pc_param);
 hi_u32 wal_hipriv_rx_proc(oal_net_device_stru *netdev, hi_char *pc_param);
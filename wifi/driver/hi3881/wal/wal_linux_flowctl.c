@@ -21,6 +21,7 @@
 **************************************************************************** */
 #include "oal_ext_if.h"
 #include "hmac_ext_if.h"
+#include "wal_linux_flowctl.h"
 
 #ifdef __cplusplus
 #if __cplusplus
@@ -36,6 +37,28 @@ extern "C" {
 /* ****************************************************************************
   3 函数实现
 **************************************************************************** */
+/* ****************************************************************************
+ 功能描述  : 获取报文所属的AC，优先复用协议栈已缓存在netbuf上的分类结果，
+             仅在没有分类结果时解析一次IPv4 TOS
+**************************************************************************** */
+static hi_u8 wal_netdev_get_subq_ac(oal_netbuf_stru *netbuf, const oal_ether_header_stru *ether_header)
+{
+    hi_u32 buf_prio = oal_netbuf_priority(netbuf);
+    hi_u8  tid;
+
+    if ((buf_prio != 0) && (buf_prio < WLAN_TID_MAX_NUM)) {
+        return wlan_wme_tid_to_ac(buf_prio);
+    }
+
+    if (ether_header->us_ether_type != oal_host2net_short(ETHER_TYPE_IP)) {
+        return WLAN_WME_AC_BE;
+    }
+
+    /* 偏移一个以太网头，取ip头的tos高3位 */
+    tid = ((const mac_ip_header_stru *)(ether_header + 1))->tos >> WLAN_IP_PRI_SHIFT;
+    return wlan_wme_tid_to_ac(tid);
+}
+
 /* ****************************************************************************
  函 数 名  : wal_netdev_select_queue
  功能描述  : kernel给skb选择合适的tx subqueue;
@@ -51,26 +74,22 @@ extern "C" {
     修改内容   : 新生成函数
 
 **************************************************************************** */
-hi_u16 wal_netdev_select_queue(oal_net_device_stru *netdev, oal_netbuf_stru *netbuf, hi_void *accel_priv,
-    select_queue_fallback_t fallback)
+hi_u16 wal_netdev_select_queue(oal_net_device_stru *netdev, oal_netbuf_stru *netbuf)
 {
     oal_ether_header_stru   *ether_header   = HI_NULL;
     mac_vap_stru            *mac_vap            = HI_NULL;
     hi_u8                assoc_id        = 0;
-    hi_u8                tos             = 0;
-    hi_u8                ac;
     hi_u16               us_subq;
     hi_u32               ret;
 
-    /* 获取以太网头 */
-    ether_header = (oal_ether_header_stru *)oal_netbuf_data(netbuf);
-
     mac_vap = (mac_vap_stru *)oal_net_dev_priv(netdev);
     /* 没有用户限速，则全部入index = 0 的subq, 并直接返回 */
     if (mac_vap->has_user_bw_limit == HI_FALSE) {
         return 0;
     }
 
+    /* 获取以太网头 */
+    ether_header = (oal_ether_header_stru *)oal_netbuf_data(netbuf);
     ret = mac_vap_find_user_by_macaddr(mac_vap, ether_header->auc_ether_dhost, ETHER_ADDR_LEN, &assoc_id);
     if (ret != HI_SUCCESS) {
         /* 没有找到用户的报文，均统一放入subq = 0的队列中 */
@@ -78,19 +97,36 @@ hi_u16 wal_netdev_select_queue(oal_net_device_stru *netdev, oal_netbuf_stru *net
         return 0;
     }
 
-    /* 获取skb的tos字段 */
-    oal_netbuf_get_txtid(netbuf, &tos);
-
-    /* 根据tos字段选择合适的队列 */
-    ac = mac_tos_to_subq(tos);
-
-    us_subq = (hi_u16)((assoc_id * WAL_NETDEV_SUBQUEUE_PER_USE) + ac);
+    us_subq = wal_flowctl_subq_idx(assoc_id, wal_netdev_get_subq_ac(netbuf, ether_header));
     if (us_subq >= WAL_NETDEV_SUBQUEUE_MAX_NUM) {
         return 0;
     }
     return us_subq;
 }
 
+/* ****************************************************************************
+ 功能描述  : stop或者wake指定的subqueue
+**************************************************************************** */
+static hi_void wal_flowctl_operate_subq(oal_net_device_stru *netdev, hi_u16 us_subq, hi_u8 is_stop)
+{
+    if (us_subq >= WAL_NETDEV_SUBQUEUE_MAX_NUM) {
+        return;
+    }
+#if (_PRE_OS_VERSION_LINUX == _PRE_OS_VERSION)
+    if (is_stop == 1) {
+        oal_net_stop_subqueue(netdev, us_subq);
+    } else {
+        oal_net_wake_subqueue(netdev, us_subq);
+    }
+#else
+    if (is_stop == 1) {
+        oal_net_stop_subqueue(netdev);
+    } else {
+        oal_net_wake_subqueue(netdev);
+    }
+#endif
+}
+
 /* ****************************************************************************
  函 数 名  : wal_flowctl_backp_event_handler
  功能描述  : stop或者wake某个用户的某个subqueue
@@ -122,43 +158,35 @@ hi_u32 wal_flowctl_backp_event_handler(frw_event_mem_stru *event_mem)
     /* 如果对整个VAP stop或者wake */
     if (flowctl_backp_event->us_assoc_id == 0xFFFF) {
         if (flowctl_backp_event->is_stop == 1) {
-            oal_net_tx_stop_all_queues(netdev);
+            oal_net_tx_stop_all_queues();
         } else {
             oal_net_tx_wake_all_queues();
         }
         oam_info_log3(vap_id, OAM_SF_ANY,
-            "{wal_flowctl_backp_event_handler::oal_net_tx_queues,stop_flag=%d,vap_id=%d,assoc_id=%d,tid=%d}",
-            flowctl_backp_event->is_stop, flowctl_backp_event->vap_id, flowctl_backp_event->us_assoc_id,
-            flowctl_backp_event->tidno);
+            "{wal_flowctl_backp_event_handler::oal_net_tx_queues,stop_flag=%d,assoc_id=%d,tid=%d}",
+            flowctl_backp_event->is_stop, flowctl_backp_event->us_assoc_id, flowctl_backp_event->tidno);
 
         return HI_SUCCESS;
     }
 
-    /* 如果对某个user stop或者wake */
+    /* 如果对某个user的全部AC stop或者wake */
     if (flowctl_backp_event->tidno == WLAN_TID_MAX_NUM) {
-        for (hi_u8 ac = 0; ac <= MAC_LINUX_SUBQ_VO; ac++) {
-            if (flowctl_backp_event->is_stop == 1) {
-                oal_net_stop_subqueue(netdev);
-            } else {
-                oal_net_wake_subqueue(netdev);
-            }
-            oam_info_log3(vap_id, OAM_SF_ANY,
-                "{wal_flowctl_backp_event_handler::oal_net_subqueue,stop=%d,vap_id=%d,assoc_id=%d,tid=%d}",
-                flowctl_backp_event->is_stop, flowctl_backp_event->vap_id, flowctl_backp_event->us_assoc_id,
-                flowctl_backp_event->tidno);
+        for (hi_u8 ac = 0; ac < WLAN_WME_AC_BUTT; ac++) {
+            wal_flowctl_operate_subq(netdev, wal_flowctl_subq_idx(flowctl_backp_event->us_assoc_id, ac),
+                flowctl_backp_event->is_stop);
         }
+        oam_info_log3(vap_id, OAM_SF_ANY,
+            "{wal_flowctl_backp_event_handler::oal_net_subqueue,stop=%d,assoc_id=%d,tid=%d}",
+            flowctl_backp_event->is_stop, flowctl_backp_event->us_assoc_id, flowctl_backp_event->tidno);
         return HI_SUCCESS;
     }
 
-    if (flowctl_backp_event->is_stop == 1) {
-        oal_net_stop_subqueue(netdev);
-    } else {
-        oal_net_wake_subqueue(netdev);
-    }
+    /* 只反压该tid所属AC的subqueue，其他AC不受影响 */
+    wal_flowctl_operate_subq(netdev, wal_flowctl_subq_idx(flowctl_backp_event->us_assoc_id,
+        wlan_wme_tid_to_ac(flowctl_backp_event->tidno)), flowctl_backp_event->is_stop);
     oam_info_log3(vap_id, OAM_SF_ANY,
-        "{wal_flowctl_backp_event_handler::oal_net_subqueue,stop_flag=%d,vap_id=%d,assoc_id=%d,tid=%d}",
-        flowctl_backp_event->is_stop, flowctl_backp_event->vap_id, flowctl_backp_event->us_assoc_id,
-        flowctl_backp_event->tidno);
+        "{wal_flowctl_backp_event_handler::oal_net_subqueue,stop_flag=%d,assoc_id=%d,tid=%d}",
+        flowctl_backp_event->is_stop, flowctl_backp_event->us_assoc_id, flowctl_backp_event->tidno);
 
     return HI_SUCCESS;
 }
@@ -180,8 +208,7 @@ hi_u32 wal_flowctl_backp_event_handler(frw_event_mem_stru *event_mem)
     修改内容   : 新生成函数
 
 **************************************************************************** */
-hi_u16 wal_netdev_select_queue(oal_net_device_stru *netdev, oal_netbuf_stru *netbuf, hi_void *accel_priv,
-    select_queue_fallback_t fallback)
+hi_u16 wal_netdev_select_queue(oal_net_device_stru *netdev, oal_netbuf_stru *netbuf)
 {
     return oal_netbuf_select_queue(netbuf);
 }
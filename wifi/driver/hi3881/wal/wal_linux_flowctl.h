@@ -38,6 +38,8 @@ extern "C" {
 #define WAL_NETDEV_USER_MAX_NUM (WLAN_ACTIVE_USER_MAX_NUM + 4)
 #define WAL_NETDEV_SUBQUEUE_PER_USE 4
 #define WAL_NETDEV_SUBQUEUE_MAX_NUM ((WAL_NETDEV_USER_MAX_NUM) * (WAL_NETDEV_SUBQUEUE_PER_USE))
+/* 每个用户按AC占用WAL_NETDEV_SUBQUEUE_PER_USE个subqueue */
+#define wal_flowctl_subq_idx(assoc_id, ac) ((hi_u16)(((assoc_id) * WAL_NETDEV_SUBQUEUE_PER_USE) + (ac)))
 
 /* ****************************************************************************
   3 枚举定义
@@ -58,6 +60,15 @@ typedef struct {
     hi_u8 auc_mac_addr[OAL_MAC_ADDR_LEN];
 } wal_macaddr_subq_stru;
 
+/* HMAC_HOST_CTX_EVENT_SUB_TYPE_FLOWCTL_BACKP事件携带的反压信息 */
+typedef struct {
+    hi_u8  vap_id;
+    hi_u8  is_stop;         /* 1: stop, 0: wake */
+    hi_u16 us_assoc_id;     /* 0xFFFF表示整个VAP */
+    hi_u8  tidno;           /* WLAN_TID_MAX_NUM表示该用户的全部AC */
+    hi_u8  auc_resv[3];     /* 3 byte保留字段 */
+} mac_ioctl_queue_backp_stru;
+
 /* ****************************************************************************
   8 UNION定义
 **************************************************************************** */
@@ -67,15 +78,14 @@ typedef struct {
 /* ****************************************************************************
   10 函数声明
 **************************************************************************** */
-hi_u16 wal_netdev_select_queue(oal_net_device_stru *netdev, oal_netbuf_stru *netbuf);
 hi_u32 wal_flowctl_backp_event_handler(frw_event_mem_stru *event_mem);
 
 #endif /* endif for _PRE_WLAN_FEATURE_FLOWCTL */
 
-#ifdef _PRE_WLAN_FEATURE_OFFLOAD_FLOWCTL
-hi_u16 wal_netdev_select_queue(oal_net_device_stru *netdev, oal_netbuf_stru *netbuf, hi_void *accel_priv,
-    select_queue_fallback_t fallback);
-#endif /* end if for _PRE_WLAN_FEATURE_OFFLOAD_FLOWCTL */
+#if defined(_PRE_WLAN_FEATURE_FLOWCTL) || defined(_PRE_WLAN_FEATURE_OFFLOAD_FLOWCTL)
+/* 挂接到net_device_ops的selectQueue */
+hi_u16 wal_netdev_select_queue(oal_net_device_stru *netdev, oal_netbuf_stru *netbuf);
+#endif
 
 #ifdef __cplusplus
 #if __cplusplus
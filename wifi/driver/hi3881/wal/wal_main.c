@@ -154,6 +154,9 @@ hi_u32 wal_main_init(hi_void)
 
     wal_event_fsm_init();
     wal_init_dev_addr();
+#if defined(_PRE_WLAN_FEATURE_HIPRIV) || defined(_PRE_WLAN_FEATURE_SIGMA)
+    wal_hipriv_cmd_index_init();
+#endif
 
 #ifdef _PRE_CONFIG_CONN_HISI_SYSFS_SUPPORT
     /* 创建proc */
@@ -192,8 +195,8 @@ hi_void wal_destroy_all_vap(hi_void)
     oal_net_device_stru* netdev = HI_NULL;
     hi_u8                vap_id = WLAN_SERVICE_VAP_START_ID;
 
-    /* 删除业务vap之前处理frw中事件 */
-    frw_event_process_all_event();
+    /* 删除业务vap之前处理frw中事件，frw任务正在处理时等待其完成 */
+    frw_event_drain_all_event();
 
     /* 删除业务vap */
     for (; vap_id < WLAN_SERVICE_VAP_NUM_PER_DEVICE; vap_id++) {
@@ -292,6 +295,11 @@ hi_u32 hi_wifi_host_init(struct BusDev *bus)
         goto wlan_pm_open_fail;
     }
 
+    if (plat_exception_reset_init() != EXCEPTION_SUCCESS) {
+        oam_error_log0(0, OAM_SF_ANY, "plat_exception_reset_init error\n");
+        goto wlan_pm_open_fail;
+    }
+
     ret = hmac_main_init();
     if (ret != HI_SUCCESS) {
         oam_error_log1(0, 0, "hi_wifi_host_init: hmac_main_init return error code: %d", ret);
@@ -319,6 +327,7 @@ wal_main_init_fail:
     wal_main_exit();
 hmac_main_init_fail:
     hmac_main_exit();
+    plat_exception_reset_exit();
 wlan_pm_open_fail:
     wlan_pm_exit();
     plat_firmware_clear();
@@ -338,6 +347,7 @@ hcc_hmac_init_fail:
 hi_void hi_wifi_host_exit(hi_void)
 {
     g_wifi_exit_stop_flag = HI_TRUE;
+    plat_exception_reset_exit();
     wal_main_exit();
     hmac_main_exit();
     plat_firmware_clear();
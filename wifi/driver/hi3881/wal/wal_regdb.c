@@ -1546,6 +1546,7 @@ static const struct ieee80211_regdomain g_regdom_zw = {
   管制域信息数据库
 **************************************************************************** */
 /* country alpha2 code can search from http://en.wikipedia.org/wiki/ISO_3166-1_alpha-2 */
+/* 按国家码升序排列，wal_regdb_find_db二分查找依赖此顺序，新增国家码时须插入到对应位置 */
 const struct ieee80211_regdomain * const g_reg_regdb[] = {
     &g_regdom_ae,
     &g_regdom_af,
@@ -1744,7 +1745,11 @@ const oal_ieee80211_regdomain_stru *wal_get_cfg_regdb(hi_void)
 **************************************************************************** */
 const oal_ieee80211_regdomain_stru *wal_regdb_find_db(const hi_char *pc_str)
 {
-    hi_u32 l_db_idx;
+    hi_u32 low = 0;
+    hi_u32 high = array_size(g_reg_regdb);
+    hi_u32 mid;
+    hi_u16 key;
+    hi_u16 mid_key;
 
     if (oal_unlikely(pc_str == HI_NULL)) {
         return HI_NULL;
@@ -1754,9 +1759,17 @@ const oal_ieee80211_regdomain_stru *wal_regdb_find_db(const hi_char *pc_str)
         return &g_default_regdom;
     }
 
-    for (l_db_idx = 0; l_db_idx < array_size(g_reg_regdb); l_db_idx++) {
-        if ((pc_str[0] == g_reg_regdb[l_db_idx]->alpha2[0]) && (pc_str[1] == g_reg_regdb[l_db_idx]->alpha2[1])) {
-            return g_reg_regdb[l_db_idx];
+    /* g_reg_regdb按国家码升序排列，二分查找 */
+    key = wal_regdb_alpha2_key(pc_str);
+    while (low < high) {
+        mid = low + ((high - low) >> 1);
+        mid_key = wal_regdb_alpha2_key(g_reg_regdb[mid]->alpha2);
+        if (mid_key == key) {
+            return g_reg_regdb[mid];
+        } else if (mid_key < key) {
+            low = mid + 1;
+        } else {
+            high = mid;
         }
     }
     return HI_NULL;
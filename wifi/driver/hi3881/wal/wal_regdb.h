@@ -36,6 +36,9 @@ extern "C" {
 #ifndef array_size
 #define array_size(array) (sizeof(array) / sizeof((array)[0]))
 #endif
+/* 2字符国家码转为可比较的16位键值，管制域表按此键值升序排列 */
+#define wal_regdb_alpha2_key(_pc_alpha2) \
+    ((hi_u16)(((hi_u16)(hi_u8)(_pc_alpha2)[0] << 8) | (hi_u8)(_pc_alpha2)[1]))
 
 /* ****************************************************************************
   3 全局变量声明